@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashTable.h>
+#include <AK/IntrusiveList.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Traits.h>
+
+namespace AK {
+
+// A map that only keeps the most recently used entries around. Every entry has a cost (e.g. its size in bytes, or just
+// 1 to limit the number of entries), and the least recently used entries are evicted to keep the total cost within the
+// capacity of the cache.
+template<typename K, typename V, typename KeyTraits = Traits<K>>
+class LRUCache {
+    AK_MAKE_NONCOPYABLE(LRUCache);
+    AK_MAKE_NONMOVABLE(LRUCache);
+
+public:
+    explicit LRUCache(size_t capacity)
+        : m_capacity(capacity)
+    {
+    }
+
+    ~LRUCache() = default;
+
+    // Looking up an entry makes it the most recently used one. The returned pointer is only valid until the cache is
+    // modified.
+    V* get(K const& key)
+    {
+        return get(KeyTraits::hash(key), [&](K const& other) { return KeyTraits::equals(other, key); });
+    }
+
+    template<Concepts::HashCompatible<K> LookupKey>
+    requires(IsSame<KeyTraits, Traits<K>>) V* get(LookupKey const& key)
+    {
+        return get(Traits<LookupKey>::hash(key), [&](K const& other) { return Traits<K>::equals(other, key); });
+    }
+
+    // For looking up entries without having to build a key first. The predicate is called with the keys of the entries
+    // that have the given hash.
+    template<typename TUnaryPredicate>
+    V* get(unsigned hash, TUnaryPredicate predicate)
+    {
+        auto it = m_entries.find(hash, [&](auto const& entry) { return predicate(entry->key); });
+        if (it == m_entries.end()) {
+            ++m_miss_count;
+            return nullptr;
+        }
+        ++m_hit_count;
+
+        auto& entry = **it;
+        entry.list_node.remove();
+        m_entries_by_use.append(entry);
+        return &entry.value;
+    }
+
+    // Entries that cost more than the whole cache can hold are not added at all, as they would only push everything
+    // else out.
+    void set(K key, V value, size_t cost = 1)
+    {
+        if (cost > m_capacity)
+            return;
+
+        auto hash = KeyTraits::hash(key);
+        if (auto it = m_entries.find(hash, [&](auto const& entry) { return KeyTraits::equals(entry->key, key); }); it != m_entries.end())
+            remove(it);
+
+        while (!m_entries_by_use.is_empty() && m_cost + cost > m_capacity) {
+            auto& least_recently_used = *m_entries_by_use.first();
+            auto it = m_entries.find(least_recently_used.hash, [&](auto const& entry) { return entry.ptr() == &least_recently_used; });
+            remove(it);
+        }
+
+        auto entry = make<Entry>(move(key), move(value), cost, hash);
+        m_entries_by_use.append(*entry);
+        m_entries.set(move(entry));
+        m_cost += cost;
+    }
+
+    void clear()
+    {
+        m_entries_by_use.clear();
+        m_entries.clear();
+        m_cost = 0;
+    }
+
+    bool is_empty() const { return m_entries.is_empty(); }
+    size_t size() const { return m_entries.size(); }
+    size_t cost() const { return m_cost; }
+    size_t capacity() const { return m_capacity; }
+
+    size_t hit_count() const { return m_hit_count; }
+    size_t miss_count() const { return m_miss_count; }
+
+private:
+    struct Entry {
+        Entry(K key, V value, size_t cost, unsigned hash)
+            : key(move(key))
+            , value(move(value))
+            , cost(cost)
+            , hash(hash)
+        {
+        }
+
+        K key;
+        V value;
+        size_t cost { 0 };
+        unsigned hash { 0 };
+        IntrusiveListNode<Entry> list_node;
+    };
+
+    struct EntryTraits : DefaultTraits<NonnullOwnPtr<Entry>> {
+        static unsigned hash(NonnullOwnPtr<Entry> const& entry) { return entry->hash; }
+        static bool equals(NonnullOwnPtr<Entry> const& a, NonnullOwnPtr<Entry> const& b) { return KeyTraits::equals(a->key, b->key); }
+    };
+
+    void remove(typename HashTable<NonnullOwnPtr<Entry>, EntryTraits>::Iterator& it)
+    {
+        m_cost -= (*it)->cost;
+        (*it)->list_node.remove();
+        m_entries.remove(it);
+    }
+
+    HashTable<NonnullOwnPtr<Entry>, EntryTraits> m_entries;
+
+    // Ordered from least to most recently used.
+    IntrusiveList<&Entry::list_node> m_entries_by_use;
+
+    size_t m_cost { 0 };
+    size_t m_capacity { 0 };
+    size_t m_hit_count { 0 };
+    size_t m_miss_count { 0 };
+};
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::LRUCache;
+#endif
@@ -5,6 +5,7 @@
  */
 
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/Random.h>
 #include <AK/Vector.h>
 #include <LibGC/BlockAllocator.h>
@@ -24,28 +25,41 @@ namespace GC {
 
 BlockAllocator::~BlockAllocator()
 {
-    for (auto* block : m_blocks) {
-        ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
-        if (munmap(block, HeapBlock::block_size) < 0) {
+    for (auto* region : m_regions) {
+        ASAN_UNPOISON_MEMORY_REGION(region, blocks_per_region * HeapBlock::block_size);
+        if (munmap(region, blocks_per_region * HeapBlock::block_size) < 0) {
             perror("munmap");
             VERIFY_NOT_REACHED();
         }
     }
 }
 
+void BlockAllocator::allocate_region()
+{
+    auto region_size = blocks_per_region * HeapBlock::block_size;
+    auto* region = static_cast<u8*>(mmap(nullptr, region_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0));
+    VERIFY(region != MAP_FAILED);
+    m_regions.append(region);
+
+    // NOTE: The kernel only commits the pages of a fresh mapping once they are touched, so all of its blocks start
+    //       out as if they had been decommitted.
+    ASAN_POISON_MEMORY_REGION(region, region_size);
+    m_blocks.ensure_capacity(m_blocks.size() + blocks_per_region);
+    for (size_t i = 0; i < blocks_per_region; ++i)
+        m_blocks.unchecked_append(region + i * HeapBlock::block_size);
+}
+
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
-    if (!m_blocks.is_empty()) {
-        // To reduce predictability, take a random block from the cache.
-        size_t random_index = get_random_uniform(m_blocks.size());
-        auto* block = m_blocks.unstable_take(random_index);
-        ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
-        LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
-        return block;
-    }
+    // Prefer blocks that are still committed, as reusing them costs nothing.
+    auto& free_blocks = !m_blocks_to_decommit.is_empty() ? m_blocks_to_decommit : m_blocks;
+    if (free_blocks.is_empty())
+        allocate_region();
 
-    auto* block = (HeapBlock*)mmap(nullptr, HeapBlock::block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
-    VERIFY(block != MAP_FAILED);
+    // To reduce predictability, take a random block from the cache.
+    size_t random_index = get_random_uniform(free_blocks.size());
+    auto* block = free_blocks.unstable_take(random_index);
+    ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
     LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
     return block;
 }
@@ -54,31 +68,64 @@ void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
 
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
+    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
+    m_blocks_to_decommit.append(block);
+
+    if (m_blocks_to_decommit.size() >= blocks_per_region)
+        decommit_free_blocks();
+}
+
+static void decommit_range(void* start, size_t size)
+{
 #if defined(USE_FALLBACK_BLOCK_DEALLOCATION)
-    // If we can't use any of the nicer techniques, unmap and remap the block to return the physical pages while keeping the VM.
-    if (munmap(block, HeapBlock::block_size) < 0) {
+    // If we can't use any of the nicer techniques, unmap and remap the range to return the physical pages while keeping the VM.
+    if (munmap(start, size) < 0) {
         perror("munmap");
         VERIFY_NOT_REACHED();
     }
-    if (mmap(block, HeapBlock::block_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0) != block) {
+    if (mmap(start, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0) != start) {
         perror("mmap");
         VERIFY_NOT_REACHED();
     }
 #elif defined(MADV_FREE)
-    if (madvise(block, HeapBlock::block_size, MADV_FREE) < 0) {
+    if (madvise(start, size, MADV_FREE) < 0) {
         perror("madvise(MADV_FREE)");
         VERIFY_NOT_REACHED();
     }
 #elif defined(MADV_DONTNEED)
-    if (madvise(block, HeapBlock::block_size, MADV_DONTNEED) < 0) {
+    if (madvise(start, size, MADV_DONTNEED) < 0) {
         perror("madvise(MADV_DONTNEED)");
         VERIFY_NOT_REACHED();
     }
 #endif
+}
 
-    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
-    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
-    m_blocks.append(block);
+void BlockAllocator::decommit_blocks(Span<void*> blocks)
+{
+    if (blocks.is_empty())
+        return;
+
+    // Runs of neighboring blocks are decommitted together.
+    quick_sort(blocks);
+
+    auto* run_start = static_cast<u8*>(blocks.first());
+    size_t run_size = 0;
+    for (auto* block : blocks) {
+        if (block != run_start + run_size) {
+            decommit_range(run_start, run_size);
+            run_start = static_cast<u8*>(block);
+            run_size = 0;
+        }
+        run_size += HeapBlock::block_size;
+    }
+    decommit_range(run_start, run_size);
+}
+
+void BlockAllocator::decommit_free_blocks()
+{
+    decommit_blocks(m_blocks_to_decommit);
+    m_blocks.extend(move(m_blocks_to_decommit));
 }
 
 }
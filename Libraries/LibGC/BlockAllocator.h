@@ -13,13 +13,34 @@ namespace GC {
 
 class BlockAllocator {
 public:
+    // Blocks are mapped in contiguous regions of this many blocks, so that runs of neighboring free blocks can be
+    // given back to the kernel with a single call.
+    static constexpr size_t blocks_per_region = 64;
+
     BlockAllocator() = default;
     ~BlockAllocator();
 
     void* allocate_block(char const* name);
+
+    // NOTE: The memory of deallocated blocks isn't given back to the kernel right away, but in batches, either when
+    //       enough of them have piled up, or when decommit_free_blocks() is called.
     void deallocate_block(void*);
+    void decommit_free_blocks();
+
+    // Gives the memory of the given blocks back to the kernel, while keeping their addresses reserved.
+    static void decommit_blocks(Span<void*>);
+
+    bool has_blocks_to_decommit() const { return !m_blocks_to_decommit.is_empty(); }
 
 private:
+    void allocate_region();
+
+    Vector<void*> m_regions;
+
+    // Free blocks whose memory is still committed.
+    Vector<void*> m_blocks_to_decommit;
+
+    // Free blocks whose memory has been given back to the kernel.
     Vector<void*> m_blocks;
 };
 
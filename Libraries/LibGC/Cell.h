@@ -28,13 +28,21 @@ namespace GC {
 #    define IGNORE_GC
 #endif
 
-#define GC_CELL(class_, base_class)                \
-public:                                            \
-    using Base = base_class;                       \
-    virtual StringView class_name() const override \
-    {                                              \
-        return #class_##sv;                        \
-    }                                              \
+#define GC_CELL(class_, base_class)                                                          \
+public:                                                                                      \
+    using Base = base_class;                                                                 \
+    virtual StringView class_name() const override                                           \
+    {                                                                                        \
+        return #class_##sv;                                                                  \
+    }                                                                                        \
+    virtual void revoke_weak_pointers_to_dead_cell() override                                \
+    {                                                                                        \
+        Base::revoke_weak_pointers_to_dead_cell();                                           \
+        [](auto& self) {                                                                     \
+            if constexpr (IsBaseOf<AK::Weakable<class_>, RemoveReference<decltype(self)>>)   \
+                self.AK::Weakable<class_>::revoke_weak_ptrs();                               \
+        }(*this);                                                                            \
+    }                                                                                        \
     friend class GC::Heap;
 
 class Cell {
@@ -47,9 +55,12 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
-    enum class State : bool {
+    enum class State : u8 {
         Live,
+        // The cell was found to be unreachable, but its block hasn't been swept yet.
         Dead,
+        // The cell's memory is on its block's freelist.
+        Free,
     };
 
     State state() const { return m_state; }
@@ -171,6 +182,11 @@ public:
     // This will be called on unmarked objects by the garbage collector in a separate pass before destruction.
     virtual void finalize() { }
 
+    // This is called as soon as the garbage collector finds a cell unreachable. Its destructor doesn't run until its
+    // block is swept, so any weak pointers to it are revoked here instead. GC_CELL implements this for every cell class
+    // that is Weakable, so it shouldn't be overridden by hand.
+    virtual void revoke_weak_pointers_to_dead_cell() { }
+
     // This allows cells to survive GC by choice, even if nothing points to them.
     // It's used to implement special rules in the web platform.
     // NOTE: Cells must call set_overrides_must_survive_garbage_collection() for this to be honored.
@@ -5,10 +5,12 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/Debug.h>
 #include <LibGC/BlockAllocator.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Heap.h>
 #include <LibGC/HeapBlock.h>
+#include <LibGC/Nursery.h>
 
 namespace GC {
 
@@ -23,13 +25,16 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     if (!m_list_node.is_in_list())
         heap.register_cell_allocator({}, *this);
 
+    if (heap.is_generational_collection_enabled()) {
+        if (auto* cell = allocate_young_cell(heap, *heap.nursery()))
+            return cell;
+    }
+
+    while (m_usable_blocks.is_empty() && !m_blocks_to_sweep.is_empty())
+        sweep_block(*m_blocks_to_sweep.first());
+
     if (m_usable_blocks.is_empty()) {
         auto block = HeapBlock::create_with_cell_size(heap, *this, m_cell_size, m_class_name);
-        auto block_ptr = reinterpret_cast<FlatPtr>(block.ptr());
-        if (m_min_block_address > block_ptr)
-            m_min_block_address = block_ptr;
-        if (m_max_block_address < block_ptr)
-            m_max_block_address = block_ptr;
         m_usable_blocks.append(*block.leak_ptr());
     }
 
@@ -41,18 +46,63 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
     return cell;
 }
 
-void CellAllocator::block_did_become_empty(Badge<Heap>, HeapBlock& block)
+Cell* CellAllocator::allocate_young_cell(Heap& heap, Nursery& nursery)
+{
+    if (m_nursery_blocks.is_empty() || m_nursery_blocks.last()->is_full()) {
+        auto* memory = nursery.allocate_block();
+        if (!memory)
+            return nullptr;
+        auto block = HeapBlock::create_in_nursery_block(memory, heap, *this, m_cell_size);
+        m_nursery_blocks.append(*block.leak_ptr());
+    }
+
+    auto* cell = m_nursery_blocks.last()->allocate();
+    VERIFY(cell);
+    return cell;
+}
+
+void CellAllocator::promote_nursery_blocks(Badge<Heap>)
+{
+    while (!m_nursery_blocks.is_empty()) {
+        auto& block = *m_nursery_blocks.first();
+        if (block.is_full())
+            m_full_blocks.append(block);
+        else
+            m_usable_blocks.append(block);
+    }
+}
+
+void CellAllocator::block_needs_sweeping(Badge<Heap>, HeapBlock& block)
 {
     block.m_list_node.remove();
-    // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
-    block.~HeapBlock();
-    m_block_allocator.deallocate_block(&block);
+    m_blocks_to_sweep.append(block);
+}
+
+void CellAllocator::sweep_next_block(Badge<Heap>)
+{
+    sweep_block(*m_blocks_to_sweep.first());
 }
 
-void CellAllocator::block_did_become_usable(Badge<Heap>, HeapBlock& block)
+void CellAllocator::sweep_block(HeapBlock& block)
 {
-    VERIFY(!block.is_full());
-    m_usable_blocks.append(block);
+    block.m_list_node.remove();
+
+    if (!block.sweep()) {
+        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", &block, block.cell_size());
+        // NOTE: HeapBlocks are managed by the BlockAllocator, so we don't want to `delete` the block here.
+        auto* nursery = block.heap().nursery();
+        block.~HeapBlock();
+        if (nursery && nursery->contains(&block))
+            nursery->deallocate_block(&block);
+        else
+            m_block_allocator.deallocate_block(&block);
+        return;
+    }
+
+    if (block.is_full())
+        m_full_blocks.append(block);
+    else
+        m_usable_blocks.append(block);
 }
 
 }
@@ -33,6 +33,10 @@ public:
     template<typename Callback>
     IterationDecision for_each_block(Callback callback)
     {
+        for (auto& block : m_nursery_blocks) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         for (auto& block : m_full_blocks) {
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
@@ -41,30 +45,41 @@ public:
             if (callback(block) == IterationDecision::Break)
                 return IterationDecision::Break;
         }
+        for (auto& block : m_blocks_to_sweep) {
+            if (callback(block) == IterationDecision::Break)
+                return IterationDecision::Break;
+        }
         return IterationDecision::Continue;
     }
 
-    void block_did_become_empty(Badge<Heap>, HeapBlock&);
-    void block_did_become_usable(Badge<Heap>, HeapBlock&);
+    // Blocks with cells that died in the last collection are swept lazily, when we run out of usable blocks to
+    // allocate from, or when the heap has time to spare.
+    void block_needs_sweeping(Badge<Heap>, HeapBlock&);
+    bool has_blocks_to_sweep() const { return !m_blocks_to_sweep.is_empty(); }
+    void sweep_next_block(Badge<Heap>);
+
+    // Once a collection is done with the young cells, the blocks they were allocated in are treated like any other.
+    void promote_nursery_blocks(Badge<Heap>);
 
     IntrusiveListNode<CellAllocator> m_list_node;
     using List = IntrusiveList<&CellAllocator::m_list_node>;
 
     BlockAllocator& block_allocator() { return m_block_allocator; }
-    FlatPtr min_block_address() const { return m_min_block_address; }
-    FlatPtr max_block_address() const { return m_max_block_address; }
 
 private:
+    Cell* allocate_young_cell(Heap&, Nursery&);
+    void sweep_block(HeapBlock&);
+
     char const* const m_class_name { nullptr };
     size_t const m_cell_size;
 
     BlockAllocator m_block_allocator;
 
     using BlockList = IntrusiveList<&HeapBlock::m_list_node>;
+    BlockList m_nursery_blocks;
     BlockList m_full_blocks;
     BlockList m_usable_blocks;
-    FlatPtr m_min_block_address { explode_byte(0xff) };
-    FlatPtr m_max_block_address { 0 };
+    BlockList m_blocks_to_sweep;
 };
 
 template<typename T>
@@ -18,7 +18,9 @@ class RootImpl;
 class Heap;
 class HeapBlock;
 class NanBoxedValue;
+class Nursery;
 class WeakContainer;
+class WriteBarrier;
 
 template<typename T>
 class Function;
@@ -6,12 +6,14 @@
  */
 
 #include <AK/Badge.h>
+#include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/StackInfo.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/ElapsedTimer.h>
@@ -20,6 +22,7 @@
 #include <LibGC/HeapBlock.h>
 #include <LibGC/NanBoxedValue.h>
 #include <LibGC/Root.h>
+#include <LibGC/WriteBarrier.h>
 #include <setjmp.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
@@ -55,70 +58,103 @@ void Heap::will_allocate(size_t size)
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
         collect_garbage();
+    } else if (m_incremental_marking_enabled && !m_incremental_marking_in_progress && !m_gc_deferrals && !m_collecting_garbage
+        && m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold / 2) {
+        // Start marking while there's still room left, so that the embedder has a chance to finish most of it in
+        // slices before we would have to collect anyway.
+        start_incremental_marking();
+    } else if (m_generational_collection_enabled && !m_incremental_marking_in_progress && !m_gc_deferrals && !m_collecting_garbage
+        && m_nursery->should_collect_young_generation()) {
+        collect_garbage(CollectionType::CollectYoungGeneration);
     }
 
     m_allocated_bytes_since_last_gc += size;
 }
 
-static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+// Conservatively, any value that looks like it could be a pointer to a cell is one.
+static ALWAYS_INLINE FlatPtr possible_pointer_from_value(FlatPtr data)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(NanBoxedValue)) {
         // Because NanBoxedValue stores pointers in non-canonical form we have to check if the top bytes
         // match any pointer-backed tag, in that case we have to extract the pointer to its
         // canonical form and add that as a possible pointer.
-        FlatPtr possible_pointer;
         if ((data & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
-            possible_pointer = NanBoxedValue::extract_pointer_bits(data);
-        else
-            possible_pointer = data;
-        if (possible_pointer < min_block_address || possible_pointer > max_block_address)
-            return;
-        possible_pointers.set(possible_pointer, move(origin));
+            return NanBoxedValue::extract_pointer_bits(data);
+        return data;
     } else {
         static_assert((sizeof(NanBoxedValue) % sizeof(FlatPtr*)) == 0);
-        if (data < min_block_address || data > max_block_address)
-            return;
-        // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately we just
-        // add both the upper and lower bytes as possible pointers.
-        possible_pointers.set(data, move(origin));
+        // In the 32-bit case we will look at the top and bottom part of NanBoxedValue separately, so each of them is
+        // a possible pointer on its own.
+        return data;
     }
 }
 
-void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
-{
-    min_address = explode_byte(0xff);
-    max_address = 0;
-    for (auto& allocator : m_all_cell_allocators) {
-        min_address = min(min_address, allocator.min_block_address());
-        max_address = max(max_address, allocator.max_block_address() + HeapBlockBase::block_size);
+// A sorted list of the addresses of all blocks in the heap. Possible pointers are looked up in it with a binary search,
+// which is a lot cheaper than hashing each of them, and doesn't need the candidates to be collected first.
+class HeapBlockIndex {
+public:
+    explicit HeapBlockIndex(Heap& heap)
+    {
+        update(heap);
     }
-}
 
-template<typename Callback>
-static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& all_live_heap_blocks, HashMap<FlatPtr, HeapRoot>& possible_pointers, Callback callback)
-{
-    for (auto possible_pointer : possible_pointers.keys()) {
-        if (!possible_pointer)
-            continue;
-        auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
-        if (!all_live_heap_blocks.contains(possible_heap_block))
-            continue;
-        if (auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer)) {
-            callback(cell, possible_pointer);
+    void update(Heap& heap)
+    {
+        m_block_addresses.clear_with_capacity();
+        heap.for_each_block([&](auto& block) {
+            m_block_addresses.append(bit_cast<FlatPtr>(&block));
+            return IterationDecision::Continue;
+        });
+        quick_sort(m_block_addresses);
+
+        if (m_block_addresses.is_empty()) {
+            m_min_address = 0;
+            m_max_address = 0;
+        } else {
+            m_min_address = m_block_addresses.first();
+            m_max_address = m_block_addresses.last() + HeapBlock::block_size;
+        }
+    }
+
+    bool contains(HeapBlock const* block) const
+    {
+        return binary_search(m_block_addresses, bit_cast<FlatPtr>(block)) != nullptr;
+    }
+
+    ALWAYS_INLINE Cell* cell_from_possible_value(FlatPtr data) const
+    {
+        auto pointer = possible_pointer_from_value(data);
+        // NOTE: Most values on the stack aren't pointers into the heap at all, so we check the range of addresses the
+        //       blocks span before searching for one.
+        if (pointer < m_min_address || pointer >= m_max_address)
+            return nullptr;
+        auto* block = HeapBlock::from_cell(bit_cast<Cell const*>(pointer));
+        if (!contains(block))
+            return nullptr;
+        return block->cell_from_possible_pointer(pointer);
+    }
+
+    template<typename Callback>
+    void for_each_cell_among_possible_values(ReadonlyBytes bytes, Callback callback) const
+    {
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i) {
+            if (auto* cell = cell_from_possible_value(raw_pointer_sized_values[i]))
+                callback(*cell);
         }
     }
-}
+
+private:
+    Vector<FlatPtr> m_block_addresses;
+    FlatPtr m_min_address { 0 };
+    FlatPtr m_max_address { 0 };
+};
 
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
     explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
-        : m_heap(heap)
+        : m_block_index(heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
         m_work_queue.ensure_capacity(roots.size());
 
         for (auto& [root, root_origin] : roots) {
@@ -143,19 +179,13 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
-        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
-
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        m_block_index.for_each_cell_among_possible_values(bytes, [&](Cell& cell) {
             if (m_node_being_visited)
-                m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(cell));
+                m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(&cell));
 
             if (m_graph.get(reinterpret_cast<FlatPtr>(&cell)).has_value())
                 return;
-            m_work_queue.append(*cell);
+            m_work_queue.append(cell);
         });
     }
 
@@ -222,10 +252,7 @@ private:
     Vector<Ref<Cell>> m_work_queue;
     HashMap<FlatPtr, GraphNode> m_graph;
 
-    Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    HeapBlockIndex m_block_index;
 };
 
 AK::JsonObject Heap::dump_graph()
@@ -244,21 +271,50 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     {
         TemporaryChange change(m_collecting_garbage, true);
 
-        Core::ElapsedTimer collection_measurement_timer;
-        if (print_report)
-            collection_measurement_timer.start();
+        auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+        auto* pause_times = &m_full_collection_pause_times;
+
+        // NOTE: Cells allocated while marking incrementally are already part of the collection in progress.
+        if (collection_type == CollectionType::CollectYoungGeneration && (!m_generational_collection_enabled || m_incremental_marking_in_progress))
+            collection_type = CollectionType::CollectGarbage;
 
-        if (collection_type == CollectionType::CollectGarbage) {
+        if (collection_type == CollectionType::CollectYoungGeneration) {
+            // NOTE: Unlike a full collection, collecting the young generation is never needed to make progress, so we
+            //       don't bother doing it once the deferral ends.
+            if (m_gc_deferrals)
+                return;
+            collect_young_generation(print_report, collection_measurement_timer);
+            pause_times = &m_young_generation_pause_times;
+        } else if (collection_type == CollectionType::CollectGarbage) {
             if (m_gc_deferrals) {
                 m_should_gc_when_deferral_ends = true;
                 return;
             }
-            HashMap<Cell*, HeapRoot> roots;
-            gather_roots(roots);
-            mark_live_cells(roots);
+            if (m_incremental_marking_in_progress) {
+                finish_incremental_marking();
+                pause_times = &m_incremental_finish_pause_times;
+            } else {
+                HashMap<Cell*, HeapRoot> roots;
+                gather_roots(roots);
+                mark_live_cells(roots);
+            }
+        } else if (m_incremental_marking_in_progress) {
+            cancel_incremental_marking();
+        }
+
+        if (collection_type != CollectionType::CollectYoungGeneration) {
+            finalize_unmarked_cells();
+            sweep_dead_cells(print_report, collection_measurement_timer);
+            promote_nursery_blocks();
         }
-        finalize_unmarked_cells();
-        sweep_dead_cells(print_report, collection_measurement_timer);
+
+        // NOTE: Everything has to be destroyed before the heap goes away.
+        if (collection_type == CollectionType::CollectEverything)
+            sweep_all_blocks();
+
+        pause_times->record(collection_measurement_timer.elapsed_time());
+        if (print_report)
+            dump_pause_time_histograms();
     }
 
     auto tasks = move(m_post_gc_tasks);
@@ -292,8 +348,22 @@ void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
     }
 }
 
+static ALWAYS_INLINE void add_possible_root(HashMap<Cell*, HeapRoot>& roots, HeapBlockIndex const& block_index, FlatPtr data, HeapRoot::Type type)
+{
+    auto* cell = block_index.cell_from_possible_value(data);
+    if (!cell)
+        return;
+
+    if (cell->state() == Cell::State::Live) {
+        dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
+        roots.set(cell, HeapRoot { .type = type });
+    } else {
+        dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
+    }
+}
+
 #ifdef HAS_ADDRESS_SANITIZER
-NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr addr, FlatPtr min_block_address, FlatPtr max_block_address)
+NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<Cell*, HeapRoot>& roots, HeapBlockIndex const& block_index, FlatPtr addr)
 {
     void* begin = nullptr;
     void* end = nullptr;
@@ -304,16 +374,21 @@ NO_SANITIZE_ADDRESS void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, Hea
             void const* real_address = *real_stack_addr;
             if (real_address == nullptr)
                 continue;
-            add_possible_value(possible_pointers, reinterpret_cast<FlatPtr>(real_address), HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
+            add_possible_root(roots, block_index, reinterpret_cast<FlatPtr>(real_address), HeapRoot::Type::StackPointer);
         }
     }
 }
 #else
-void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr, FlatPtr)
+void Heap::gather_asan_fake_stack_roots(HashMap<Cell*, HeapRoot>&, HeapBlockIndex const&, FlatPtr)
 {
 }
 #endif
 
+void Heap::set_gather_precisely_rooted_stack_ranges(AK::Function<void(Vector<StackRange>&)> gather_precisely_rooted_stack_ranges)
+{
+    m_gather_precisely_rooted_stack_ranges = move(gather_precisely_rooted_stack_ranges);
+}
+
 NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots)
 {
     FlatPtr dummy;
@@ -323,57 +398,68 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     jmp_buf buf;
     setjmp(buf);
 
-    HashMap<FlatPtr, HeapRoot> possible_pointers;
+    HeapBlockIndex block_index(*this);
 
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
-
-    FlatPtr min_block_address, max_block_address;
-    find_min_and_max_block_addresses(min_block_address, max_block_address);
-
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
-        add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
+        add_possible_root(roots, block_index, raw_jmp_buf[i], HeapRoot::Type::RegisterPointer);
+
+    auto scan_stack = [&](FlatPtr start, FlatPtr end) {
+        for (FlatPtr stack_address = start; stack_address < end; stack_address += sizeof(FlatPtr)) {
+            auto data = *reinterpret_cast<FlatPtr*>(stack_address);
+            add_possible_root(roots, block_index, data, HeapRoot::Type::StackPointer);
+            gather_asan_fake_stack_roots(roots, block_index, data);
+        }
+    };
 
     auto stack_reference = bit_cast<FlatPtr>(&dummy);
+    auto stack_top = m_stack_info.top();
 
-    for (FlatPtr stack_address = stack_reference; stack_address < m_stack_info.top(); stack_address += sizeof(FlatPtr)) {
-        auto data = *reinterpret_cast<FlatPtr*>(stack_address);
-        add_possible_value(possible_pointers, data, HeapRoot { .type = HeapRoot::Type::StackPointer }, min_block_address, max_block_address);
-        gather_asan_fake_stack_roots(possible_pointers, data, min_block_address, max_block_address);
+    Vector<StackRange> precisely_rooted_ranges;
+    if (m_gather_precisely_rooted_stack_ranges) {
+        m_gather_precisely_rooted_stack_ranges(precisely_rooted_ranges);
+        quick_sort(precisely_rooted_ranges, [](auto const& a, auto const& b) { return a.start < b.start; });
     }
 
-    for (auto& vector : m_conservative_vectors) {
-        for (auto possible_value : vector.possible_values()) {
-            add_possible_value(possible_pointers, possible_value, HeapRoot { .type = HeapRoot::Type::ConservativeVector }, min_block_address, max_block_address);
-        }
+    auto scan_start = stack_reference;
+    for (auto const& range : precisely_rooted_ranges) {
+        // NOTE: The embedder may hand us ranges that aren't on the part of the stack we scan, or not on it at all.
+        if (range.end <= scan_start || range.start >= stack_top)
+            continue;
+        scan_stack(scan_start, range.start);
+        scan_start = align_up_to(range.end, sizeof(FlatPtr));
     }
+    scan_stack(scan_start, stack_top);
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
-        if (cell->state() == Cell::State::Live) {
-            dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
-            roots.set(cell, *possible_pointers.get(possible_pointer));
-        } else {
-            dbgln_if(HEAP_DEBUG, "  #-> {}", (void const*)cell);
-        }
-    });
+    for (auto& vector : m_conservative_vectors) {
+        for (auto possible_value : vector.possible_values())
+            add_possible_root(roots, block_index, possible_value, HeapRoot::Type::ConservativeVector);
+    }
 }
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    enum class Generation {
+        All,
+        Young,
+    };
+
+    explicit MarkingVisitor(Heap& heap, Generation generation = Generation::All)
         : m_heap(heap)
+        , m_young_generation_nursery(generation == Generation::Young ? heap.nursery() : nullptr)
+        , m_block_index(heap)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
+    }
 
+    // NOTE: Blocks may be allocated while marking incrementally, so this has to be called again before each slice.
+    void update_heap_blocks() { m_block_index.update(m_heap); }
+
+    bool contains_block(HeapBlock const* block) const { return m_block_index.contains(block); }
+
+    void did_mark_cell(Badge<Heap>, Cell& cell) { m_work_queue.append(cell); }
+
+    void mark_roots(HashMap<Cell*, HeapRoot> const& roots)
+    {
         for (auto* root : roots.keys()) {
             visit(root);
         }
@@ -381,6 +467,10 @@ public:
 
     virtual void visit_impl(Cell& cell) override
     {
+        // NOTE: When collecting the young generation, old cells are all considered live, and their edges are visited
+        //       separately.
+        if (m_young_generation_nursery && !m_young_generation_nursery->is_young(&cell))
+            return;
         if (cell.is_marked())
             return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
@@ -391,19 +481,15 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
-        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
-
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
+        m_block_index.for_each_cell_among_possible_values(bytes, [&](Cell& cell) {
+            if (m_young_generation_nursery && !m_young_generation_nursery->is_young(&cell))
+                return;
+            if (cell.is_marked())
                 return;
-            if (cell->state() != Cell::State::Live)
+            if (cell.state() != Cell::State::Live)
                 return;
-            cell->set_marked(true);
-            m_work_queue.append(*cell);
+            cell.set_marked(true);
+            m_work_queue.append(cell);
         });
     }
 
@@ -414,22 +500,40 @@ public:
         }
     }
 
+    // Returns whether there are no cells left to mark.
+    bool mark_live_cells_until(MonotonicTime deadline)
+    {
+        // NOTE: Reading the clock after every cell would cost more than visiting most cells does.
+        static constexpr size_t cells_between_deadline_checks = 256;
+
+        while (!m_work_queue.is_empty()) {
+            for (size_t i = 0; i < cells_between_deadline_checks && !m_work_queue.is_empty(); ++i)
+                m_work_queue.take_last()->visit_edges(*this);
+            if (MonotonicTime::now() >= deadline)
+                break;
+        }
+        return m_work_queue.is_empty();
+    }
+
 private:
     Heap& m_heap;
+    Nursery const* m_young_generation_nursery { nullptr };
     Vector<Ref<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    HeapBlockIndex m_block_index;
 };
 
 void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
-
+    MarkingVisitor visitor(*this);
+    visitor.mark_roots(roots);
     visitor.mark_all_live_cells();
+    finish_marking(visitor);
+}
 
+void Heap::finish_marking(MarkingVisitor& visitor)
+{
     for (auto& inverse_root : m_uprooted_cells)
         inverse_root->set_marked(false);
 
@@ -444,6 +548,253 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     m_uprooted_cells.clear();
 }
 
+void Heap::set_generational_collection_enabled(bool enabled)
+{
+    if (enabled == m_generational_collection_enabled)
+        return;
+
+    if (enabled && !m_nursery)
+        m_nursery = make<Nursery>();
+    m_generational_collection_enabled = enabled;
+
+    // Without generational collection, every cell is old. The blocks in the nursery may still hold some of them, so
+    // its mapping is only released once they have all died.
+    if (!enabled) {
+        promote_nursery_blocks();
+        release_nursery_if_unused();
+    }
+}
+
+void Heap::release_nursery_if_unused()
+{
+    if (m_generational_collection_enabled || !m_nursery || !m_nursery->is_unused())
+        return;
+    m_nursery = nullptr;
+}
+
+void Heap::collect_young_generation(bool print_report, Core::ElapsedTimer const& measurement_timer)
+{
+    dbgln_if(HEAP_DEBUG, "collect_young_generation:");
+
+    MarkingVisitor visitor(*this, MarkingVisitor::Generation::Young);
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    visitor.mark_roots(roots);
+
+    // NOTE: Old cells may refer to young ones in ways the write barrier doesn't see, like through JS values or copies of
+    //       a GC::Ptr, so it can't tell us which of them do. Instead, every old cell is considered live, and we visit
+    //       the edges of all of them. The visitor tells young cells apart by their address, so unlike in a full
+    //       collection, the cells that old cells refer to don't have to be looked at.
+    for_each_block([&](auto& block) {
+        if (m_nursery->is_young(&block))
+            return IterationDecision::Continue;
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            cell->visit_edges(visitor);
+        });
+        return IterationDecision::Continue;
+    });
+    visitor.mark_all_live_cells();
+
+    // Uprooted old cells are left for the next full collection to deal with.
+    m_uprooted_cells.remove_all_matching([&](auto& cell) {
+        if (!m_nursery->is_young(cell.ptr()))
+            return false;
+        cell->set_marked(false);
+        return true;
+    });
+
+    m_nursery->for_each_young_block([&](HeapBlock& block) {
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (!cell->is_marked() && cell_must_survive_garbage_collection(*cell))
+                cell->visit_edges(visitor);
+        });
+    });
+
+    m_nursery->for_each_young_block([&](HeapBlock& block) {
+        block.for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            if (!cell->is_marked())
+                cell->finalize();
+        });
+    });
+
+    Vector<HeapBlock*, 32> blocks_with_dead_cells;
+    size_t collected_cells = 0;
+    size_t surviving_cells = 0;
+    size_t collected_cell_bytes = 0;
+    m_nursery->for_each_young_block([&](HeapBlock& block) {
+        bool block_has_dead_cells = false;
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (!cell->is_marked()) {
+                dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
+                cell->set_state(Cell::State::Dead);
+                cell->revoke_weak_pointers_to_dead_cell();
+                block_has_dead_cells = true;
+                ++collected_cells;
+                collected_cell_bytes += block.cell_size();
+            } else {
+                cell->set_marked(false);
+                ++surviving_cells;
+            }
+        });
+        if (block_has_dead_cells)
+            blocks_with_dead_cells.append(&block);
+    });
+
+    for (auto& weak_container : m_weak_containers)
+        weak_container.remove_dead_cells({});
+
+    promote_nursery_blocks();
+    for (auto* block : blocks_with_dead_cells)
+        block->cell_allocator().block_needs_sweeping({}, *block);
+    if (!blocks_with_dead_cells.is_empty())
+        m_lazy_sweeping_in_progress = true;
+
+    // Only what survives counts towards the next full collection.
+    m_allocated_bytes_since_last_gc -= min(m_allocated_bytes_since_last_gc, collected_cell_bytes);
+
+    if (print_report) {
+        dbgln("Young generation collection report");
+        dbgln("=============================================");
+        dbgln("      Time spent: {} ms", measurement_timer.elapsed_time().to_milliseconds());
+        dbgln(" Surviving cells: {}", surviving_cells);
+        dbgln(" Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
+        dbgln(" Blocks to sweep: {} ({} bytes)", blocks_with_dead_cells.size(), blocks_with_dead_cells.size() * HeapBlock::block_size);
+        dbgln("=============================================");
+    }
+}
+
+void Heap::promote_nursery_blocks()
+{
+    if (!m_nursery)
+        return;
+    m_nursery->promote_all_blocks();
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.promote_nursery_blocks({});
+}
+
+void Heap::set_incremental_marking_enabled(bool enabled)
+{
+    if (!enabled && m_incremental_marking_in_progress)
+        collect_garbage();
+    m_incremental_marking_enabled = enabled;
+}
+
+void Heap::start_incremental_marking()
+{
+    VERIFY(!m_incremental_marking_in_progress);
+    TemporaryChange change(m_collecting_garbage, true);
+    auto pause_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+
+    m_incremental_marking_visitor = make<MarkingVisitor>(*this);
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    m_incremental_marking_visitor->mark_roots(roots);
+
+    m_incremental_marking_in_progress = true;
+    WriteBarrier::did_start_incremental_marking({}, *this);
+
+    m_incremental_marking_pause_times.record(pause_timer.elapsed_time());
+}
+
+bool Heap::perform_incremental_marking_step(AK::Duration budget)
+{
+    if (!m_incremental_marking_in_progress)
+        return false;
+
+    bool is_done_marking;
+    {
+        TemporaryChange change(m_collecting_garbage, true);
+        auto pause_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+
+        m_incremental_marking_visitor->update_heap_blocks();
+        is_done_marking = m_incremental_marking_visitor->mark_live_cells_until(pause_timer.origin_time() + budget);
+
+        m_incremental_marking_pause_times.record(pause_timer.elapsed_time());
+    }
+
+    // NOTE: Finishing frees cells, which we can't do while someone is holding on to a DeferGC.
+    if (!is_done_marking || m_gc_deferrals)
+        return true;
+
+    collect_garbage();
+    return false;
+}
+
+void Heap::finish_incremental_marking()
+{
+    VERIFY(m_incremental_marking_in_progress);
+    dbgln_if(HEAP_DEBUG, "finish_incremental_marking:");
+
+    auto visitor = m_incremental_marking_visitor.release_nonnull();
+    m_incremental_marking_in_progress = false;
+    WriteBarrier::did_stop_incremental_marking({}, *this);
+
+    visitor->update_heap_blocks();
+
+    // The roots may have changed since we started.
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    visitor->mark_roots(roots);
+    visitor->mark_all_live_cells();
+
+    // The write barrier only sees assignments to GC::Ptr and GC::Ref. Cells may also come to refer to each other in
+    // other ways, like through JS values or by copying pointers into their containers, so we have to visit every marked
+    // cell again to find what they now refer to. As most of the graph has already been marked, this rarely discovers
+    // new cells, and is a lot cheaper than tracing the heap.
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_marked())
+                cell->visit_edges(*visitor);
+        });
+        return IterationDecision::Continue;
+    });
+    visitor->mark_all_live_cells();
+
+    finish_marking(*visitor);
+}
+
+void Heap::cancel_incremental_marking()
+{
+    VERIFY(m_incremental_marking_in_progress);
+
+    m_incremental_marking_visitor = nullptr;
+    m_incremental_marking_in_progress = false;
+    WriteBarrier::did_stop_incremental_marking({}, *this);
+
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+}
+
+void Heap::did_allocate_cell_during_incremental_marking(Cell& cell)
+{
+    // New cells are considered live for this collection, but we still have to find out what they refer to.
+    cell.set_marked(true);
+    m_incremental_marking_visitor->did_mark_cell({}, cell);
+}
+
+void Heap::did_store_during_incremental_marking(Badge<WriteBarrier>, void const* pointer)
+{
+    if (!m_incremental_marking_in_progress || m_collecting_garbage)
+        return;
+
+    auto* block = HeapBlock::from_cell(static_cast<Cell const*>(pointer));
+    if (!m_incremental_marking_visitor->contains_block(block))
+        return;
+
+    auto* cell = block->cell_from_possible_pointer(bit_cast<FlatPtr>(pointer));
+    if (!cell || cell->is_marked() || cell->state() != Cell::State::Live)
+        return;
+
+    cell->set_marked(true);
+    m_incremental_marking_visitor->did_mark_cell({}, *cell);
+}
+
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
 {
     if (!cell.overrides_must_survive_garbage_collection({}))
@@ -465,56 +816,43 @@ void Heap::finalize_unmarked_cells()
 void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
-    Vector<HeapBlock*, 32> empty_blocks;
-    Vector<HeapBlock*, 32> full_blocks_that_became_usable;
+    Vector<HeapBlock*, 32> blocks_with_dead_cells;
 
     size_t collected_cells = 0;
     size_t live_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
 
+    // NOTE: We only take note of which cells have died here, so that weak containers can forget about them. Running
+    //       their destructors and putting them on the freelist is left for when their block is swept.
     for_each_block([&](auto& block) {
-        bool block_has_live_cells = false;
-        bool block_was_full = block.is_full();
+        bool block_has_dead_cells = false;
         block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
             if (!cell->is_marked()) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
-                block.deallocate(cell);
+                cell->set_state(Cell::State::Dead);
+                cell->revoke_weak_pointers_to_dead_cell();
+                block_has_dead_cells = true;
                 ++collected_cells;
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
-                block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
             }
         });
-        if (!block_has_live_cells)
-            empty_blocks.append(&block);
-        else if (block_was_full != block.is_full())
-            full_blocks_that_became_usable.append(&block);
+        if (block_has_dead_cells)
+            blocks_with_dead_cells.append(&block);
         return IterationDecision::Continue;
     });
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
-    for (auto* block : empty_blocks) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_empty({}, *block);
-    }
-
-    for (auto* block : full_blocks_that_became_usable) {
-        dbgln_if(HEAP_DEBUG, " - HeapBlock usable again @ {}: cell_size={}", block, block->cell_size());
-        block->cell_allocator().block_did_become_usable({}, *block);
-    }
-
-    if constexpr (HEAP_DEBUG) {
-        for_each_block([&](auto& block) {
-            dbgln(" > Live HeapBlock @ {}: cell_size={}", &block, block.cell_size());
-            return IterationDecision::Continue;
-        });
-    }
+    for (auto* block : blocks_with_dead_cells)
+        block->cell_allocator().block_needs_sweeping({}, *block);
+    if (!blocks_with_dead_cells.is_empty())
+        m_lazy_sweeping_in_progress = true;
 
     m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
 
@@ -532,11 +870,86 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
-        dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
+        dbgln("Blocks to sweep: {} ({} bytes)", blocks_with_dead_cells.size(), blocks_with_dead_cells.size() * HeapBlock::block_size);
         dbgln("=============================================");
     }
 }
 
+bool Heap::perform_lazy_sweeping_step(AK::Duration budget)
+{
+    if (m_collecting_garbage)
+        return true;
+
+    auto deadline = MonotonicTime::now() + budget;
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.has_blocks_to_sweep()) {
+            if (MonotonicTime::now() >= deadline)
+                return true;
+            allocator.sweep_next_block({});
+        }
+    }
+
+    // Now that every empty block has been given back to its allocator, release their memory in as few calls as we can.
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.block_allocator().decommit_free_blocks();
+    if (m_nursery) {
+        m_nursery->decommit_free_blocks();
+        release_nursery_if_unused();
+    }
+
+    m_lazy_sweeping_in_progress = false;
+    return false;
+}
+
+void Heap::sweep_all_blocks()
+{
+    for (auto& allocator : m_all_cell_allocators) {
+        while (allocator.has_blocks_to_sweep())
+            allocator.sweep_next_block({});
+    }
+    release_nursery_if_unused();
+    m_lazy_sweeping_in_progress = false;
+}
+
+void Heap::PauseTimeHistogram::record(AK::Duration pause_time)
+{
+    auto milliseconds = pause_time.to_milliseconds();
+    size_t bucket = 0;
+    while (bucket < bucket_count - 1 && milliseconds >= (1 << bucket))
+        ++bucket;
+
+    ++buckets[bucket];
+    ++pause_count;
+    total_time += pause_time;
+    longest_pause = max(longest_pause, pause_time);
+}
+
+void Heap::PauseTimeHistogram::dump(StringView name) const
+{
+    dbgln("{}: {} pauses, {} ms in total, longest {} ms", name, pause_count, total_time.to_milliseconds(), longest_pause.to_milliseconds());
+    if (pause_count == 0)
+        return;
+    for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+        if (bucket == 0)
+            dbgln("     < 1 ms: {}", buckets[bucket]);
+        else if (bucket == bucket_count - 1)
+            dbgln("  >= {:3} ms: {}", 1 << (bucket - 1), buckets[bucket]);
+        else
+            dbgln("   < {:3} ms: {}", 1 << bucket, buckets[bucket]);
+    }
+}
+
+void Heap::dump_pause_time_histograms() const
+{
+    dbgln("Pause times");
+    dbgln("=============================================");
+    m_full_collection_pause_times.dump("Full collections"sv);
+    m_young_generation_pause_times.dump("Young generation collections"sv);
+    m_incremental_marking_pause_times.dump("Incremental marking slices"sv);
+    m_incremental_finish_pause_times.dump("Incremental collection finishes"sv);
+    dbgln("=============================================");
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
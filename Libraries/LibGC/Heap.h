@@ -6,14 +6,17 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/Function.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/Swift.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -23,6 +26,7 @@
 #include <LibGC/Forward.h>
 #include <LibGC/HeapRoot.h>
 #include <LibGC/Internals.h>
+#include <LibGC/Nursery.h>
 #include <LibGC/Root.h>
 #include <LibGC/RootHashMap.h>
 #include <LibGC/RootVector.h>
@@ -30,6 +34,9 @@
 
 namespace GC {
 
+class HeapBlockIndex;
+class MarkingVisitor;
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -45,12 +52,15 @@ public:
         defer_gc();
         new (memory) T(forward<Args>(args)...);
         undefer_gc();
+        if (m_incremental_marking_in_progress) [[unlikely]]
+            did_allocate_cell_during_incremental_marking(*static_cast<T*>(memory));
         return *static_cast<T*>(memory);
     }
 
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        CollectYoungGeneration,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
@@ -59,6 +69,35 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    // With incremental marking enabled, the heap starts marking before it runs out of room, and the embedder performs
+    // the marking in short slices between running the mutator (e.g. in the idle periods of an event loop). Once
+    // everything reachable has been marked, or the heap runs out of room anyway, the collection is finished by a
+    // final pause that only has to pick up what changed since.
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool);
+
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_in_progress; }
+
+    // Marks cells until there are none left, or the budget has been spent. Returns whether the collection is still in
+    // progress afterwards.
+    bool perform_incremental_marking_step(AK::Duration budget);
+
+    void did_store_during_incremental_marking(Badge<WriteBarrier>, void const* pointer);
+
+    // With generational collection enabled, new cells are allocated in a nursery. Most of them die young, so once the
+    // nursery fills up, we collect only the young generation, which leaves the rest of the heap alone. Cells that
+    // survive a collection are promoted to the old generation, which is only collected by full collections.
+    bool is_generational_collection_enabled() const { return m_generational_collection_enabled; }
+    void set_generational_collection_enabled(bool);
+
+    Nursery* nursery() { return m_nursery.ptr(); }
+
+    // Cells that die are only destroyed once their block is swept, which happens when an allocator needs a free cell,
+    // or here. Once every block has been swept, the memory of empty blocks is given back to the kernel. Returns
+    // whether there is any sweeping left to do afterwards.
+    bool perform_lazy_sweeping_step(AK::Duration budget);
+    bool is_lazy_sweeping_in_progress() const { return m_lazy_sweeping_in_progress; }
+
     void did_create_root(Badge<RootImpl>, RootImpl&);
     void did_destroy_root(Badge<RootImpl>, RootImpl&);
 
@@ -82,9 +121,19 @@ public:
 
     void enqueue_post_gc_task(AK::Function<void()>);
 
+    struct StackRange {
+        FlatPtr start { 0 };
+        FlatPtr end { 0 };
+    };
+
+    // The embedder may already root everything in some parts of the native stack precisely, like the frames of an
+    // interpreter. Those parts don't have to be scanned for possible pointers when gathering roots.
+    void set_gather_precisely_rooted_stack_ranges(AK::Function<void(Vector<StackRange>&)>);
+
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
+    friend class HeapBlockIndex;
     friend class DeferGC;
     friend class ForeignCell;
 
@@ -107,13 +156,36 @@ private:
 
     void will_allocate(size_t);
 
-    void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
+    void start_incremental_marking();
+    void cancel_incremental_marking();
+    void finish_incremental_marking();
+    void did_allocate_cell_during_incremental_marking(Cell&);
+
+    struct PauseTimeHistogram {
+        // Pauses are counted in power-of-two millisecond buckets, from below 1 ms to 128 ms and above.
+        static constexpr size_t bucket_count = 9;
+
+        void record(AK::Duration);
+        void dump(StringView name) const;
+
+        Array<size_t, bucket_count> buckets {};
+        size_t pause_count { 0 };
+        AK::Duration total_time;
+        AK::Duration longest_pause;
+    };
+    void dump_pause_time_histograms() const;
+
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
+    void gather_asan_fake_stack_roots(HashMap<Cell*, HeapRoot>&, HeapBlockIndex const&, FlatPtr);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void finish_marking(MarkingVisitor&);
     void finalize_unmarked_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void sweep_all_blocks();
+    void collect_young_generation(bool print_report, Core::ElapsedTimer const&);
+    void promote_nursery_blocks();
+    void release_nursery_if_unused();
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -156,8 +228,24 @@ private:
     bool m_should_gc_when_deferral_ends { false };
 
     bool m_collecting_garbage { false };
+
+    bool m_incremental_marking_enabled { false };
+    bool m_incremental_marking_in_progress { false };
+    OwnPtr<MarkingVisitor> m_incremental_marking_visitor;
+
+    bool m_lazy_sweeping_in_progress { false };
+
+    bool m_generational_collection_enabled { false };
+    OwnPtr<Nursery> m_nursery;
+
+    PauseTimeHistogram m_full_collection_pause_times;
+    PauseTimeHistogram m_young_generation_pause_times;
+    PauseTimeHistogram m_incremental_marking_pause_times;
+    PauseTimeHistogram m_incremental_finish_pause_times;
+
     StackInfo m_stack_info;
     AK::Function<void(HashMap<Cell*, GC::HeapRoot>&)> m_gather_embedder_roots;
+    AK::Function<void(Vector<StackRange>&)> m_gather_precisely_rooted_stack_ranges;
 
     Vector<AK::Function<void()>> m_post_gc_tasks;
 } SWIFT_IMMORTAL_REFERENCE;
@@ -28,6 +28,13 @@ NonnullOwnPtr<HeapBlock> HeapBlock::create_with_cell_size(Heap& heap, CellAlloca
     return NonnullOwnPtr<HeapBlock>(NonnullOwnPtr<HeapBlock>::Adopt, *block);
 }
 
+NonnullOwnPtr<HeapBlock> HeapBlock::create_in_nursery_block(void* memory, Heap& heap, CellAllocator& cell_allocator, size_t cell_size)
+{
+    auto* block = static_cast<HeapBlock*>(memory);
+    new (block) HeapBlock(heap, cell_allocator, cell_size);
+    return NonnullOwnPtr<HeapBlock>(NonnullOwnPtr<HeapBlock>::Adopt, *block);
+}
+
 HeapBlock::HeapBlock(Heap& heap, CellAllocator& cell_allocator, size_t cell_size)
     : HeapBlockBase(heap)
     , m_cell_allocator(cell_allocator)
@@ -37,16 +44,28 @@ HeapBlock::HeapBlock(Heap& heap, CellAllocator& cell_allocator, size_t cell_size
     ASAN_POISON_MEMORY_REGION(m_storage, block_size - sizeof(HeapBlock));
 }
 
+bool HeapBlock::sweep()
+{
+    bool has_live_cells = false;
+    for_each_cell([&](Cell* cell) {
+        if (cell->state() == Cell::State::Dead)
+            deallocate(cell);
+        else if (cell->state() == Cell::State::Live)
+            has_live_cells = true;
+    });
+    return has_live_cells;
+}
+
 void HeapBlock::deallocate(Cell* cell)
 {
     VERIFY(is_valid_cell_pointer(cell));
     VERIFY(!m_freelist || is_valid_cell_pointer(m_freelist));
-    VERIFY(cell->state() == Cell::State::Live);
+    VERIFY(cell->state() == Cell::State::Dead);
     VERIFY(!cell->is_marked());
 
     cell->~Cell();
     auto* freelist_entry = new (cell) FreelistEntry();
-    freelist_entry->set_state(Cell::State::Dead);
+    freelist_entry->set_state(Cell::State::Free);
     freelist_entry->next = m_freelist;
     m_freelist = freelist_entry;
 
@@ -27,6 +27,7 @@ class HeapBlock : public HeapBlockBase {
 public:
     using HeapBlockBase::block_size;
     static NonnullOwnPtr<HeapBlock> create_with_cell_size(Heap&, CellAllocator&, size_t cell_size, char const* class_name);
+    static NonnullOwnPtr<HeapBlock> create_in_nursery_block(void* memory, Heap&, CellAllocator&, size_t cell_size);
 
     size_t cell_size() const { return m_cell_size; }
     size_t cell_count() const { return (block_size - sizeof(HeapBlock)) / m_cell_size; }
@@ -48,7 +49,8 @@ public:
         return allocated_cell;
     }
 
-    void deallocate(Cell*);
+    // Destroys the cells that have died since the block was last swept. Returns whether any live cells are left.
+    bool sweep();
 
     template<typename Callback>
     void for_each_cell(Callback callback)
@@ -95,6 +97,8 @@ public:
 private:
     HeapBlock(Heap&, CellAllocator&, size_t cell_size);
 
+    void deallocate(Cell*);
+
     bool has_lazy_freelist() const { return m_next_lazy_freelist_index < cell_count(); }
 
     struct FreelistEntry final : public Cell {
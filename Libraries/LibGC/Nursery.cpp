@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Platform.h>
+#include <LibGC/BlockAllocator.h>
+#include <LibGC/HeapBlock.h>
+#include <LibGC/Nursery.h>
+#include <stdio.h>
+#include <sys/mman.h>
+
+#ifdef HAS_ADDRESS_SANITIZER
+#    include <sanitizer/asan_interface.h>
+#    include <sanitizer/lsan_interface.h>
+#endif
+
+namespace GC {
+
+Nursery::Nursery()
+    : m_block_size_shift(count_trailing_zeroes(HeapBlock::block_size))
+{
+    VERIFY(is_power_of_two(HeapBlock::block_size));
+
+    // NOTE: Only the blocks that are actually used take up any memory.
+    auto size = block_count * HeapBlock::block_size;
+    m_base = static_cast<u8*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE | MAP_NORESERVE, -1, 0));
+    VERIFY(m_base != MAP_FAILED);
+}
+
+Nursery::~Nursery()
+{
+    auto size = block_count * HeapBlock::block_size;
+    ASAN_UNPOISON_MEMORY_REGION(m_base, m_used_block_count * HeapBlock::block_size);
+    if (munmap(m_base, size) < 0) {
+        perror("munmap");
+        VERIFY_NOT_REACHED();
+    }
+}
+
+void* Nursery::allocate_block()
+{
+    // Blocks that have been given back are reused first, to keep the part of the nursery that is in use compact. Those
+    // that are still committed cost nothing to reuse, so they go first.
+    void* block;
+    if (!m_blocks_to_decommit.is_empty())
+        block = m_blocks_to_decommit.take_last();
+    else if (!m_free_blocks.is_empty())
+        block = m_free_blocks.take_last();
+    else if (m_used_block_count < block_count)
+        block = m_base + m_used_block_count++ * HeapBlock::block_size;
+    else
+        return nullptr;
+
+    m_young_blocks[(static_cast<u8*>(block) - m_base) >> m_block_size_shift] = true;
+    ++m_young_block_count;
+
+    ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
+    LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
+    return block;
+}
+
+void Nursery::deallocate_block(void* block)
+{
+    VERIFY(contains(block));
+    VERIFY(!is_young(block));
+
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
+    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
+    m_blocks_to_decommit.append(block);
+
+    // NOTE: Keeping more blocks committed than the young generation may take up at once wouldn't save us anything.
+    if (m_blocks_to_decommit.size() >= young_block_limit)
+        decommit_free_blocks();
+}
+
+void Nursery::decommit_free_blocks()
+{
+    BlockAllocator::decommit_blocks(m_blocks_to_decommit);
+    m_free_blocks.extend(move(m_blocks_to_decommit));
+}
+
+void Nursery::promote_all_blocks()
+{
+    m_young_blocks.span().trim(m_used_block_count).fill(false);
+    m_young_block_count = 0;
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Noncopyable.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibGC/Forward.h>
+#include <LibGC/Internals.h>
+
+namespace GC {
+
+// The nursery is where young cells, i.e. those allocated since the last collection, are allocated. Its blocks come from
+// a single contiguous mapping, so telling whether a cell is young only takes looking at its address, without touching
+// the cell itself.
+//
+// Cells are never moved out of the nursery. Instead, once a collection is done with the cells of a young block, the
+// survivors are promoted by making the whole block old, and it stays where it is until it becomes empty. So that old
+// blocks don't crowd out young ones, the nursery reserves far more address space than the young generation is ever
+// allowed to take up, and how many of its blocks may be young at once is limited separately.
+class Nursery {
+    AK_MAKE_NONCOPYABLE(Nursery);
+    AK_MAKE_NONMOVABLE(Nursery);
+
+public:
+    static constexpr size_t block_count = 65536;
+    static constexpr size_t young_block_limit = 512;
+
+    Nursery();
+    ~Nursery();
+
+    // Returns nullptr if every block of the nursery is in use.
+    void* allocate_block();
+
+    // NOTE: Like with the BlockAllocator, the memory of deallocated blocks is given back to the kernel in batches,
+    //       either when enough of them have piled up, or when decommit_free_blocks() is called.
+    void deallocate_block(void*);
+    void decommit_free_blocks();
+
+    // Whether none of the blocks that were ever handed out are in use anymore, young or old.
+    bool is_unused() const { return m_free_blocks.size() + m_blocks_to_decommit.size() == m_used_block_count; }
+
+    ALWAYS_INLINE bool is_young(void const* pointer) const
+    {
+        auto offset = bit_cast<FlatPtr>(pointer) - bit_cast<FlatPtr>(m_base);
+        if (offset >= block_count * HeapBlockBase::block_size)
+            return false;
+        return m_young_blocks[offset >> m_block_size_shift];
+    }
+
+    bool contains(void const* pointer) const
+    {
+        return bit_cast<FlatPtr>(pointer) - bit_cast<FlatPtr>(m_base) < block_count * HeapBlockBase::block_size;
+    }
+
+    size_t young_block_count() const { return m_young_block_count; }
+
+    // NOTE: Should the nursery ever run out of blocks, new cells are allocated as old ones.
+    bool should_collect_young_generation() const { return m_young_block_count >= young_block_limit; }
+
+    template<typename Callback>
+    void for_each_young_block(Callback callback)
+    {
+        for (size_t i = 0; i < m_used_block_count; ++i) {
+            if (m_young_blocks[i])
+                callback(*reinterpret_cast<HeapBlock*>(m_base + (i << m_block_size_shift)));
+        }
+    }
+
+    void promote_all_blocks();
+
+private:
+    u8* m_base { nullptr };
+    size_t m_block_size_shift { 0 };
+
+    // Blocks past this one have never been handed out.
+    size_t m_used_block_count { 0 };
+
+    // Free blocks whose memory is still committed.
+    Vector<void*> m_blocks_to_decommit;
+
+    // Free blocks whose memory has been given back to the kernel.
+    Vector<void*> m_free_blocks;
+    Array<bool, block_count> m_young_blocks {};
+    size_t m_young_block_count { 0 };
+};
+
+}
@@ -9,6 +9,7 @@
 #include <AK/Format.h>
 #include <AK/Traits.h>
 #include <AK/Types.h>
+#include <LibGC/WriteBarrier.h>
 
 namespace GC {
 
@@ -32,6 +33,8 @@ public:
     {
     }
 
+    Ref(Ref const&) = default;
+
     template<typename U>
     Ref(Ref<U> const& other)
     requires(IsConvertible<U*, T*>)
@@ -39,17 +42,26 @@ public:
     {
     }
 
+    Ref& operator=(Ref const& other)
+    {
+        m_ptr = other.m_ptr;
+        WriteBarrier::did_store(m_ptr);
+        return *this;
+    }
+
     template<typename U>
     Ref& operator=(Ref<U> const& other)
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
     Ref& operator=(T& other)
     {
         m_ptr = &other;
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
@@ -58,6 +70,7 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = &static_cast<T&>(other);
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
@@ -90,6 +103,8 @@ public:
     {
     }
 
+    Ptr(Ptr const&) = default;
+
     template<typename U>
     Ptr(Ptr<U> const& other)
     requires(IsConvertible<U*, T*>)
@@ -114,17 +129,26 @@ public:
     {
     }
 
+    Ptr& operator=(Ptr const& other)
+    {
+        m_ptr = other.m_ptr;
+        WriteBarrier::did_store(m_ptr);
+        return *this;
+    }
+
     template<typename U>
     Ptr& operator=(Ptr<U> const& other)
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
     Ptr& operator=(Ref<T> const& other)
     {
         m_ptr = other.ptr();
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
@@ -133,12 +157,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other.ptr());
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
     Ptr& operator=(T& other)
     {
         m_ptr = &other;
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
@@ -147,12 +173,14 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = &static_cast<T&>(other);
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
     Ptr& operator=(T* other)
     {
         m_ptr = other;
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
@@ -161,6 +189,7 @@ public:
     requires(IsConvertible<U*, T*>)
     {
         m_ptr = static_cast<T*>(other);
+        WriteBarrier::did_store(m_ptr);
         return *this;
     }
 
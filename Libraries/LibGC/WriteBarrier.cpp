@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibGC/Heap.h>
+#include <LibGC/WriteBarrier.h>
+
+namespace GC {
+
+bool WriteBarrier::s_enabled = false;
+
+static Vector<Heap*>& incrementally_marking_heaps()
+{
+    static Vector<Heap*> heaps;
+    return heaps;
+}
+
+void WriteBarrier::did_start_incremental_marking(Badge<Heap>, Heap& heap)
+{
+    incrementally_marking_heaps().append(&heap);
+    s_enabled = true;
+}
+
+void WriteBarrier::did_stop_incremental_marking(Badge<Heap>, Heap& heap)
+{
+    incrementally_marking_heaps().remove_first_matching([&](auto* marking_heap) { return marking_heap == &heap; });
+    s_enabled = !incrementally_marking_heaps().is_empty();
+}
+
+void WriteBarrier::did_store_slow(void const* pointer)
+{
+    if (!pointer)
+        return;
+
+    // NOTE: We don't know which heap the cell belongs to, so each marking heap checks whether the pointer is into one
+    //       of its blocks.
+    for (auto* heap : incrementally_marking_heaps())
+        heap->did_store_during_incremental_marking({}, pointer);
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Badge.h>
+#include <AK/Platform.h>
+#include <LibGC/Forward.h>
+
+namespace GC {
+
+// While a heap is marking incrementally, the mutator runs in between marking slices and may store a pointer to a cell
+// the marker hasn't seen yet into one it has already visited. Assignments to GC::Ptr and GC::Ref, which is how cells
+// update the fields they visit, report the stored pointer here, and such cells are marked right away.
+//
+// Copies are not reported, and neither is anything stored through a JS value, so that both stay as cheap as copying a
+// pointer. The pause that finishes the collection makes up for that by visiting the marked cells once more.
+class WriteBarrier {
+public:
+    ALWAYS_INLINE static void did_store(void const* pointer)
+    {
+        if (s_enabled) [[unlikely]]
+            did_store_slow(pointer);
+    }
+
+    static void did_start_incremental_marking(Badge<Heap>, Heap&);
+    static void did_stop_incremental_marking(Badge<Heap>, Heap&);
+
+private:
+    static void did_store_slow(void const* pointer);
+
+    static bool s_enabled;
+};
+
+}
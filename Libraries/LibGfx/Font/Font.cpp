@@ -105,8 +105,8 @@ float Font::point_size() const
 
 Font::~Font()
 {
-    if (m_harfbuzz_font)
-        hb_font_destroy(m_harfbuzz_font);
+    if (auto* harfbuzz_font = m_harfbuzz_font.load())
+        hb_font_destroy(harfbuzz_font);
 }
 
 Font const& Font::bold_variant() const
@@ -121,12 +121,21 @@ Font const& Font::bold_variant() const
 
 hb_font_t* Font::harfbuzz_font() const
 {
-    if (!m_harfbuzz_font) {
-        m_harfbuzz_font = hb_font_create(typeface().harfbuzz_typeface());
-        hb_font_set_scale(m_harfbuzz_font, pixel_size() * text_shaping_resolution, pixel_size() * text_shaping_resolution);
-        hb_font_set_ptem(m_harfbuzz_font, point_size());
+    if (auto* harfbuzz_font = m_harfbuzz_font.load())
+        return harfbuzz_font;
+
+    auto* harfbuzz_font = hb_font_create(typeface().harfbuzz_typeface());
+    hb_font_set_scale(harfbuzz_font, pixel_size() * text_shaping_resolution, pixel_size() * text_shaping_resolution);
+    hb_font_set_ptem(harfbuzz_font, point_size());
+    hb_font_make_immutable(harfbuzz_font);
+
+    // If another thread got here first, use its font instead.
+    hb_font_t* expected = nullptr;
+    if (!m_harfbuzz_font.compare_exchange_strong(expected, harfbuzz_font)) {
+        hb_font_destroy(harfbuzz_font);
+        return expected;
     }
-    return m_harfbuzz_font;
+    return harfbuzz_font;
 }
 
 SkFont Font::skia_font(float scale) const
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
 #include <AK/FlyString.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/Typeface.h>
@@ -50,7 +52,7 @@ enum FontWidth {
 
 constexpr float text_shaping_resolution = 64;
 
-class Font : public RefCounted<Font> {
+class Font : public AtomicRefCounted<Font> {
 public:
     Font(NonnullRefPtr<Typeface const>, float point_width, float point_height, unsigned dpi_x = DEFAULT_DPI, unsigned dpi_y = DEFAULT_DPI);
     ScaledFontMetrics metrics() const;
@@ -72,6 +74,7 @@ public:
     float width(Utf8View const&) const;
     FlyString const& family() const { return m_typeface->family(); }
 
+    // Only safe to call from the main thread, as they go through Typeface::font().
     NonnullRefPtr<Font> scaled_with_size(float point_size) const;
     NonnullRefPtr<Font> with_size(float point_size) const;
 
@@ -79,12 +82,16 @@ public:
 
     SkFont skia_font(float scale) const;
 
+    // Only safe to call from the main thread, as it looks up the variant in the FontDatabase, and caches it without any
+    // locking.
     Font const& bold_variant() const;
+
+    // Safe to call from any thread. The returned font is immutable, so it can be used for shaping on many threads at once.
     hb_font_t* harfbuzz_font() const;
 
 private:
     mutable RefPtr<Font const> m_bold_variant;
-    mutable hb_font_t* m_harfbuzz_font { nullptr };
+    mutable Atomic<hb_font_t*> m_harfbuzz_font { nullptr };
 
     NonnullRefPtr<Typeface const> m_typeface;
     float m_x_scale { 0.0f };
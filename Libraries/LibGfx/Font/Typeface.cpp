@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
+#include <harfbuzz/hb-ot.h>
 #include <harfbuzz/hb.h>
 
 #include <LibGfx/Font/Font.h>
@@ -41,10 +43,8 @@ Typeface::Typeface() = default;
 
 Typeface::~Typeface()
 {
-    if (m_harfbuzz_face)
-        hb_face_destroy(m_harfbuzz_face);
-    if (m_harfbuzz_blob)
-        hb_blob_destroy(m_harfbuzz_blob);
+    if (auto* harfbuzz_face = m_harfbuzz_face.load())
+        hb_face_destroy(harfbuzz_face);
 }
 
 NonnullRefPtr<Font> Typeface::font(float point_size) const
@@ -66,11 +66,80 @@ NonnullRefPtr<Font> Typeface::font(float point_size) const
 
 hb_face_t* Typeface::harfbuzz_typeface() const
 {
-    if (!m_harfbuzz_blob)
-        m_harfbuzz_blob = hb_blob_create(reinterpret_cast<char const*>(buffer().data()), buffer().size(), HB_MEMORY_MODE_READONLY, nullptr, [](void*) { });
-    if (!m_harfbuzz_face)
-        m_harfbuzz_face = hb_face_create(m_harfbuzz_blob, ttc_index());
-    return m_harfbuzz_face;
+    if (auto* harfbuzz_face = m_harfbuzz_face.load())
+        return harfbuzz_face;
+
+    // NOTE: The face keeps its own reference to the blob.
+    auto* blob = hb_blob_create(reinterpret_cast<char const*>(buffer().data()), buffer().size(), HB_MEMORY_MODE_READONLY, nullptr, [](void*) { });
+    auto* harfbuzz_face = hb_face_create(blob, ttc_index());
+    hb_blob_destroy(blob);
+    hb_face_make_immutable(harfbuzz_face);
+
+    // If another thread got here first, use its face instead.
+    hb_face_t* expected = nullptr;
+    if (!m_harfbuzz_face.compare_exchange_strong(expected, harfbuzz_face)) {
+        hb_face_destroy(harfbuzz_face);
+        return expected;
+    }
+    return harfbuzz_face;
+}
+
+bool Typeface::has_space_in_ligatures_or_kerning() const
+{
+    if (auto state = m_has_space_in_ligatures_or_kerning.load(); state != SpaceInLigaturesOrKerning::Unknown)
+        return state == SpaceInLigaturesOrKerning::Yes;
+
+    auto compute = [&] {
+        auto space_glyph = glyph_id_for_code_point(' ');
+        if (space_glyph == 0)
+            return false;
+
+        auto* face = harfbuzz_typeface();
+
+        // NOTE: HarfBuzz only falls back to the legacy kerning table if GPOS has no kerning of its own. That table isn't
+        //       made of lookups we could look into, so assume the worst.
+        auto has_gpos_kerning = [&] {
+            hb_tag_t feature_tags[32];
+            unsigned start_offset = 0;
+            while (true) {
+                unsigned feature_count = array_size(feature_tags);
+                auto total_feature_count = hb_ot_layout_table_get_feature_tags(face, HB_OT_TAG_GPOS, start_offset, &feature_count, feature_tags);
+                for (unsigned i = 0; i < feature_count; ++i) {
+                    if (feature_tags[i] == HB_TAG('k', 'e', 'r', 'n'))
+                        return true;
+                }
+                start_offset += feature_count;
+                if (feature_count == 0 || start_offset >= total_feature_count)
+                    return false;
+            }
+        }();
+        if (!has_gpos_kerning) {
+            auto* kern_table = hb_face_reference_table(face, HB_TAG('k', 'e', 'r', 'n'));
+            auto has_kern_table = hb_blob_get_length(kern_table) > 0;
+            hb_blob_destroy(kern_table);
+            if (has_kern_table)
+                return true;
+        }
+
+        auto* glyphs = hb_set_create();
+        ScopeGuard destroy_glyphs = [&] { hb_set_destroy(glyphs); };
+
+        for (auto table_tag : { HB_OT_TAG_GSUB, HB_OT_TAG_GPOS }) {
+            auto lookup_count = hb_ot_layout_table_get_lookup_count(face, table_tag);
+            for (unsigned lookup_index = 0; lookup_index < lookup_count; ++lookup_index) {
+                hb_set_clear(glyphs);
+                hb_ot_layout_lookup_collect_glyphs(face, table_tag, lookup_index, glyphs, glyphs, glyphs, nullptr);
+                if (hb_set_has(glyphs, space_glyph))
+                    return true;
+            }
+        }
+        return false;
+    };
+
+    // NOTE: Threads racing to get here all compute the same answer, so it doesn't matter which one stores it.
+    auto has_space = compute();
+    m_has_space_in_ligatures_or_kerning.store(has_space ? SpaceInLigaturesOrKerning::Yes : SpaceInLigaturesOrKerning::No);
+    return has_space;
 }
 
 }
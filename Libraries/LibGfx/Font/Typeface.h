@@ -6,8 +6,9 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
 #include <AK/HashMap.h>
-#include <AK/RefCounted.h>
 #include <LibGfx/Font/FontData.h>
 #include <LibGfx/Forward.h>
 
@@ -15,7 +16,6 @@
 #define DEFAULT_DPI 96
 
 class SkTypeface;
-struct hb_blob_t;
 struct hb_face_t;
 
 namespace Gfx {
@@ -34,7 +34,8 @@ struct ScaledFontMetrics {
     }
 };
 
-class Typeface : public RefCounted<Typeface> {
+// NOTE: Fonts keep a reference to their typeface, and may be released on any thread, so the reference count is atomic.
+class Typeface : public AtomicRefCounted<Typeface> {
 public:
     static ErrorOr<NonnullRefPtr<Typeface>> try_load_from_resource(Core::Resource const&, int ttc_index = 0);
     static ErrorOr<NonnullRefPtr<Typeface>> try_load_from_font_data(NonnullOwnPtr<Gfx::FontData>, int ttc_index = 0);
@@ -51,10 +52,16 @@ public:
     virtual u16 width() const = 0;
     virtual u8 slope() const = 0;
 
+    // Only safe to call from the main thread, as the fonts created so far are cached without any locking.
     [[nodiscard]] NonnullRefPtr<Font> font(float point_size) const;
 
+    // Safe to call from any thread. The returned face is immutable.
     hb_face_t* harfbuzz_typeface() const;
 
+    // Whether any ligature or kerning lookup involves the space glyph, in which case text can't be shaped a word at a time.
+    // Safe to call from any thread.
+    bool has_space_in_ligatures_or_kerning() const;
+
 protected:
     Typeface();
 
@@ -65,8 +72,14 @@ private:
     OwnPtr<FontData> m_font_data;
 
     mutable HashMap<float, NonnullRefPtr<Font>> m_fonts;
-    mutable hb_blob_t* m_harfbuzz_blob { nullptr };
-    mutable hb_face_t* m_harfbuzz_face { nullptr };
+    mutable Atomic<hb_face_t*> m_harfbuzz_face { nullptr };
+
+    enum class SpaceInLigaturesOrKerning : u8 {
+        Unknown,
+        No,
+        Yes,
+    };
+    mutable Atomic<SpaceInLigaturesOrKerning> m_has_space_in_ligatures_or_kerning { SpaceInLigaturesOrKerning::Unknown };
 };
 
 }
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BitCast.h>
+#include <AK/Debug.h>
+#include <AK/Format.h>
+#include <LibGfx/ShapedTextCache.h>
+
+namespace Gfx {
+
+ShapedTextCache& ShapedTextCache::the()
+{
+    // Each thread gets a cache of its own, so text can be shaped on any thread without taking a lock.
+    static thread_local ShapedTextCache s_the(4 * MiB);
+    return s_the;
+}
+
+ShapedTextCache::ShapedTextCache(size_t capacity_in_bytes)
+    : m_entries(capacity_in_bytes)
+{
+}
+
+ShapedTextCache::~ShapedTextCache() = default;
+
+bool ShapedTextCache::Key::matches(Font const& other_font, u32 other_letter_spacing_bits, StringView other_text, ShapeFeatures const& other_features) const
+{
+    if (font.ptr() != &other_font || letter_spacing_bits != other_letter_spacing_bits || text != other_text)
+        return false;
+    if (features.size() != other_features.size())
+        return false;
+    for (size_t i = 0; i < features.size(); ++i) {
+        if (__builtin_memcmp(features[i].tag, other_features[i].tag, sizeof(features[i].tag)) != 0 || features[i].value != other_features[i].value)
+            return false;
+    }
+    return true;
+}
+
+unsigned ShapedTextCache::hash(Font const& font, u32 letter_spacing_bits, StringView text, ShapeFeatures const& features)
+{
+    auto hash = pair_int_hash(text.hash(), ptr_hash(&font));
+    hash = pair_int_hash(hash, letter_spacing_bits);
+    for (auto const& feature : features) {
+        auto tag = (static_cast<u32>(feature.tag[0]) << 24) | (static_cast<u32>(feature.tag[1]) << 16) | (static_cast<u32>(feature.tag[2]) << 8) | static_cast<u32>(feature.tag[3]);
+        hash = pair_int_hash(hash, pair_int_hash(tag, feature.value));
+    }
+    return hash;
+}
+
+ShapedTextCache::ShapedText const* ShapedTextCache::get(Font const& font, float letter_spacing, StringView text, ShapeFeatures const& features)
+{
+    auto letter_spacing_bits = bit_cast<u32>(letter_spacing);
+    auto const* shaped_text = m_entries.get(hash(font, letter_spacing_bits, text, features), [&](Key const& key) {
+        return key.matches(font, letter_spacing_bits, text, features);
+    });
+
+    if constexpr (TEXT_SHAPING_DEBUG) {
+        if (auto lookup_count = hit_count() + miss_count(); lookup_count % 10000 == 0) {
+            dbgln("ShapedTextCache: {} hits in {} lookups ({:.1}%), {} entries using {} bytes",
+                hit_count(), lookup_count, 100.0 * hit_count() / lookup_count, m_entries.size(), size_in_bytes());
+        }
+    }
+
+    return shaped_text;
+}
+
+void ShapedTextCache::set(Font const& font, float letter_spacing, StringView text, ShapeFeatures const& features, ShapedText shaped_text)
+{
+    auto letter_spacing_bits = bit_cast<u32>(letter_spacing);
+    auto size_in_bytes = text.length() + shaped_text.glyphs.size() * sizeof(DrawGlyph);
+    m_entries.set({ font, letter_spacing_bits, features, text, hash(font, letter_spacing_bits, text, features) }, move(shaped_text), size_in_bytes);
+}
+
+void ShapedTextCache::clear()
+{
+    m_entries.clear();
+}
+
+}
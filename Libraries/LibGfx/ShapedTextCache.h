@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/LRUCache.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/TextLayout.h>
+
+namespace Gfx {
+
+// Keeps the glyphs of recently shaped text around, as layout tends to shape the same words over and over again, e.g.
+// once for every intrinsic size it needs and once more for the actual line boxes.
+class ShapedTextCache {
+    AK_MAKE_NONCOPYABLE(ShapedTextCache);
+    AK_MAKE_NONMOVABLE(ShapedTextCache);
+
+public:
+    // The cache for the calling thread.
+    static ShapedTextCache& the();
+
+    explicit ShapedTextCache(size_t capacity_in_bytes);
+    ~ShapedTextCache();
+
+    // The glyphs are positioned as if the text was shaped with its baseline starting at the origin.
+    struct ShapedText {
+        Vector<DrawGlyph> glyphs;
+        FloatPoint advance;
+    };
+
+    // The returned pointer is only valid until the cache is modified.
+    ShapedText const* get(Font const&, float letter_spacing, StringView text, ShapeFeatures const&);
+    void set(Font const&, float letter_spacing, StringView text, ShapeFeatures const&, ShapedText);
+
+    void clear();
+
+    size_t size_in_bytes() const { return m_entries.cost(); }
+    size_t hit_count() const { return m_entries.hit_count(); }
+    size_t miss_count() const { return m_entries.miss_count(); }
+
+private:
+    struct Key {
+        NonnullRefPtr<Font const> font;
+        u32 letter_spacing_bits { 0 };
+        ShapeFeatures features;
+        ByteString text;
+        unsigned hash { 0 };
+
+        bool matches(Font const&, u32 letter_spacing_bits, StringView text, ShapeFeatures const&) const;
+        bool operator==(Key const& other) const { return other.matches(font, letter_spacing_bits, text, features); }
+    };
+
+    struct KeyTraits : DefaultTraits<Key> {
+        static unsigned hash(Key const& key) { return key.hash; }
+    };
+
+    static unsigned hash(Font const&, u32 letter_spacing_bits, StringView text, ShapeFeatures const&);
+
+    LRUCache<Key, ShapedText, KeyTraits> m_entries;
+};
+
+}
@@ -7,8 +7,10 @@
  */
 
 #include "TextLayout.h"
+#include <AK/Noncopyable.h>
 #include <AK/TypeCasts.h>
 #include <LibGfx/Point.h>
+#include <LibGfx/ShapedTextCache.h>
 #include <harfbuzz/hb.h>
 
 namespace Gfx {
@@ -52,9 +54,46 @@ Vector<NonnullRefPtr<GlyphRun>> shape_text(FloatPoint baseline_start, Utf8View s
     return runs;
 }
 
-RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+// HarfBuzz buffers can't be shared between threads, so every thread keeps its own small pool of them. A buffer is
+// taken out of the pool for as long as it's used, which keeps shaping re-entrant on a single thread too.
+struct ShapingBufferPool {
+    ~ShapingBufferPool()
+    {
+        for (auto* buffer : free_buffers)
+            hb_buffer_destroy(buffer);
+    }
+
+    Vector<hb_buffer_t*, 2> free_buffers;
+};
+
+static thread_local ShapingBufferPool s_shaping_buffer_pool;
+
+class ShapingBuffer {
+    AK_MAKE_NONCOPYABLE(ShapingBuffer);
+    AK_MAKE_NONMOVABLE(ShapingBuffer);
+
+public:
+    ShapingBuffer()
+        : m_buffer(s_shaping_buffer_pool.free_buffers.is_empty() ? hb_buffer_create() : s_shaping_buffer_pool.free_buffers.take_last())
+    {
+    }
+
+    ~ShapingBuffer()
+    {
+        hb_buffer_reset(m_buffer);
+        s_shaping_buffer_pool.free_buffers.append(m_buffer);
+    }
+
+    hb_buffer_t* ptr() const { return m_buffer; }
+
+private:
+    hb_buffer_t* m_buffer { nullptr };
+};
+
+static ShapedTextCache::ShapedText shape_text_with_harfbuzz(float letter_spacing, Utf8View string, Gfx::Font const& font, ShapeFeatures const& features)
 {
-    static hb_buffer_t* buffer = hb_buffer_create();
+    ShapingBuffer shaping_buffer;
+    auto* buffer = shaping_buffer.ptr();
     hb_buffer_add_utf8(buffer, reinterpret_cast<char const*>(string.bytes()), string.byte_length(), 0, -1);
     hb_buffer_guess_segment_properties(buffer);
 
@@ -84,7 +123,8 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf
     auto* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
 
     Vector<Gfx::DrawGlyph> glyph_run;
-    FloatPoint point = baseline_start;
+    glyph_run.ensure_capacity(glyph_count);
+    FloatPoint point;
     for (size_t i = 0; i < glyph_count; ++i) {
 
         auto position = point
@@ -99,15 +139,84 @@ RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf
             point.translate_by(letter_spacing, 0);
     }
 
-    auto run = adopt_ref(*new Gfx::GlyphRun(move(glyph_run), font, text_type, point.x() - baseline_start.x()));
-    hb_buffer_reset(buffer);
-    return run;
+    return { move(glyph_run), point };
+}
+
+// Shaping text a word at a time lets long runs of text share cache entries with the words they're made of. That only
+// gives the same result as shaping it all at once if nothing reaches across the spaces between words, so we stick to
+// scripts that neither join nor reorder words, and fonts that don't kern or form ligatures with spaces.
+static bool can_shape_word_by_word(Utf8View const& string, Gfx::Font const& font)
+{
+    // NOTE: Everything before Hebrew in the Unicode code space is written left to right.
+    for (auto code_point : string) {
+        if (code_point >= 0x0590)
+            return false;
+    }
+    return !font.typeface().has_space_in_ligatures_or_kerning();
+}
+
+template<typename Callback>
+static void for_each_shaped_segment(float letter_spacing, Utf8View const& string, Gfx::Font const& font, ShapeFeatures const& features, Callback callback)
+{
+    auto& cache = ShapedTextCache::the();
+
+    auto shape_segment = [&](StringView segment) {
+        if (auto const* shaped_text = cache.get(font, letter_spacing, segment, features)) {
+            callback(*shaped_text);
+            return;
+        }
+        auto shaped_text = shape_text_with_harfbuzz(letter_spacing, Utf8View { segment }, font, features);
+        callback(shaped_text);
+        cache.set(font, letter_spacing, segment, features, move(shaped_text));
+    };
+
+    auto text = string.as_string();
+    if (!can_shape_word_by_word(string, font)) {
+        shape_segment(text);
+        return;
+    }
+
+    // Every segment is a word along with the spaces following it.
+    size_t segment_start = 0;
+    for (size_t i = 1; i < text.length(); ++i) {
+        if (text[i - 1] == ' ' && text[i] != ' ') {
+            shape_segment(text.substring_view(segment_start, i - segment_start));
+            segment_start = i;
+        }
+    }
+    shape_segment(text.substring_view(segment_start));
+}
+
+RefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spacing, Utf8View string, Gfx::Font const& font, GlyphRun::TextType text_type, ShapeFeatures const& features)
+{
+    Vector<Gfx::DrawGlyph> glyph_run;
+    FloatPoint point = baseline_start;
+    for_each_shaped_segment(letter_spacing, string, font, features, [&](ShapedTextCache::ShapedText const& shaped_text) {
+        if (shaped_text.glyphs.is_empty())
+            return;
+
+        // Letter spacing goes between the last glyph of one segment and the first glyph of the next.
+        if (!glyph_run.is_empty())
+            point.translate_by(letter_spacing, 0);
+
+        glyph_run.ensure_capacity(glyph_run.size() + shaped_text.glyphs.size());
+        for (auto glyph : shaped_text.glyphs) {
+            glyph.translate_by(point);
+            glyph_run.unchecked_append(glyph);
+        }
+        point += shaped_text.advance;
+    });
+
+    return adopt_ref(*new Gfx::GlyphRun(move(glyph_run), font, text_type, point.x() - baseline_start.x()));
 }
 
 float measure_text_width(Utf8View const& string, Gfx::Font const& font, ShapeFeatures const& features)
 {
-    auto glyph_run = shape_text({}, 0, string, font, GlyphRun::TextType::Common, features);
-    return glyph_run->width();
+    float width = 0;
+    for_each_shaped_segment(0, string, font, features, [&](ShapedTextCache::ShapedText const& shaped_text) {
+        width += shaped_text.advance.x();
+    });
+    return width;
 }
 
 }
@@ -35,6 +35,7 @@
 #include <LibJS/Runtime/ObjectEnvironment.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/RegExpCache.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/TypedArray.h>
 #include <LibJS/Runtime/Value.h>
@@ -1387,13 +1388,10 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<FlyStri
         if (storage
             && storage->is_simple_storage()
             && !object.may_interfere_with_indexed_property_access()) {
-            auto maybe_value = storage->get(index);
-            if (maybe_value.has_value()) {
-                auto existing_value = maybe_value->value;
-                if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
-                    return {};
-                }
+            auto& simple_storage = static_cast<SimpleIndexedPropertyStorage&>(*storage);
+            if (simple_storage.inline_has_index(index) && !simple_storage.elements()[index].is_accessor()) {
+                simple_storage.inline_put(index, value);
+                return {};
             }
         }
 
@@ -1548,9 +1546,14 @@ inline Value new_regexp(VM& vm, ParsedRegex const& parsed_regex, String const& p
 
     // 3. Return ! RegExpCreate(pattern, flags).
     auto& realm = *vm.current_realm();
-    Regex<ECMA262> regex(parsed_regex.regex, parsed_regex.pattern.to_byte_string(), parsed_regex.flags);
+    auto& regexp_cache = vm.regexp_cache();
+    auto regex = regexp_cache.get(parsed_regex.pattern, parsed_regex.flags);
+    if (!regex.has_value()) {
+        regex = Regex<ECMA262>(parsed_regex.regex, parsed_regex.pattern.to_byte_string(), parsed_regex.flags);
+        regexp_cache.set(parsed_regex.pattern, parsed_regex.flags, *regex);
+    }
     // NOTE: We bypass RegExpCreate and subsequently RegExpAlloc as an optimization to use the already parsed values.
-    auto regexp_object = RegExpObject::create(realm, move(regex), pattern, flags);
+    auto regexp_object = RegExpObject::create(realm, regex.release_value(), pattern, flags);
     // RegExpAlloc has these two steps from the 'Legacy RegExp features' proposal.
     regexp_object->set_realm(realm);
     // We don't need to check 'If SameValue(newTarget, thisRealm.[[Intrinsics]].[[%RegExp%]]) is true'
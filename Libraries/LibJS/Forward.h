@@ -201,12 +201,14 @@ class Parser;
 struct ParserError;
 class PrimitiveString;
 class Program;
+class ProgramCache;
 class PromiseCapability;
 class PromiseReaction;
 class PropertyAttributes;
 class PropertyDescriptor;
 class PropertyKey;
 class Realm;
+class RegExpCache;
 class Reference;
 class ScopeNode;
 class Script;
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/ProgramCache.h>
+
+namespace JS {
+
+ProgramCache::ProgramCache(size_t capacity_in_bytes)
+    : m_entries(capacity_in_bytes)
+{
+}
+
+ProgramCache::~ProgramCache() = default;
+
+unsigned ProgramCache::hash(StringView filename, StringView source_text)
+{
+    return pair_int_hash(source_text.hash(), filename.hash());
+}
+
+bool ProgramCache::Key::matches(StringView other_filename, StringView source_text, Program::Type other_program_type, size_t other_line_number_offset) const
+{
+    if (program_type != other_program_type || line_number_offset != other_line_number_offset)
+        return false;
+    return filename == other_filename && source_code->code().bytes_as_string_view() == source_text;
+}
+
+RefPtr<Program> ProgramCache::get(StringView filename, StringView source_text, Program::Type program_type, size_t line_number_offset)
+{
+    auto* program = m_entries.get(hash(filename, source_text), [&](Key const& key) {
+        return key.matches(filename, source_text, program_type, line_number_offset);
+    });
+    if (!program)
+        return nullptr;
+    return *program;
+}
+
+void ProgramCache::set(StringView filename, StringView source_text, Program::Type program_type, size_t line_number_offset, NonnullRefPtr<Program> program)
+{
+    Key key {
+        .filename = String::from_utf8(filename).release_value_but_fixme_should_propagate_errors(),
+        .source_code = program->source_code(),
+        .program_type = program_type,
+        .line_number_offset = line_number_offset,
+        .hash = hash(filename, source_text),
+    };
+
+    // NOTE: The size of the source is what we go by, as the size of the AST and bytecode built from it grows with it.
+    m_entries.set(move(key), move(program), source_text.length());
+}
+
+void ProgramCache::clear()
+{
+    m_entries.clear();
+}
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/LRUCache.h>
+#include <AK/Noncopyable.h>
+#include <AK/String.h>
+#include <LibJS/AST.h>
+#include <LibJS/SourceCode.h>
+
+namespace JS {
+
+// Keeps the programs of recently parsed scripts and modules around, so that parsing the same source from the same place
+// again (e.g. when navigating back to a page) can skip lexing and parsing. The bytecode generated for the functions in
+// a program lives on its AST, so that is reused as well.
+class ProgramCache {
+    AK_MAKE_NONCOPYABLE(ProgramCache);
+    AK_MAKE_NONMOVABLE(ProgramCache);
+
+public:
+    explicit ProgramCache(size_t capacity_in_bytes);
+    ~ProgramCache();
+
+    RefPtr<Program> get(StringView filename, StringView source_text, Program::Type, size_t line_number_offset);
+    void set(StringView filename, StringView source_text, Program::Type, size_t line_number_offset, NonnullRefPtr<Program>);
+
+    void clear();
+
+    size_t size_in_bytes() const { return m_entries.cost(); }
+
+private:
+    // NOTE: The source text is that of the program, so the key doesn't need a copy of its own.
+    struct Key {
+        String filename;
+        NonnullRefPtr<SourceCode const> source_code;
+        Program::Type program_type { Program::Type::Script };
+        size_t line_number_offset { 0 };
+        unsigned hash { 0 };
+
+        bool matches(StringView filename, StringView source_text, Program::Type, size_t line_number_offset) const;
+        bool operator==(Key const& other) const { return other.matches(filename, source_code->code().bytes_as_string_view(), program_type, line_number_offset); }
+    };
+
+    struct KeyTraits : DefaultTraits<Key> {
+        static unsigned hash(Key const& key) { return key.hash; }
+    };
+
+    static unsigned hash(StringView filename, StringView source_text);
+
+    LRUCache<Key, NonnullRefPtr<Program>, KeyTraits> m_entries;
+};
+
+}
@@ -174,8 +174,19 @@ ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object
     auto items = GC::RootVector<Value> { vm.heap() };
 
     // 2. Let k be 0.
+    size_t k = 0;
+
+    // OPTIMIZATION: Reading the elements has no side effects, so the ones of packed simple storage can be taken in one go.
+    if (auto const* storage = simple_storage_for_direct_access(object); storage && storage->is_packed()) {
+        auto const& elements = storage->elements();
+        auto end = min(length, storage->array_like_size());
+        items.ensure_capacity(end);
+        for (; k < end && !elements[k].is_accessor(); ++k)
+            items.unchecked_append(elements[k]);
+    }
+
     // 3. Repeat, while k < len,
-    for (size_t k = 0; k < length; ++k) {
+    for (; k < length; ++k) {
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -220,6 +231,29 @@ ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object
     return items;
 }
 
+// Compares the decimal strings of two integers by their code units, like IsLessThan() does for strings.
+static double compare_int32_strings(i32 x, i32 y)
+{
+    auto to_decimal = [](i32 value, Span<char> buffer) {
+        auto magnitude = value < 0 ? static_cast<u32>(-static_cast<i64>(value)) : static_cast<u32>(value);
+        auto position = buffer.size();
+        do {
+            buffer[--position] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0)
+            buffer[--position] = '-';
+        return StringView { buffer.data() + position, buffer.size() - position };
+    };
+
+    char x_buffer[11];
+    char y_buffer[11];
+    auto result = to_decimal(x, x_buffer).compare(to_decimal(y, y_buffer));
+    if (result < 0)
+        return -1;
+    return result > 0 ? 1 : 0;
+}
+
 // 23.1.3.30.2 CompareArrayElements ( x, y, comparefn ), https://tc39.es/ecma262/#sec-comparearrayelements
 ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, FunctionObject* comparefn)
 {
@@ -235,6 +269,10 @@ ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, Funct
     if (y.is_undefined())
         return -1;
 
+    // OPTIMIZATION: Arrays of integers are common, and their strings can be compared without creating them.
+    if (comparefn == nullptr && x.is_int32() && y.is_int32())
+        return compare_int32_strings(x.as_i32(), y.as_i32());
+
     // 4. If comparefn is not undefined, then
     if (comparefn != nullptr) {
         // a. Let v be ? ToNumber(? Call(comparefn, undefined, « x, y »)).
@@ -412,4 +450,25 @@ ThrowCompletionOr<GC::RootVector<Value>> Array::internal_own_property_keys() con
     return { move(keys) };
 }
 
+SimpleIndexedPropertyStorage const* simple_storage_for_direct_access(Object const& object)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage const*>(storage);
+}
+
+Optional<Value> get_element_directly(Object const& object, size_t index)
+{
+    auto const* storage = simple_storage_for_direct_access(object);
+    if (!storage || index >= storage->array_like_size())
+        return {};
+    auto element = storage->inline_get(index);
+    if (!element.has_value() || element->value.is_accessor())
+        return {};
+    return element->value;
+}
+
 }
@@ -83,4 +83,10 @@ enum class Holes {
 ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
+// OPTIMIZATION: If the indexed properties of an object are in simple storage and nothing intercepts access to them, each
+// element in the storage is an own data property. HasProperty() for its index is true and Get() returns the element,
+// so it can be read from the storage directly.
+SimpleIndexedPropertyStorage const* simple_storage_for_direct_access(Object const&);
+Optional<Value> get_element_directly(Object const&, size_t index);
+
 }
@@ -697,6 +697,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 4. Let k be 0.
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
+        // OPTIMIZATION: The callback may change the array in any way, so this has to be checked for every element.
+        if (auto k_value = get_element_directly(object, k); k_value.has_value()) {
+            TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
+            continue;
+        }
+
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -795,6 +801,34 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Comparing has no side effects, so the elements of packed simple storage can be searched in one go.
+    //               Elements of a numeric kind can only be strictly equal to a number, which is compared directly.
+    if (auto const* storage = simple_storage_for_direct_access(object); storage && storage->is_packed()) {
+        auto const* elements = storage->elements().data();
+        auto end = min(length, storage->array_like_size());
+        auto element_kind = storage->element_kind();
+
+        if (element_kind == SimpleIndexedPropertyStorage::ElementKind::Packed) {
+            for (; k < end; ++k) {
+                if (is_strictly_equal(search_element, elements[k]))
+                    return Value(k);
+            }
+        } else if (search_element.is_int32() && element_kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32) {
+            auto search_value = search_element.as_i32();
+            for (; k < end; ++k) {
+                if (elements[k].as_i32() == search_value)
+                    return Value(k);
+            }
+        } else if (search_element.is_number()) {
+            auto search_value = search_element.as_double();
+            for (; k < end; ++k) {
+                if (elements[k].as_double() == search_value)
+                    return Value(k);
+            }
+        }
+        k = max(k, end);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -958,6 +992,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // OPTIMIZATION: The callback may change the array in any way, so this has to be checked for every element.
+        if (auto k_value = get_element_directly(object, k); k_value.has_value()) {
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, *k_value, Value(k), object));
+            TRY(array->create_data_property_or_throw(property_key, mapped_value));
+            continue;
+        }
+
         // b. Let kPresent be ? HasProperty(O, Pk).
         auto k_present = TRY(object->has_property(property_key));
 
@@ -18,6 +18,8 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements)
+        m_element_kind = max(m_element_kind, element_kind_of(value));
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -48,27 +50,36 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        // Storing past the end leaves holes in between.
+        if (index > m_array_size)
+            m_element_kind = ElementKind::Holey;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
     m_packed_elements[index] = value;
+    m_element_kind = max(m_element_kind, element_kind_of(value));
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
     m_packed_elements[index] = js_special_empty_value();
+    m_element_kind = ElementKind::Holey;
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_first()
 {
     m_array_size--;
+    if (m_array_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
     return { m_packed_elements.take_first(), default_attributes };
 }
 
 ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 {
     m_array_size--;
+    if (m_array_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
     auto last_element = m_packed_elements[m_array_size];
     m_packed_elements[m_array_size] = js_special_empty_value();
     return { last_element, default_attributes };
@@ -76,6 +87,10 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_element_kind = ElementKind::Holey;
+    else if (new_size == 0)
+        m_element_kind = ElementKind::PackedInt32;
     m_array_size = new_size;
     m_packed_elements.resize_with_default_value_and_keep_capacity(new_size, js_special_empty_value());
     return true;
@@ -267,7 +282,10 @@ size_t IndexedProperties::real_size() const
     if (!m_storage)
         return 0;
     if (m_storage->is_simple_storage()) {
-        auto& packed_elements = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).elements();
+        auto const& storage = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage);
+        if (storage.is_packed())
+            return storage.array_like_size();
+        auto& packed_elements = storage.elements();
         size_t size = 0;
         for (auto& element : packed_elements) {
             if (!element.is_special_empty_value())
@@ -287,6 +305,11 @@ Vector<u32> IndexedProperties::indices() const
         auto const& elements = storage.elements();
         Vector<u32> indices;
         indices.ensure_capacity(storage.array_like_size());
+        if (storage.is_packed()) {
+            for (size_t i = 0; i < storage.array_like_size(); ++i)
+                indices.unchecked_append(i);
+            return indices;
+        }
         for (size_t i = 0; i < elements.size(); ++i) {
             if (!elements.at(i).is_special_empty_value())
                 indices.unchecked_append(i);
@@ -64,6 +64,19 @@ public:
     }
     explicit SimpleIndexedPropertyStorage(Vector<Value>&& initial_values);
 
+    // What is known about the elements, from most to least specific. Storing an element that doesn't fit the current
+    // kind moves the storage to a more general one, but never back, unless the storage is emptied. The packed kinds
+    // have no holes below array_like_size(), so every index below it is present.
+    enum class ElementKind : u8 {
+        PackedInt32,
+        PackedDouble,
+        Packed,
+        Holey,
+    };
+
+    ElementKind element_kind() const { return m_element_kind; }
+    bool is_packed() const { return m_element_kind != ElementKind::Holey; }
+
     virtual bool has_index(u32 index) const override;
     virtual Optional<ValueAndAttributes> get(u32 index) const override;
     virtual void put(u32 index, Value value, PropertyAttributes attributes = default_attributes) override;
@@ -80,7 +93,9 @@ public:
 
     [[nodiscard]] bool inline_has_index(u32 index) const
     {
-        return index < m_array_size && !m_packed_elements.data()[index].is_special_empty_value();
+        if (index >= m_array_size)
+            return false;
+        return is_packed() || !m_packed_elements.data()[index].is_special_empty_value();
     }
 
     [[nodiscard]] Optional<ValueAndAttributes> inline_get(u32 index) const
@@ -90,13 +105,33 @@ public:
         return ValueAndAttributes { m_packed_elements.data()[index], default_attributes };
     }
 
+    // Replaces an element that is already present, see inline_has_index().
+    void inline_put(u32 index, Value value)
+    {
+        VERIFY(index < m_array_size);
+        m_packed_elements.data()[index] = value;
+        m_element_kind = max(m_element_kind, element_kind_of(value));
+    }
+
 private:
     friend GenericIndexedPropertyStorage;
 
+    static ElementKind element_kind_of(Value value)
+    {
+        if (value.is_int32())
+            return ElementKind::PackedInt32;
+        if (value.is_number())
+            return ElementKind::PackedDouble;
+        if (value.is_special_empty_value())
+            return ElementKind::Holey;
+        return ElementKind::Packed;
+    }
+
     void grow_storage_if_needed();
 
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::PackedInt32 };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
@@ -177,6 +212,18 @@ public:
 
     Vector<u32> indices() const;
 
+    // Numbers aren't cells, so the GC doesn't have to look at elements that are known to all be numbers.
+    bool contains_only_numbers() const
+    {
+        if (!m_storage)
+            return true;
+        if (!m_storage->is_simple_storage())
+            return false;
+        auto element_kind = static_cast<SimpleIndexedPropertyStorage const&>(*m_storage).element_kind();
+        return element_kind == SimpleIndexedPropertyStorage::ElementKind::PackedInt32
+            || element_kind == SimpleIndexedPropertyStorage::ElementKind::PackedDouble;
+    }
+
     template<typename Callback>
     void for_each_value(Callback callback)
     {
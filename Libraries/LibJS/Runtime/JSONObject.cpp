@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/FloatingPointStringConversions.h>
 #include <AK/Function.h>
+#include <AK/GenericLexer.h>
+#include <AK/HashMap.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
@@ -12,6 +15,7 @@
 #include <AK/TypeCasts.h>
 #include <AK/Utf16View.h>
 #include <AK/Utf8View.h>
+#include <LibGC/RootVector.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigIntObject.h>
@@ -414,6 +418,325 @@ String JSONObject::quote_json_string(String string)
     return builder.to_string_without_validation();
 }
 
+static constexpr bool is_json_space(char ch)
+{
+    return ch == '\t' || ch == '\n' || ch == '\r' || ch == ' ';
+}
+
+// Turns JSON text into JS values in a single pass, without building an AK::JsonValue tree first.
+// NOTE: The text must be valid UTF-8, as strings without escape sequences are taken from it as they are.
+class JSONParser : private GenericLexer {
+public:
+    static ThrowCompletionOr<Value> parse(VM& vm, StringView text)
+    {
+        JSONParser parser(vm, text);
+        auto result = TRY(parser.parse_value());
+        parser.ignore_while(is_json_space);
+        if (!parser.is_eof())
+            return parser.malformed();
+        return result;
+    }
+
+private:
+    JSONParser(VM& vm, StringView text)
+        : GenericLexer(text)
+        , m_vm(vm)
+        , m_realm(*vm.current_realm())
+        , m_element_stack(vm.heap())
+    {
+    }
+
+    Completion malformed() const { return m_vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed); }
+
+    ThrowCompletionOr<Value> parse_value();
+    ThrowCompletionOr<Value> parse_object();
+    ThrowCompletionOr<Value> parse_array();
+    ThrowCompletionOr<Value> parse_number();
+    ThrowCompletionOr<Value> parse_string();
+    ThrowCompletionOr<PropertyKey> parse_property_key();
+    ThrowCompletionOr<Variant<StringView, String>> consume_string();
+
+    VM& m_vm;
+    Realm& m_realm;
+
+    // The elements of all arrays that are being parsed, so every array gets storage of exactly the right size once
+    // its last element is known.
+    GC::RootVector<Value> m_element_stack;
+
+    // Arrays of records repeat the same keys over and over. Looking them up by their text skips creating a new string
+    // for each of them, and leads to the same shape transitions being taken for every record.
+    static constexpr size_t max_cached_property_keys = 1024;
+    HashMap<StringView, PropertyKey> m_property_key_cache;
+};
+
+ThrowCompletionOr<Value> JSONParser::parse_value()
+{
+    ignore_while(is_json_space);
+
+    switch (peek()) {
+    case '{':
+        return parse_object();
+    case '[':
+        return parse_array();
+    case '"':
+        return parse_string();
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9':
+        return parse_number();
+    case 't':
+        if (consume_specific("true"sv))
+            return Value(true);
+        break;
+    case 'f':
+        if (consume_specific("false"sv))
+            return Value(false);
+        break;
+    case 'n':
+        if (consume_specific("null"sv))
+            return js_null();
+        break;
+    }
+
+    return malformed();
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_object()
+{
+    if (m_vm.did_reach_stack_space_limit())
+        return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+    auto object = Object::create(m_realm, m_realm.intrinsics().object_prototype());
+
+    ignore(); // '{'
+    ignore_while(is_json_space);
+    if (consume_specific('}'))
+        return object;
+
+    for (;;) {
+        auto key = TRY(parse_property_key());
+        ignore_while(is_json_space);
+        if (!consume_specific(':'))
+            return malformed();
+
+        auto value = TRY(parse_value());
+
+        // NOTE: If a key appears more than once, the last value wins, but the property keeps the position of the first.
+        object->define_direct_property(key, value, default_attributes);
+
+        ignore_while(is_json_space);
+        if (consume_specific('}'))
+            return object;
+        if (!consume_specific(','))
+            return malformed();
+        ignore_while(is_json_space);
+    }
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_array()
+{
+    if (m_vm.did_reach_stack_space_limit())
+        return m_vm.throw_completion<InternalError>(ErrorType::CallStackSizeExceeded);
+
+    auto elements_start = m_element_stack.size();
+
+    ignore(); // '['
+    ignore_while(is_json_space);
+    if (!consume_specific(']')) {
+        for (;;) {
+            m_element_stack.append(TRY(parse_value()));
+
+            ignore_while(is_json_space);
+            if (consume_specific(']'))
+                break;
+            if (!consume_specific(','))
+                return malformed();
+        }
+    }
+
+    // NOTE: The elements have to stay on the element stack until the array holds on to them, as allocating the array
+    //       may cause a garbage collection.
+    auto array = MUST(Array::create(m_realm, 0));
+
+    auto element_count = m_element_stack.size() - elements_start;
+    if (element_count > 0) {
+        Vector<Value> elements;
+        elements.ensure_capacity(element_count);
+        elements.unchecked_append(m_element_stack.data() + elements_start, element_count);
+        array->set_indexed_property_elements(move(elements));
+        m_element_stack.shrink(elements_start);
+    }
+
+    return array;
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_number()
+{
+    auto start = tell();
+
+    auto is_negative = consume_specific('-');
+
+    // Integers with up to 15 digits are exactly representable as doubles, so we build those up as we go.
+    // Everything else is handed to the floating point parser once we know where the number ends.
+    u64 integer = 0;
+    size_t integer_digits = 0;
+    if (consume_specific('0')) {
+        integer_digits = 1;
+    } else {
+        if (!is_ascii_digit(peek()))
+            return malformed();
+        while (is_ascii_digit(peek())) {
+            integer = integer * 10 + parse_ascii_digit(consume());
+            ++integer_digits;
+        }
+    }
+
+    auto is_integer = true;
+    if (consume_specific('.')) {
+        if (!is_ascii_digit(peek()))
+            return malformed();
+        ignore_while(is_ascii_digit);
+        is_integer = false;
+    }
+    if (consume_specific('e') || consume_specific('E')) {
+        if (!consume_specific('+'))
+            consume_specific('-');
+        if (!is_ascii_digit(peek()))
+            return malformed();
+        ignore_while(is_ascii_digit);
+        is_integer = false;
+    }
+
+    if (is_integer && integer_digits <= 15) {
+        auto value = static_cast<double>(integer);
+        return Value(is_negative ? -value : value);
+    }
+
+    auto number_text = m_input.substring_view(start, tell() - start);
+    auto const* number_start = number_text.characters_without_null_termination();
+    auto const* number_end = number_start + number_text.length();
+
+    auto result = parse_first_floating_point<double>(number_start, number_end);
+    if (!result.parsed_value() || result.end_ptr != number_end)
+        return malformed();
+    return Value(result.value);
+}
+
+ThrowCompletionOr<Value> JSONParser::parse_string()
+{
+    auto string = TRY(consume_string());
+    return string.visit(
+        [&](StringView view) -> Value { return PrimitiveString::create(m_vm, String::from_utf8_without_validation(view.bytes())); },
+        [&](String& unescaped) -> Value { return PrimitiveString::create(m_vm, move(unescaped)); });
+}
+
+ThrowCompletionOr<PropertyKey> JSONParser::parse_property_key()
+{
+    if (peek() != '"')
+        return malformed();
+
+    auto string = TRY(consume_string());
+    if (auto* unescaped = string.get_pointer<String>())
+        return PropertyKey { *unescaped };
+
+    auto view = string.get<StringView>();
+    if (auto it = m_property_key_cache.find(view); it != m_property_key_cache.end())
+        return it->value;
+
+    PropertyKey key { String::from_utf8_without_validation(view.bytes()) };
+    if (m_property_key_cache.size() < max_cached_property_keys)
+        m_property_key_cache.set(view, key);
+    return key;
+}
+
+// ECMA-404 9 String
+ThrowCompletionOr<Variant<StringView, String>> JSONParser::consume_string()
+{
+    ignore(); // '"'
+
+    // Strings without escape sequences are used as a view into the input, which saves building them up.
+    auto literal_characters_start = tell();
+    for (;;) {
+        if (is_eof())
+            return malformed();
+        auto ch = peek();
+        if (ch == '"') {
+            auto view = m_input.substring_view(literal_characters_start, tell() - literal_characters_start);
+            ignore();
+            return Variant<StringView, String> { view };
+        }
+        if (ch == '\\')
+            break;
+        if (is_ascii_c0_control(ch))
+            return malformed();
+        ignore();
+    }
+
+    StringBuilder builder;
+    builder.append(m_input.substring_view(literal_characters_start, tell() - literal_characters_start));
+
+    for (;;) {
+        if (is_eof())
+            return malformed();
+
+        auto ch = consume();
+        if (ch == '"')
+            break;
+        if (is_ascii_c0_control(ch))
+            return malformed();
+        if (ch != '\\') {
+            builder.append(ch);
+            continue;
+        }
+
+        switch (consume()) {
+        case '"':
+            builder.append('"');
+            break;
+        case '\\':
+            builder.append('\\');
+            break;
+        case '/':
+            builder.append('/');
+            break;
+        case 'b':
+            builder.append('\b');
+            break;
+        case 'f':
+            builder.append('\f');
+            break;
+        case 'n':
+            builder.append('\n');
+            break;
+        case 'r':
+            builder.append('\r');
+            break;
+        case 't':
+            builder.append('\t');
+            break;
+        case 'u': {
+            auto code_point = decode_single_or_paired_surrogate();
+            if (code_point.is_error())
+                return malformed();
+            builder.append_code_point(code_point.value());
+            break;
+        }
+        default:
+            return malformed();
+        }
+    }
+
+    return Variant<StringView, String> { builder.to_string_without_validation() };
+}
+
 // 25.5.1 JSON.parse ( text [ , reviver ] ), https://tc39.es/ecma262/#sec-json.parse
 JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 {
@@ -450,18 +773,13 @@ JS_DEFINE_NATIVE_FUNCTION(JSONObject::parse)
 // 25.5.1.1 ParseJSON ( text ), https://tc39.es/ecma262/#sec-ParseJSON
 ThrowCompletionOr<Value> JSONObject::parse_json(VM& vm, StringView text)
 {
-    auto json = JsonValue::from_string(text);
-
     // 1. If StringToCodePoints(text) is not a valid JSON text as specified in ECMA-404, throw a SyntaxError exception.
-    if (json.is_error())
-        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
-
     // 2. Let scriptString be the string-concatenation of "(", text, and ");".
     // 3. Let script be ParseText(scriptString, Script).
     // 4. NOTE: The early error rules defined in 13.2.5.1 have special handling for the above invocation of ParseText.
     // 5. Assert: script is a Parse Node.
     // 6. Let result be ! Evaluation of script.
-    auto result = JSONObject::parse_json_value(vm, json.value());
+    auto result = TRY(JSONParser::parse(vm, text));
 
     // 7. NOTE: The PropertyDefinitionEvaluation semantics defined in 13.2.5.5 have special handling for the above evaluation.
     // 8. Assert: result is either a String, a Number, a Boolean, an Object that is defined by either an ArrayLiteral or an ObjectLiteral, or null.
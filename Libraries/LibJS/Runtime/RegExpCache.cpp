@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/RegExpCache.h>
+
+namespace JS {
+
+RegExpCache::RegExpCache(size_t capacity_in_bytes)
+    : m_entries(capacity_in_bytes)
+{
+}
+
+RegExpCache::~RegExpCache() = default;
+
+Optional<Regex<ECMA262>> RegExpCache::get(String const& pattern, regex::RegexOptions<ECMAScriptFlags> flags)
+{
+    auto* parser_result = m_entries.get({ pattern, to_underlying(flags.value()) });
+    if (!parser_result)
+        return {};
+    return Regex<ECMA262>(Regex<ECMA262>::OptimizedParseResult {}, *parser_result, pattern.to_byte_string(), flags);
+}
+
+void RegExpCache::set(String const& pattern, regex::RegexOptions<ECMAScriptFlags> flags, Regex<ECMA262> const& regex)
+{
+    VERIFY(regex.parser_result.error == regex::Error::NoError);
+
+    // NOTE: The bytecode makes up most of the memory of a parse result, and is what we'd have to build again.
+    auto size_in_bytes = pattern.bytes().size() + regex.parser_result.bytecode.size() * sizeof(regex::ByteCodeValueType);
+    m_entries.set({ pattern, to_underlying(flags.value()) }, regex.parser_result, size_in_bytes);
+}
+
+void RegExpCache::clear()
+{
+    m_entries.clear();
+}
+
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/LRUCache.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibRegex/Regex.h>
+
+namespace JS {
+
+// Keeps the bytecode of recently compiled regular expressions around, so that RegExp objects created from the same
+// pattern and flags again (e.g. a regex literal in a loop, or `new RegExp(...)` in an event handler) can skip parsing
+// and optimizing the pattern.
+class RegExpCache {
+    AK_MAKE_NONCOPYABLE(RegExpCache);
+    AK_MAKE_NONMOVABLE(RegExpCache);
+
+public:
+    explicit RegExpCache(size_t capacity_in_bytes);
+    ~RegExpCache();
+
+    // The pattern is the one LibRegex parses, i.e. after parse_regex_pattern().
+    Optional<Regex<ECMA262>> get(String const& pattern, regex::RegexOptions<ECMAScriptFlags>);
+    void set(String const& pattern, regex::RegexOptions<ECMAScriptFlags>, Regex<ECMA262> const&);
+
+    void clear();
+
+    size_t size_in_bytes() const { return m_entries.cost(); }
+    size_t hit_count() const { return m_entries.hit_count(); }
+    size_t miss_count() const { return m_entries.miss_count(); }
+
+private:
+    struct Key {
+        String pattern;
+        u32 flags { 0 };
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct KeyTraits : DefaultTraits<Key> {
+        static unsigned hash(Key const& key) { return pair_int_hash(key.pattern.hash(), key.flags); }
+    };
+
+    LRUCache<Key, regex::Parser::Result, KeyTraits> m_entries;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/RegExpCache.h>
 #include <LibJS/Runtime/RegExpConstructor.h>
 #include <LibJS/Runtime/RegExpObject.h>
 #include <LibJS/Runtime/StringPrototype.h>
@@ -236,13 +237,20 @@ ThrowCompletionOr<GC::Ref<RegExpObject>> RegExpObject::regexp_initialize(VM& vm,
         parsed_pattern = TRY(parse_regex_pattern(vm, pattern, unicode, unicode_sets));
     }
 
-    // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
-    Regex<ECMA262> regex(parsed_pattern.to_byte_string(), parsed_flags);
-    if (regex.parser_result.error != regex::Error::NoError)
-        return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex.error_string());
+    // NOTE: Only patterns that compiled without errors are cached.
+    auto& regexp_cache = vm.regexp_cache();
+    auto regex = regexp_cache.get(parsed_pattern, parsed_flags);
+    if (!regex.has_value()) {
+        // 14. If parseResult is a non-empty List of SyntaxError objects, throw a SyntaxError exception.
+        regex = Regex<ECMA262>(parsed_pattern.to_byte_string(), parsed_flags);
+        if (regex->parser_result.error != regex::Error::NoError)
+            return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, regex->error_string());
+
+        regexp_cache.set(parsed_pattern, parsed_flags, *regex);
+    }
 
     // 15. Assert: parseResult is a Pattern Parse Node.
-    VERIFY(regex.parser_result.error == regex::Error::NoError);
+    VERIFY(regex->parser_result.error == regex::Error::NoError);
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
@@ -255,7 +263,7 @@ ThrowCompletionOr<GC::Ref<RegExpObject>> RegExpObject::regexp_initialize(VM& vm,
     // 19. Let rer be the RegExp Record { [[IgnoreCase]]: i, [[Multiline]]: m, [[DotAll]]: s, [[Unicode]]: u, [[CapturingGroupsCount]]: capturingGroupsCount }.
     // 20. Set obj.[[RegExpRecord]] to rer.
     // 21. Set obj.[[RegExpMatcher]] to CompilePattern of parseResult with argument rer.
-    m_regex = move(regex);
+    m_regex = regex.release_value();
 
     // 22. Perform ? Set(obj, "lastIndex", +0𝔽, true).
     TRY(set(vm.names.lastIndex, Value(0), Object::ShouldThrowExceptions::Yes));
@@ -16,6 +16,7 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibJS/AST.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/ProgramCache.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -29,6 +30,7 @@
 #include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/RegExpCache.h>
 #include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/Temporal/Instant.h>
 #include <LibJS/Runtime/VM.h>
@@ -70,6 +72,7 @@ VM::VM(ErrorMessages error_messages)
     , m_error_messages(move(error_messages))
 {
     m_bytecode_interpreter = make<Bytecode::Interpreter>(*this);
+    m_regexp_cache = make<RegExpCache>(1 * MiB);
 
     m_empty_string = m_heap.allocate<PrimitiveString>(String {});
 
@@ -271,6 +274,34 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
         roots.set(job, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
 }
 
+void VM::enable_program_cache(size_t capacity_in_bytes)
+{
+    m_program_cache = make<ProgramCache>(capacity_in_bytes);
+}
+
+void VM::set_precise_execution_context_rooting_enabled(bool enabled)
+{
+    if (!enabled) {
+        m_heap.set_gather_precisely_rooted_stack_ranges(nullptr);
+        return;
+    }
+
+    // NOTE: Only contexts that are on an execution context stack are visited by gather_roots(). Ones that have been
+    //       allocated but not pushed yet may already hold values, and are left for the conservative scan.
+    m_heap.set_gather_precisely_rooted_stack_ranges([this](Vector<GC::Heap::StackRange>& ranges) {
+        auto add_ranges = [&](Vector<ExecutionContext*> const& stack) {
+            for (auto* execution_context : stack) {
+                auto start = bit_cast<FlatPtr>(execution_context);
+                auto size = sizeof(ExecutionContext) + execution_context->registers_and_constants_and_locals_and_arguments_span().size() * sizeof(Value);
+                ranges.append({ start, start + size });
+            }
+        };
+        add_ranges(m_execution_context_stack);
+        for (auto& saved_stack : m_saved_execution_context_stacks)
+            add_ranges(saved_stack);
+    });
+}
+
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
 ThrowCompletionOr<Reference> VM::get_identifier_reference(Environment* environment, FlyString name, bool strict, size_t hops)
 {
@@ -59,6 +59,17 @@ public:
 
     void gather_roots(HashMap<GC::Cell*, GC::HeapRoot>&);
 
+    // Execution contexts on the native stack are rooted precisely through the execution context stack. With this
+    // enabled, the heap doesn't scan them for possible pointers on top of that.
+    void set_precise_execution_context_rooting_enabled(bool);
+
+    // Scripts and modules parsed from the same source again reuse their earlier program when this is enabled.
+    ProgramCache* program_cache() { return m_program_cache.ptr(); }
+    void enable_program_cache(size_t capacity_in_bytes);
+
+    // RegExp objects created from a pattern and flags that were compiled before reuse the bytecode from back then.
+    RegExpCache& regexp_cache() { return *m_regexp_cache; }
+
 #define __JS_ENUMERATE(SymbolName, snake_name)             \
     GC::Ref<Symbol> well_known_symbol_##snake_name() const \
     {                                                      \
@@ -354,6 +365,11 @@ private:
 
     OwnPtr<Bytecode::Interpreter> m_bytecode_interpreter;
 
+    // NOTE: Programs hold on to the executables of their functions, so this has to go before the heap does.
+    OwnPtr<ProgramCache> m_program_cache;
+
+    OwnPtr<RegExpCache> m_regexp_cache;
+
     bool m_dynamic_imports_allowed { false };
 };
 
@@ -702,6 +702,9 @@ struct Formatter<JS::Value> : Formatter<StringView> {
     }
 };
 
+// NOTE: Values are copied around a lot, so they are kept trivially copyable, and aren't seen by the write barrier.
+static_assert(IsTriviallyCopyable<JS::Value>);
+
 template<>
 struct Traits<JS::Value> : DefaultTraits<JS::Value> {
     static unsigned hash(JS::Value value) { return Traits<u64>::hash(value.encoded()); }
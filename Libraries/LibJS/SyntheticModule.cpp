@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Utf8View.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Completion.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
@@ -55,6 +56,10 @@ ThrowCompletionOr<GC::Ref<Module>> parse_json_module(Realm& realm, StringView so
 {
     auto& vm = realm.vm();
 
+    // NOTE: ParseJSON takes strings without escape sequences from the source as they are, so it must be valid UTF-8.
+    if (!Utf8View { source_text }.validate())
+        return vm.throw_completion<SyntaxError>(ErrorType::JsonMalformed);
+
     // 1. Let json be ? ParseJSON(source).
     auto json = TRY(JSONObject::parse_json(vm, source_text));
 
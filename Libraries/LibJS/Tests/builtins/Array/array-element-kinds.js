@@ -0,0 +1,81 @@
+describe("arrays whose elements change kind", () => {
+    test("storing a double or an object in an array of integers", () => {
+        const array = [1, 2, 3];
+        array[1] = 2.5;
+        expect(array).toEqual([1, 2.5, 3]);
+        array[2] = "three";
+        expect(array).toEqual([1, 2.5, "three"]);
+        expect(array.indexOf("three")).toBe(2);
+        expect(array.indexOf(2.5)).toBe(1);
+    });
+
+    test("holes are looked up on the prototype chain", () => {
+        const array = [1, 2, 3];
+        delete array[1];
+        Array.prototype[1] = 42;
+        try {
+            expect(array.indexOf(42)).toBe(1);
+            const seen = [];
+            array.forEach(value => seen.push(value));
+            expect(seen).toEqual([1, 42, 3]);
+        } finally {
+            delete Array.prototype[1];
+        }
+        expect(array.map(value => value * 2)).toEqual([2, , 6]);
+    });
+
+    test("storing past the end leaves holes", () => {
+        const array = [1, 2];
+        array[4] = 5;
+        expect(array.indexOf(undefined)).toBe(-1);
+        expect(Object.keys(array)).toEqual(["0", "1", "4"]);
+    });
+
+    test("emptied arrays can hold integers again", () => {
+        const array = ["a", "b"];
+        array.length = 0;
+        array.push(3, 1, 2);
+        expect(array.sort()).toEqual([1, 2, 3]);
+        expect(array.indexOf(2)).toBe(1);
+    });
+});
+
+describe("fast paths for packed arrays", () => {
+    test("indexOf compares numbers strictly", () => {
+        expect([1, 2, 3].indexOf(2.0)).toBe(1);
+        expect([1, 2, 3].indexOf("2")).toBe(-1);
+        expect([0, 1].indexOf(-0)).toBe(0);
+        expect([-0, 1.5].indexOf(0)).toBe(0);
+        expect([NaN, 1.5].indexOf(NaN)).toBe(-1);
+        expect([1.5, 2.5, 3.5].indexOf(2.5, -2)).toBe(1);
+        expect([1, 2, 3].indexOf(1, 1)).toBe(-1);
+    });
+
+    test("forEach and map see changes made by the callback", () => {
+        const array = [1, 2, 3, 4];
+        const seen = [];
+        array.forEach((value, index) => {
+            seen.push(value);
+            if (index === 0) {
+                array[1] = "changed";
+                array.length = 3;
+            }
+        });
+        expect(seen).toEqual([1, "changed", 3]);
+
+        const other = [1, 2, 3];
+        const mapped = other.map((value, index) => {
+            if (index === 0) other.pop();
+            return value * 10;
+        });
+        expect(mapped).toEqual([10, 20, ,]);
+        expect(mapped).toHaveLength(3);
+    });
+
+    test("sort compares integers as strings by default", () => {
+        expect([10, 9, 1, -1, -10, 100, 0].sort()).toEqual([-1, -10, 0, 1, 10, 100, 9]);
+        expect([2147483647, -2147483648, 5].sort()).toEqual([-2147483648, 2147483647, 5]);
+        expect([3, 1.5, 2, undefined, 10].sort()).toEqual([1.5, 10, 2, 3, undefined]);
+        expect([3, 1, 2].sort((a, b) => b - a)).toEqual([3, 2, 1]);
+    });
+});
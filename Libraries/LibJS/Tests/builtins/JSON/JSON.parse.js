@@ -74,3 +74,51 @@ test("does not truncate large integers", () => {
     expect(JSON.parse("18446744073709551616")).toEqual(18446744073709551616);
     expect(JSON.parse("18446744073709551617")).toEqual(18446744073709551617);
 });
+
+test("escape sequences", () => {
+    expect(JSON.parse('"a\\"b\\\\c\\/d"')).toBe('a"b\\c/d');
+    expect(JSON.parse('"\\b\\f\\n\\r\\t"')).toBe("\b\f\n\r\t");
+    expect(JSON.parse('"\\u0041\\u00e9\\ud83d\\ude00"')).toBe("Aé😀");
+    expect(JSON.parse('{"k\\u0065y":1}')).toEqual({ key: 1 });
+
+    ['"\\x41"', '"\\u12"', '"a\nb"', '"unterminated'].forEach(testCase => {
+        expect(() => JSON.parse(testCase)).toThrow(SyntaxError);
+    });
+});
+
+test("number syntax", () => {
+    expect(JSON.parse("0")).toBe(0);
+    expect(JSON.parse("1.5e3")).toBe(1500);
+    expect(JSON.parse("-2E-2")).toBe(-0.02);
+    expect(JSON.parse("1e400")).toBe(Infinity);
+
+    ["01", "-", "1.", ".5", "1e", "1e+", "+1", "0x10"].forEach(testCase => {
+        expect(() => JSON.parse(testCase)).toThrow(SyntaxError);
+    });
+});
+
+test("arrays of records", () => {
+    const records = JSON.parse('[{"id":1,"name":"a"},{"id":2,"name":"b"},{"name":"c","id":3}]');
+    expect(records).toHaveLength(3);
+    expect(Object.keys(records[0])).toEqual(["id", "name"]);
+    expect(Object.keys(records[2])).toEqual(["name", "id"]);
+    expect(records[1].name).toBe("b");
+    expect(records[2].id).toBe(3);
+
+    const nested = JSON.parse("[[1,[2,[3]]],[],[4]]");
+    expect(nested).toEqual([[1, [2, [3]]], [], [4]]);
+    expect(nested[1]).toHaveLength(0);
+});
+
+test("duplicate keys keep the first position and the last value", () => {
+    const object = JSON.parse('{"a":1,"b":2,"a":3}');
+    expect(Object.keys(object)).toEqual(["a", "b"]);
+    expect(object.a).toBe(3);
+});
+
+test("integer keys and __proto__", () => {
+    const object = JSON.parse('{"1":"one","0":"zero","__proto__":null}');
+    expect(Object.keys(object)).toEqual(["0", "1", "__proto__"]);
+    expect(Object.getPrototypeOf(object)).toBe(Object.prototype);
+    expect(Object.hasOwn(object, "__proto__")).toBeTrue();
+});
@@ -0,0 +1,592 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashFunctions.h>
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
+#include <LibRegex/RegexLazyDFA.h>
+
+namespace regex {
+
+static constexpr size_t MaxMemoryUsage = 2 * MiB;
+static constexpr size_t MaxFlushesPerSearch = 4;
+static constexpr size_t MaxClosureSteps = 100'000;
+static constexpr size_t MaxCheckpoints = 64;
+
+static constexpr u32 MatchedBeforeBit = 1u << 31;
+
+static constexpr u64 AtBeginFlag = 1 << 0;
+static constexpr u64 PreviousIsWordFlag = 1 << 1;
+static constexpr u64 UnanchoredFlag = 1 << 2;
+
+static bool is_word_character(u32 code_unit)
+{
+    return is_ascii_alphanumeric(code_unit) || code_unit == '_';
+}
+
+unsigned LazyDFA::ThreadTraits::hash(Thread const& thread)
+{
+    unsigned hash = 0;
+    for (auto word : thread)
+        hash = pair_int_hash(hash, u64_hash(word));
+    return hash;
+}
+
+unsigned LazyDFA::StateKeyTraits::hash(Vector<u64> const& key)
+{
+    unsigned hash = 0;
+    for (auto word : key)
+        hash = pair_int_hash(hash, u64_hash(word));
+    return hash;
+}
+
+u32 LazyDFA::instruction_index_of(Thread const& thread)
+{
+    return thread[0] >> 32;
+}
+
+u32 LazyDFA::string_offset_of(Thread const& thread)
+{
+    return thread[0] & 0xffffffff;
+}
+
+void LazyDFA::set_position(Thread& thread, u32 instruction_index, u32 string_offset)
+{
+    thread[0] = (static_cast<u64>(instruction_index) << 32) | string_offset;
+}
+
+OwnPtr<LazyDFA> LazyDFA::try_create(ByteCode const& bytecode)
+{
+    auto dfa = adopt_own(*new LazyDFA);
+    if (!dfa->build(bytecode))
+        return nullptr;
+    return dfa;
+}
+
+LazyDFA::~LazyDFA() = default;
+
+bool LazyDFA::build(ByteCode const& bytecode)
+{
+    auto state = MatchState::only_for_enumeration();
+
+    HashMap<size_t, u32> instruction_indices;
+    Vector<size_t> positions;
+    for (state.instruction_position = 0; state.instruction_position < bytecode.size();) {
+        auto& opcode = bytecode.get_opcode(state);
+        instruction_indices.set(state.instruction_position, positions.size());
+        positions.append(state.instruction_position);
+        state.instruction_position += opcode.size();
+    }
+
+    // Anything at or past the end of the bytecode is where the backtracker reports success.
+    u32 accept_index = positions.size();
+    auto resolve = [&](ssize_t position) -> Optional<u32> {
+        if (position < 0)
+            return {};
+        if (static_cast<size_t>(position) >= bytecode.size())
+            return accept_index;
+        return instruction_indices.get(position);
+    };
+
+    HashMap<u64, u32> checkpoint_bits;
+    auto checkpoint_bit = [&](u64 id) -> Optional<u32> {
+        if (auto bit = checkpoint_bits.get(id); bit.has_value())
+            return bit;
+        if (checkpoint_bits.size() == MaxCheckpoints)
+            return {};
+        u32 bit = checkpoint_bits.size();
+        checkpoint_bits.set(id, bit);
+        return bit;
+    };
+
+    HashMap<u64, u32> repetition_marks;
+    auto repetition_mark = [&](u64 id) -> u32 {
+        return repetition_marks.ensure(id, [&] { return static_cast<u32>(repetition_marks.size()); });
+    };
+
+    m_instructions.ensure_capacity(positions.size());
+    for (auto position : positions) {
+        state.instruction_position = position;
+        auto& opcode = bytecode.get_opcode(state);
+        auto next_position = static_cast<ssize_t>(position + opcode.size());
+
+        Instruction instruction;
+        instruction.position = position;
+        instruction.next = resolve(next_position).value();
+
+        auto set_target = [&](ssize_t target_position) {
+            auto target = resolve(target_position);
+            if (!target.has_value())
+                return false;
+            instruction.target = *target;
+            return true;
+        };
+
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto const& compare = static_cast<OpCode_Compare const&>(opcode);
+            for (auto const& pair : compare.flat_compares()) {
+                if (pair.type == CharacterCompareType::Reference)
+                    return false;
+            }
+
+            if (compare.arguments_count() == 1 && static_cast<CharacterCompareType>(bytecode.at(position + 3)) == CharacterCompareType::String) {
+                auto length = bytecode.at(position + 4);
+                if (length == 0) {
+                    instruction.kind = Instruction::Kind::Jump;
+                    instruction.target = instruction.next;
+                    break;
+                }
+
+                // Strings are compared one code unit at a time, which only lines up with the backtracker for ASCII.
+                Vector<u32> string;
+                string.ensure_capacity(length);
+                for (size_t i = 0; i < length; ++i) {
+                    auto ch = bytecode.at(position + 5 + i);
+                    if (ch > 0x7f)
+                        return false;
+                    string.unchecked_append(ch);
+                }
+
+                instruction.kind = Instruction::Kind::String;
+                instruction.id = m_strings.size();
+                m_strings.append(move(string));
+                m_has_string_compares = true;
+                break;
+            }
+
+            instruction.kind = Instruction::Kind::Compare;
+            break;
+        }
+        case OpCodeId::Jump:
+            instruction.kind = Instruction::Kind::Jump;
+            if (!set_target(next_position + static_cast<OpCode_Jump const&>(opcode).offset()))
+                return false;
+            break;
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkReplaceJump:
+            // NOTE: Replacing forks only prune threads the backtracker would have tried, so they are treated as plain forks.
+            instruction.kind = Instruction::Kind::Fork;
+            if (!set_target(next_position + static_cast<OpCode_ForkJump const&>(opcode).offset()))
+                return false;
+            break;
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceStay:
+            instruction.kind = Instruction::Kind::Fork;
+            if (!set_target(next_position + static_cast<OpCode_ForkStay const&>(opcode).offset()))
+                return false;
+            break;
+        case OpCodeId::JumpNonEmpty: {
+            auto const& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+            auto form = jump.form();
+            if (form != OpCodeId::Jump && form != OpCodeId::ForkJump && form != OpCodeId::ForkStay && form != OpCodeId::ForkReplaceJump && form != OpCodeId::ForkReplaceStay)
+                return false;
+            auto bit = checkpoint_bit(jump.checkpoint());
+            if (!bit.has_value() || !set_target(next_position + jump.offset()))
+                return false;
+            instruction.kind = Instruction::Kind::JumpNonEmpty;
+            instruction.id = *bit;
+            instruction.is_jump_only = form == OpCodeId::Jump;
+            break;
+        }
+        case OpCodeId::Checkpoint: {
+            auto bit = checkpoint_bit(static_cast<OpCode_Checkpoint const&>(opcode).id());
+            if (!bit.has_value())
+                return false;
+            instruction.kind = Instruction::Kind::Checkpoint;
+            instruction.id = *bit;
+            break;
+        }
+        case OpCodeId::Repeat: {
+            auto const& repeat = static_cast<OpCode_Repeat const&>(opcode);
+            if (repeat.count() == 0 || !set_target(static_cast<ssize_t>(position) - static_cast<ssize_t>(repeat.offset())))
+                return false;
+            instruction.kind = Instruction::Kind::Repeat;
+            instruction.id = repetition_mark(repeat.id());
+            instruction.count = repeat.count();
+            break;
+        }
+        case OpCodeId::ResetRepeat:
+            instruction.kind = Instruction::Kind::ResetRepeat;
+            instruction.id = repetition_mark(static_cast<OpCode_ResetRepeat const&>(opcode).id());
+            break;
+        case OpCodeId::CheckBegin:
+            instruction.kind = Instruction::Kind::CheckBegin;
+            break;
+        case OpCodeId::CheckEnd:
+            instruction.kind = Instruction::Kind::CheckEnd;
+            break;
+        case OpCodeId::CheckBoundary:
+            instruction.kind = Instruction::Kind::CheckBoundary;
+            instruction.is_negated = static_cast<OpCode_CheckBoundary const&>(opcode).type() == BoundaryCheckType::NonWord;
+            break;
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+            // Captures don't decide whether there is a match.
+            instruction.kind = Instruction::Kind::Jump;
+            instruction.target = instruction.next;
+            break;
+        case OpCodeId::Exit:
+            instruction.kind = Instruction::Kind::Fail;
+            break;
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::FailForks:
+        case OpCodeId::PopSaved:
+            // Lookaround moves back and forth in the input, which a DFA can't follow.
+            return false;
+        }
+
+        m_instructions.unchecked_append(instruction);
+    }
+
+    m_repetition_mark_count = repetition_marks.size();
+    m_thread_width = 3 + m_repetition_mark_count;
+    return true;
+}
+
+bool LazyDFA::can_search(AllOptions options) const
+{
+    // Unicode mode steps over code points rather than code units, and the line based options make anchors depend on
+    // more than the position in the input.
+    if (options.has_flag_set(AllFlags::Unicode) || options.has_flag_set(AllFlags::UnicodeSets))
+        return false;
+    if (options.has_flag_set(AllFlags::Multiline) || options.has_flag_set(AllFlags::MatchNotBeginOfLine) || options.has_flag_set(AllFlags::MatchNotEndOfLine))
+        return false;
+    if (m_has_string_compares && options.has_flag_set(AllFlags::Insensitive))
+        return false;
+    return true;
+}
+
+LazyDFA::Thread LazyDFA::start_thread() const
+{
+    Thread thread;
+    thread.resize(m_thread_width);
+    return thread;
+}
+
+bool LazyDFA::compute_closure(ReadonlySpan<u64> key, Context const& context, Vector<Thread>& consumers, bool& reaches_accept) const
+{
+    HashTable<Thread, ThreadTraits> seen_threads;
+    Vector<Thread> threads_to_visit;
+    for (size_t offset = 1; offset < key.size(); offset += m_thread_width) {
+        Thread thread;
+        thread.append(key.slice(offset, m_thread_width).data(), m_thread_width);
+        threads_to_visit.append(move(thread));
+    }
+
+    size_t steps = 0;
+    while (!threads_to_visit.is_empty()) {
+        auto thread = threads_to_visit.take_last();
+        if (seen_threads.set(thread) != HashSetResult::InsertedNewEntry)
+            continue;
+        if (++steps > MaxClosureSteps)
+            return false;
+
+        auto index = instruction_index_of(thread);
+        if (index == m_instructions.size()) {
+            reaches_accept = true;
+            continue;
+        }
+
+        auto const& instruction = m_instructions[index];
+        auto go_to = [&](u32 target) {
+            auto next_thread = thread;
+            set_position(next_thread, target);
+            threads_to_visit.append(move(next_thread));
+        };
+
+        switch (instruction.kind) {
+        case Instruction::Kind::Compare:
+        case Instruction::Kind::String:
+            consumers.append(move(thread));
+            break;
+        case Instruction::Kind::Jump:
+            go_to(instruction.target);
+            break;
+        case Instruction::Kind::Fork:
+            go_to(instruction.next);
+            go_to(instruction.target);
+            break;
+        case Instruction::Kind::CheckBegin:
+            if (context.at_begin)
+                go_to(instruction.next);
+            break;
+        case Instruction::Kind::CheckEnd:
+            if (context.next_is_end)
+                go_to(instruction.next);
+            break;
+        case Instruction::Kind::CheckBoundary: {
+            bool is_boundary = context.previous_is_word != context.next_is_word;
+            if (is_boundary != instruction.is_negated)
+                go_to(instruction.next);
+            break;
+        }
+        case Instruction::Kind::Checkpoint: {
+            u64 bit = 1ull << instruction.id;
+            thread[1] |= bit;
+            thread[2] &= ~bit;
+            go_to(instruction.next);
+            break;
+        }
+        case Instruction::Kind::JumpNonEmpty: {
+            // The backtracker only loops again if something was consumed since the checkpoint, and otherwise only
+            // carries on at the end of the input. A checkpoint that was never passed may hold any position from an
+            // earlier attempt, so both are possible then.
+            u64 bit = 1ull << instruction.id;
+            bool is_passed = thread[1] & bit;
+            bool has_consumed = thread[2] & bit;
+            if (!is_passed || has_consumed) {
+                go_to(instruction.target);
+                if (!instruction.is_jump_only)
+                    go_to(instruction.next);
+            }
+            if ((!is_passed || !has_consumed) && context.next_is_end)
+                go_to(instruction.next);
+            break;
+        }
+        case Instruction::Kind::Repeat: {
+            auto& mark = thread[3 + instruction.id];
+            if (mark == instruction.count - 1) {
+                mark = 0;
+                go_to(instruction.next);
+            } else {
+                ++mark;
+                go_to(instruction.target);
+            }
+            break;
+        }
+        case Instruction::Kind::ResetRepeat:
+            thread[3 + instruction.id] = 0;
+            go_to(instruction.next);
+            break;
+        case Instruction::Kind::Fail:
+            break;
+        }
+    }
+    return true;
+}
+
+Optional<bool> LazyDFA::compare_matches(ByteCode const& bytecode, MatchInput const& input, Instruction const& instruction, size_t position)
+{
+    auto& state = m_compare_state;
+    state.instruction_position = instruction.position;
+    state.string_position = position;
+    state.string_position_in_code_units = position;
+
+    auto& opcode = bytecode.get_opcode(state);
+    auto result = opcode.execute(input, state);
+    if (result == ExecutionResult::Failed || result == ExecutionResult::Failed_ExecuteLowPrioForks)
+        return false;
+    if (result == ExecutionResult::Continue && state.string_position == position + 1 && state.string_position_in_code_units == position + 1)
+        return true;
+
+    // Compares that don't consume exactly one code unit can't be described by a transition on one.
+    return {};
+}
+
+Optional<u32> LazyDFA::compute_transition(ByteCode const& bytecode, MatchInput const& input, u32 state_index, size_t position, u32 code_unit)
+{
+    // NOTE: This is a copy, as interning the next state may flush the cache.
+    auto key = m_states[state_index]->key;
+    auto flags = key[0];
+
+    Context context {
+        .at_begin = (flags & AtBeginFlag) != 0,
+        .previous_is_word = (flags & PreviousIsWordFlag) != 0,
+        .next_is_end = false,
+        .next_is_word = is_word_character(code_unit),
+    };
+
+    Vector<Thread> consumers;
+    bool reaches_accept = false;
+    if (!compute_closure(key, context, consumers, reaches_accept))
+        return {};
+
+    Vector<Thread> next_threads;
+    for (auto& thread : consumers) {
+        auto index = instruction_index_of(thread);
+        auto const& instruction = m_instructions[index];
+
+        if (instruction.kind == Instruction::Kind::String) {
+            auto const& string = m_strings[instruction.id];
+            auto offset = string_offset_of(thread);
+            if (string[offset] != code_unit)
+                continue;
+            if (offset + 1 == string.size())
+                set_position(thread, instruction.next);
+            else
+                set_position(thread, index, offset + 1);
+        } else {
+            auto matches = compare_matches(bytecode, input, instruction, position);
+            if (!matches.has_value())
+                return {};
+            if (!*matches)
+                continue;
+            set_position(thread, instruction.next);
+        }
+
+        // Every checkpoint that was passed has now seen something being consumed.
+        thread[2] = thread[1];
+        next_threads.append(move(thread));
+    }
+
+    if (flags & UnanchoredFlag)
+        next_threads.append(start_thread());
+
+    quick_sort(next_threads, [](Thread const& a, Thread const& b) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i])
+                return a[i] < b[i];
+        }
+        return false;
+    });
+
+    Vector<u64> next_key;
+    next_key.ensure_capacity(1 + next_threads.size() * m_thread_width);
+    next_key.append((flags & UnanchoredFlag) | (context.next_is_word ? PreviousIsWordFlag : 0));
+    for (size_t i = 0; i < next_threads.size(); ++i) {
+        if (i > 0 && next_threads[i] == next_threads[i - 1])
+            continue;
+        next_key.append(next_threads[i].data(), m_thread_width);
+    }
+
+    auto generation = m_generation;
+    auto next_index = intern_state(move(next_key));
+    if (!next_index.has_value())
+        return {};
+
+    u32 transition = (*next_index + 1) | (reaches_accept ? MatchedBeforeBit : 0);
+    if (generation == m_generation) {
+        auto& state = *m_states[state_index];
+        if (code_unit < state.ascii_transitions.size()) {
+            state.ascii_transitions[code_unit] = transition;
+        } else {
+            state.other_transitions.set(code_unit, transition);
+            m_memory_usage += 2 * sizeof(u32);
+        }
+    }
+    return transition;
+}
+
+Optional<u32> LazyDFA::intern_state(Vector<u64> key)
+{
+    if (auto index = m_state_indices.get(key); index.has_value())
+        return *index;
+
+    // The key is kept both by the state and by the index.
+    auto state_size = sizeof(State) + 2 * key.size() * sizeof(u64);
+    if (m_memory_usage + state_size > MaxMemoryUsage) {
+        if (++m_flushes_in_current_search > MaxFlushesPerSearch)
+            return {};
+        clear_states();
+    }
+
+    auto state = make<State>();
+    state->key = key;
+    state->is_dead = key.size() == 1 && !(key[0] & UnanchoredFlag);
+
+    u32 index = m_states.size();
+    m_state_indices.set(move(key), index);
+    m_states.append(move(state));
+    m_memory_usage += state_size;
+    return index;
+}
+
+void LazyDFA::clear_states()
+{
+    m_states.clear();
+    m_state_indices.clear();
+    m_memory_usage = 0;
+    ++m_generation;
+}
+
+Optional<bool> LazyDFA::has_match(ByteCode const& bytecode, MatchInput const& input, size_t start_position, SearchKind kind)
+{
+    if (!can_search(input.regex_options))
+        return {};
+
+    // The outcome of a compare may depend on these, so the cached transitions are only good for one combination.
+    u32 compare_flags = 0;
+    for (auto flag : { AllFlags::Insensitive, AllFlags::SingleLine, AllFlags::Internal_ConsiderNewline, AllFlags::Internal_ECMA262DotSemantics }) {
+        if (input.regex_options.has_flag_set(flag))
+            compare_flags |= to_underlying(flag);
+    }
+    if (m_compare_flags != compare_flags) {
+        clear_states();
+        m_compare_flags = compare_flags;
+    }
+
+    m_flushes_in_current_search = 0;
+
+    auto const& view = input.view;
+    auto length = view.length_in_code_units();
+    if (start_position > length)
+        return false;
+
+    u64 flags = kind == SearchKind::Unanchored ? UnanchoredFlag : 0;
+    if (start_position == 0)
+        flags |= AtBeginFlag;
+    else if (is_word_character(view.code_unit_at(start_position - 1)))
+        flags |= PreviousIsWordFlag;
+
+    Vector<u64> start_key;
+    start_key.append(flags);
+    start_key.append(start_thread().data(), m_thread_width);
+    auto start_index = intern_state(move(start_key));
+    if (!start_index.has_value())
+        return {};
+
+    auto state_index = *start_index;
+    for (size_t position = start_position; position < length; ++position) {
+        auto& state = *m_states[state_index];
+        if (state.is_dead)
+            return false;
+
+        auto code_unit = view.code_unit_at(position);
+
+        // Lone and paired surrogates are looked at as code points by some compares, which one code unit can't tell.
+        if (is_unicode_surrogate(code_unit))
+            return {};
+
+        u32 transition = code_unit < state.ascii_transitions.size()
+            ? state.ascii_transitions[code_unit]
+            : state.other_transitions.get(code_unit).value_or(0);
+        if (transition == 0) {
+            auto computed_transition = compute_transition(bytecode, input, state_index, position, code_unit);
+            if (!computed_transition.has_value())
+                return {};
+            transition = *computed_transition;
+        }
+
+        if (transition & MatchedBeforeBit)
+            return true;
+        state_index = (transition & ~MatchedBeforeBit) - 1;
+    }
+
+    auto& state = *m_states[state_index];
+    if (state.match_at_end == State::MatchAtEnd::Unknown) {
+        Context context {
+            .at_begin = (state.key[0] & AtBeginFlag) != 0,
+            .previous_is_word = (state.key[0] & PreviousIsWordFlag) != 0,
+            .next_is_end = true,
+            .next_is_word = false,
+        };
+
+        Vector<Thread> consumers;
+        bool reaches_accept = false;
+        if (!compute_closure(state.key, context, consumers, reaches_accept))
+            return {};
+        state.match_at_end = reaches_accept ? State::MatchAtEnd::Yes : State::MatchAtEnd::No;
+    }
+    return state.match_at_end == State::MatchAtEnd::Yes;
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A DFA that is built from the bytecode of a pattern one state at a time, as the inputs it runs on ask for them.
+// It only tells whether there is a match at all, but does so in time linear to the length of the input, which lets the
+// matcher skip backtracking through inputs that can't match. Where a match is and what its groups captured is still
+// left to the backtracker.
+class REGEX_API LazyDFA {
+    AK_MAKE_NONCOPYABLE(LazyDFA);
+    AK_MAKE_NONMOVABLE(LazyDFA);
+
+public:
+    // Returns null if the pattern uses something a DFA can't express, like backreferences or lookaround.
+    static OwnPtr<LazyDFA> try_create(ByteCode const&);
+
+    ~LazyDFA();
+
+    enum class SearchKind {
+        Anchored,   // Only look for matches that start at the start position.
+        Unanchored, // Look for matches that start anywhere at or after the start position.
+    };
+
+    // Returns an empty Optional if the DFA had to give up, e.g. because the input needed too many states, in which
+    // case the caller has to find out by backtracking. The bytecode must be the one the DFA was created from.
+    Optional<bool> has_match(ByteCode const&, MatchInput const&, size_t start_position, SearchKind);
+
+private:
+    LazyDFA() = default;
+
+    struct Instruction {
+        enum class Kind : u8 {
+            Compare,
+            String,
+            Jump,
+            Fork,
+            CheckBegin,
+            CheckEnd,
+            CheckBoundary,
+            Checkpoint,
+            JumpNonEmpty,
+            Repeat,
+            ResetRepeat,
+            Fail,
+        };
+
+        Kind kind { Kind::Fail };
+        size_t position { 0 };
+        u32 next { 0 };
+        u32 target { 0 };
+        u32 id { 0 };
+        u64 count { 0 };
+        bool is_negated { false };   // For CheckBoundary.
+        bool is_jump_only { false }; // For JumpNonEmpty.
+    };
+
+    // A thread is the position in the program plus the bits of backtracker state that decide where it can go from
+    // there: [instruction index << 32 | offset into a string compare, checkpoints passed, checkpoints passed and
+    // consumed since, repetition marks...].
+    using Thread = Vector<u64, 8>;
+
+    struct ThreadTraits : DefaultTraits<Thread> {
+        static unsigned hash(Thread const&);
+    };
+
+    struct StateKeyTraits : DefaultTraits<Vector<u64>> {
+        static unsigned hash(Vector<u64> const&);
+    };
+
+    // A state is a flags word followed by its sorted threads, before any epsilon transitions were taken. Which of
+    // those can be taken depends on the code unit that comes next, so the closure is computed per transition.
+    struct State {
+        Vector<u64> key;
+        bool is_dead { false };
+
+        // Zero means the transition has not been computed yet, otherwise it is the index of the next state plus one,
+        // with the top bit set if a match ended right before the code unit.
+        Array<u32, 128> ascii_transitions {};
+        HashMap<u32, u32> other_transitions;
+
+        enum class MatchAtEnd : u8 {
+            Unknown,
+            No,
+            Yes,
+        };
+        MatchAtEnd match_at_end { MatchAtEnd::Unknown };
+    };
+
+    struct Context {
+        bool at_begin { false };
+        bool previous_is_word { false };
+        bool next_is_end { false };
+        bool next_is_word { false };
+    };
+
+    static u32 instruction_index_of(Thread const&);
+    static u32 string_offset_of(Thread const&);
+    static void set_position(Thread&, u32 instruction_index, u32 string_offset = 0);
+
+    bool build(ByteCode const&);
+    bool can_search(AllOptions) const;
+
+    Thread start_thread() const;
+    bool compute_closure(ReadonlySpan<u64> key, Context const&, Vector<Thread>& consumers, bool& reaches_accept) const;
+    Optional<bool> compare_matches(ByteCode const&, MatchInput const&, Instruction const&, size_t position);
+    Optional<u32> compute_transition(ByteCode const&, MatchInput const&, u32 state_index, size_t position, u32 code_unit);
+    Optional<u32> intern_state(Vector<u64> key);
+    void clear_states();
+
+    Vector<Instruction> m_instructions;
+    Vector<Vector<u32>> m_strings;
+    size_t m_repetition_mark_count { 0 };
+    size_t m_thread_width { 3 };
+    bool m_has_string_compares { false };
+
+    Vector<NonnullOwnPtr<State>> m_states;
+    HashMap<Vector<u64>, u32, StateKeyTraits> m_state_indices;
+    size_t m_memory_usage { 0 };
+    size_t m_generation { 0 };
+    size_t m_flushes_in_current_search { 0 };
+    Optional<u32> m_compare_flags;
+    MatchState m_compare_state { MatchState::only_for_enumeration() };
+};
+
+}
@@ -4,10 +4,14 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
+#include <AK/Array.h>
 #include <AK/BinarySearch.h>
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
@@ -95,6 +99,15 @@ Regex<Parser>::Regex(regex::Parser::Result parse_result, ByteString pattern, typ
         matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parser_result.options.value()));
 }
 
+template<class Parser>
+Regex<Parser>::Regex(OptimizedParseResult, regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options)
+    : pattern_value(move(pattern))
+    , parser_result(move(parse_result))
+{
+    if (parser_result.error == regex::Error::NoError)
+        matcher = make<Matcher<Parser>>(this, regex_options | static_cast<decltype(regex_options.value())>(parser_result.options.value()));
+}
+
 template<class Parser>
 Regex<Parser>::Regex(Regex&& regex)
     : pattern_value(move(regex.pattern_value))
@@ -140,6 +153,233 @@ ByteString Regex<Parser>::error_string(Optional<ByteString> message) const
     return eb.to_byte_string();
 }
 
+// NOTE: The helpers below pass vectors around by value, which GCC warns about for targets that may lack AVX. They are
+//       local to this translation unit and always inlined, so the calling convention doesn't matter.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// Finds where a match may start in searches that aren't anchored, by looking at a vector's worth of code units at a time
+// instead of one. If the whole pattern is a literal string, that is what it looks for, otherwise it looks for the
+// characters the pattern can start with.
+class MatchStartScanner {
+public:
+    static Optional<MatchStartScanner> create(regex::Parser::Result const& parser_result, AllOptions options)
+    {
+        // Unicode mode counts positions in code points, which don't line up with the code units we look at.
+        if (options.has_flag_set(AllFlags::Unicode) || options.has_flag_set(AllFlags::UnicodeSets))
+            return {};
+
+        MatchStartScanner scanner;
+        auto insensitive = options.has_flag_set(AllFlags::Insensitive);
+        auto const& optimization_data = parser_result.optimization_data;
+
+        if (auto const& literal = optimization_data.pure_substring_search; literal.has_value() && !literal->is_empty() && !insensitive) {
+            if (all_of(literal->bytes(), [](u8 byte) { return is_ascii(byte); })) {
+                scanner.m_literal = literal->bytes();
+                return scanner;
+            }
+        }
+
+        if (optimization_data.starting_ranges.is_empty())
+            return {};
+
+        for (auto const& range : optimization_data.starting_ranges) {
+            if (!scanner.try_append_range(range.from, range.to))
+                return {};
+
+            // The matcher compares both the upper and the lower case version of the input against the ranges.
+            if (insensitive) {
+                auto append_case_range = [&](u32 from, u32 to, i32 delta) {
+                    auto clipped_from = max(range.from, from);
+                    auto clipped_to = min(range.to, to);
+                    if (clipped_from > clipped_to)
+                        return true;
+                    return scanner.try_append_range(clipped_from + delta, clipped_to + delta);
+                };
+                if (!append_case_range('a', 'z', 'A' - 'a') || !append_case_range('A', 'Z', 'a' - 'A'))
+                    return {};
+            }
+        }
+        return scanner;
+    }
+
+    // Returns the length of the view if no match can start at or after the start position.
+    size_t find_next_candidate(RegexStringView const& view, size_t start_position) const
+    {
+        if (view.is_u16_view())
+            return find_next_candidate(view.u16_view().span(), start_position);
+        return find_next_candidate(view.string_view().bytes(), start_position);
+    }
+
+private:
+    static constexpr size_t MaxRanges = 8;
+
+    MatchStartScanner() = default;
+
+    bool try_append_range(u32 from, u32 to)
+    {
+        if (m_range_count == MaxRanges)
+            return false;
+        m_ranges[m_range_count++] = { from, to };
+        return true;
+    }
+
+    template<typename CodeUnit>
+    size_t find_next_candidate(ReadonlySpan<CodeUnit> code_units, size_t start_position) const
+    {
+        if (!m_literal.is_empty())
+            return find_literal(code_units, start_position);
+        return find_first_in_ranges(code_units, start_position);
+    }
+
+    template<typename CodeUnit>
+    using VectorFor = Conditional<IsSame<CodeUnit, u8>, AK::SIMD::u8x32, AK::SIMD::u16x16>;
+
+    template<typename VectorType, typename CodeUnit>
+    ALWAYS_INLINE static VectorType splat(CodeUnit value)
+    {
+        VectorType vector {};
+        for (size_t i = 0; i < AK::SIMD::vector_length<VectorType>; ++i)
+            vector[i] = value;
+        return vector;
+    }
+
+    template<typename VectorType, typename CodeUnit>
+    ALWAYS_INLINE static VectorType load(CodeUnit const* code_units)
+    {
+        VectorType vector;
+        __builtin_memcpy(&vector, code_units, sizeof(vector));
+        return vector;
+    }
+
+    template<typename MaskType>
+    ALWAYS_INLINE static bool any_lane_set(MaskType const& mask)
+    {
+        u64 words[sizeof(MaskType) / sizeof(u64)];
+        __builtin_memcpy(words, &mask, sizeof(mask));
+        u64 any = 0;
+        for (auto word : words)
+            any |= word;
+        return any != 0;
+    }
+
+    template<typename CodeUnit>
+    size_t find_first_in_ranges(ReadonlySpan<CodeUnit> code_units, size_t start_position) const
+    {
+        using VectorType = VectorFor<CodeUnit>;
+        constexpr size_t lanes = AK::SIMD::vector_length<VectorType>;
+        constexpr u32 max_code_unit = NumericLimits<CodeUnit>::max();
+
+        // A code unit is in a range if subtracting the start of the range leaves it no larger than the range's width.
+        Array<VectorType, MaxRanges> range_starts;
+        Array<VectorType, MaxRanges> range_widths;
+        size_t range_count = 0;
+        for (size_t i = 0; i < m_range_count; ++i) {
+            auto const& range = m_ranges[i];
+            if (range.from > max_code_unit)
+                continue;
+            auto to = min(range.to, max_code_unit);
+            range_starts[range_count] = splat<VectorType>(static_cast<CodeUnit>(range.from));
+            range_widths[range_count] = splat<VectorType>(static_cast<CodeUnit>(to - range.from));
+            ++range_count;
+        }
+        if (range_count == 0)
+            return code_units.size();
+
+        auto is_in_ranges = [&](CodeUnit code_unit) {
+            for (size_t i = 0; i < m_range_count; ++i) {
+                if (code_unit >= m_ranges[i].from && code_unit <= m_ranges[i].to)
+                    return true;
+            }
+            return false;
+        };
+
+        size_t position = start_position;
+        for (; position + lanes <= code_units.size(); position += lanes) {
+            auto block = load<VectorType>(code_units.data() + position);
+            auto matches = (block - range_starts[0]) <= range_widths[0];
+            for (size_t i = 1; i < range_count; ++i)
+                matches |= (block - range_starts[i]) <= range_widths[i];
+            if (!any_lane_set(matches))
+                continue;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                if (matches[lane])
+                    return position + lane;
+            }
+        }
+
+        for (; position < code_units.size(); ++position) {
+            if (is_in_ranges(code_units[position]))
+                return position;
+        }
+        return code_units.size();
+    }
+
+    template<typename CodeUnit>
+    size_t find_literal(ReadonlySpan<CodeUnit> code_units, size_t start_position) const
+    {
+        using VectorType = VectorFor<CodeUnit>;
+        constexpr size_t lanes = AK::SIMD::vector_length<VectorType>;
+
+        auto literal_length = m_literal.size();
+        if (start_position + literal_length > code_units.size())
+            return code_units.size();
+        auto last_start_position = code_units.size() - literal_length;
+
+        auto matches_at = [&](size_t position) {
+            for (size_t i = 0; i < literal_length; ++i) {
+                if (code_units[position + i] != m_literal[i])
+                    return false;
+            }
+            return true;
+        };
+
+        // Candidates have to agree with both the first and the last character of the literal, which rules out far
+        // more positions than looking at the first one alone.
+        auto first = splat<VectorType>(static_cast<CodeUnit>(m_literal.first()));
+        auto last = splat<VectorType>(static_cast<CodeUnit>(m_literal.last()));
+
+        size_t position = start_position;
+        for (; position + lanes <= last_start_position + 1; position += lanes) {
+            auto first_block = load<VectorType>(code_units.data() + position);
+            auto last_block = load<VectorType>(code_units.data() + position + literal_length - 1);
+            auto matches = (first_block == first) & (last_block == last);
+            if (!any_lane_set(matches))
+                continue;
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                if (matches[lane] && matches_at(position + lane))
+                    return position + lane;
+            }
+        }
+
+        for (; position <= last_start_position; ++position) {
+            if (matches_at(position))
+                return position;
+        }
+        return code_units.size();
+    }
+
+    struct Range {
+        u32 from { 0 };
+        u32 to { 0 };
+    };
+    Array<Range, MaxRanges> m_ranges {};
+    size_t m_range_count { 0 };
+    ReadonlyBytes m_literal;
+};
+
+#pragma GCC diagnostic pop
+
+template<class Parser>
+LazyDFA* Matcher<Parser>::lazy_dfa() const
+{
+    if (!m_lazy_dfa_initialized) {
+        m_lazy_dfa = LazyDFA::try_create(m_pattern->parser_result.bytecode);
+        m_lazy_dfa_initialized = true;
+    }
+    return m_lazy_dfa.ptr();
+}
+
 template<typename Parser>
 RegexResult Matcher<Parser>::match(RegexStringView view, Optional<typename ParserTraits<Parser>::OptionsType> regex_options) const
 {
@@ -209,6 +449,23 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
     auto only_start_of_line = m_pattern->parser_result.optimization_data.only_start_of_line && !input.regex_options.has_flag_set(AllFlags::Multiline);
 
+    // The DFA tells whether a match exists in linear time, which spares us backtracking through inputs that can't match.
+    auto* lazy_dfa = this->lazy_dfa();
+    auto lazy_dfa_rules_out_match = [&](size_t start_position, LazyDFA::SearchKind kind) {
+        if (!lazy_dfa)
+            return false;
+        auto result = lazy_dfa->has_match(m_pattern->parser_result.bytecode, input, start_position, kind);
+        if (!result.has_value()) {
+            // If it had to give up once, it would most likely have to give up again on the rest of the input.
+            lazy_dfa = nullptr;
+            return false;
+        }
+        return !*result;
+    };
+    auto lazy_dfa_search_kind = continue_search && !only_start_of_line ? LazyDFA::SearchKind::Unanchored : LazyDFA::SearchKind::Anchored;
+
+    auto start_scanner = continue_search && !only_start_of_line ? MatchStartScanner::create(m_pattern->parser_result, input.regex_options) : Optional<MatchStartScanner> {};
+
     auto compare_range = [insensitive = input.regex_options & AllFlags::Insensitive](auto needle, CharRange range) {
         auto upper_case_needle = needle;
         auto lower_case_needle = needle;
@@ -240,8 +497,9 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         state.string_position = view_index;
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
+        bool can_match = view_index > view_length || !lazy_dfa_rules_out_match(view_index, lazy_dfa_search_kind);
 
-        if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
+        if (can_match && view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
             // e.g. "Exit"
@@ -270,7 +528,13 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             }
         }
 
-        for (; view_index <= view_length; ++view_index) {
+        for (; can_match && view_index <= view_length; ++view_index) {
+            if (start_scanner.has_value()) {
+                view_index = start_scanner->find_next_candidate(input.view, view_index);
+                if (view_index == view_length)
+                    break;
+            }
+
             if (view_index == view_length) {
                 if (input.regex_options.has_flag_set(AllFlags::Multiline))
                     break;
@@ -291,6 +555,10 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
                     goto done_matching;
             }
 
+            // A match somewhere later in the input doesn't mean one starts here, and finding that out by backtracking may take forever.
+            if (lazy_dfa_search_kind == LazyDFA::SearchKind::Unanchored && lazy_dfa_rules_out_match(view_index, LazyDFA::SearchKind::Anchored))
+                goto done_matching;
+
             input.column = match_count;
             input.match_index = match_count;
 
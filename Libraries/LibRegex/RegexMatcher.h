@@ -7,6 +7,7 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexLazyDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
@@ -72,9 +73,14 @@ public:
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    LazyDFA* lazy_dfa() const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    // Built on first use, most patterns are only matched a handful of times.
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
+    mutable bool m_lazy_dfa_initialized { false };
 };
 
 template<class Parser>
@@ -89,6 +95,10 @@ public:
 
     explicit Regex(ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     Regex(regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
+
+    // Takes the parser_result of an existing Regex, which has already been through the optimization passes.
+    struct OptimizedParseResult { };
+    Regex(OptimizedParseResult, regex::Parser::Result parse_result, ByteString pattern, typename ParserTraits<Parser>::OptionsType regex_options = {});
     ~Regex() = default;
     Regex(Regex&&);
     Regex& operator=(Regex&&);
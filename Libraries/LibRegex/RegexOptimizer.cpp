@@ -33,8 +33,10 @@ void Regex<Parser>::run_optimization_passes()
     rewrite_with_useless_jumps_removed();
 
     auto blocks = split_basic_blocks(parser_result.bytecode);
-    if (attempt_rewrite_entire_match_as_substring_search(blocks))
+    if (attempt_rewrite_entire_match_as_substring_search(blocks)) {
+        fill_optimization_data(blocks);
         return;
+    }
 
     // Rewrite fork loops as atomic groups
     // e.g. a*b -> (ATOMIC a*)b
@@ -213,7 +215,19 @@ void Regex<Parser>::fill_optimization_data(BasicBlockList const& blocks)
         auto& opcode = bytecode.get_opcode(state);
         switch (opcode.opcode_id()) {
         case OpCodeId::Compare: {
-            auto flat_compares = static_cast<OpCode_Compare const&>(opcode).flat_compares();
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+
+            // A match that starts with a string can only start where its first character is.
+            if (compare.arguments_count() == 1 && static_cast<CharacterCompareType>(bytecode.at(state.instruction_position + 3)) == CharacterCompareType::String) {
+                auto length = bytecode.at(state.instruction_position + 4);
+                auto first_character = length > 0 ? bytecode.at(state.instruction_position + 5) : 0;
+                if (length > 0 && first_character <= 0x7f) {
+                    parser_result.optimization_data.starting_ranges.append({ static_cast<u32>(first_character), static_cast<u32>(first_character) });
+                    return;
+                }
+            }
+
+            auto flat_compares = compare.flat_compares();
             StaticallyInterpretedCompares compares;
             if (!interpret_compares(flat_compares, compares))
                 return; // No idea, the bytecode is too complex.
@@ -824,6 +838,9 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
         switch (opcode.opcode_id()) {
         case OpCodeId::Compare: {
             auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            // Several arguments make up a character class, not a sequence of characters.
+            if (compare.arguments_count() != 1)
+                return false;
             for (auto& flat_compare : compare.flat_compares()) {
                 if (flat_compare.type != CharacterCompareType::Char)
                     return false;
@@ -14,14 +14,14 @@
 
 namespace Wasm {
 
-Optional<FunctionAddress> Store::allocate(ModuleInstance& instance, Module const& module, CodeSection::Code const& code, TypeIndex type_index)
+Optional<FunctionAddress> Store::allocate(ModuleInstance& instance, Module const& module, CodeSection::Code const& code, TypeIndex type_index, Optional<size_t> stack_usage)
 {
     FunctionAddress address { m_functions.size() };
     if (type_index.value() >= instance.types().size())
         return {};
 
     auto& type = instance.types()[type_index.value()];
-    m_functions.empend(WasmFunction { type, instance, module, code });
+    m_functions.empend(WasmFunction { type, instance, module, code, stack_usage });
     return address;
 }
 
@@ -231,7 +231,7 @@ InstantiationResult AbstractMachine::instantiate(Module const& module, Vector<Ex
     size_t i = 0;
     for (auto& code : module.code_section().functions()) {
         auto type_index = module.function_section().types()[i];
-        auto address = m_store.allocate(main_module_instance, module, code, type_index);
+        auto address = m_store.allocate(main_module_instance, module, code, type_index, module.function_stack_usage(i));
         VERIFY(address.has_value());
         auxiliary_instance.functions().append(*address);
         module_functions.append(*address);
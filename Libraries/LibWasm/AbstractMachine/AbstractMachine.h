@@ -13,6 +13,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/StackInfo.h>
 #include <AK/UFixedBigInt.h>
+#include <LibWasm/AbstractMachine/CompiledExpression.h>
 #include <LibWasm/Types.h>
 
 namespace Wasm {
@@ -332,17 +333,19 @@ private:
 
 class WasmFunction {
 public:
-    explicit WasmFunction(FunctionType const& type, ModuleInstance const& instance, Module const& module, CodeSection::Code const& code)
+    explicit WasmFunction(FunctionType const& type, ModuleInstance const& instance, Module const& module, CodeSection::Code const& code, Optional<size_t> stack_usage)
         : m_type(type)
         , m_module(module.make_weak_ptr())
         , m_module_instance(instance)
         , m_code(code)
+        , m_compiled_expression(CompiledExpression::compile(code.func().body(), stack_usage, instance))
     {
     }
 
     auto& type() const { return m_type; }
     auto& module() const { return m_module_instance; }
     auto& code() const { return m_code; }
+    auto compiled_expression() const { return m_compiled_expression.ptr(); }
     RefPtr<Module const> module_ref() const { return m_module.strong_ref(); }
 
 private:
@@ -350,6 +353,7 @@ private:
     WeakPtr<Module const> m_module;
     ModuleInstance const& m_module_instance;
     CodeSection::Code const& m_code;
+    RefPtr<CompiledExpression const> m_compiled_expression;
 };
 
 class HostFunction {
@@ -548,7 +552,7 @@ class Store {
 public:
     Store() = default;
 
-    Optional<FunctionAddress> allocate(ModuleInstance&, Module const&, CodeSection::Code const&, TypeIndex);
+    Optional<FunctionAddress> allocate(ModuleInstance&, Module const&, CodeSection::Code const&, TypeIndex, Optional<size_t> stack_usage);
     Optional<FunctionAddress> allocate(HostFunction&&);
     Optional<TableAddress> allocate(TableType const&);
     Optional<MemoryAddress> allocate(MemoryType const&);
@@ -594,10 +598,11 @@ private:
 
 class Frame {
 public:
-    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity)
+    explicit Frame(ModuleInstance const& module, Vector<Value> locals, Expression const& expression, size_t arity, CompiledExpression const* compiled_expression = nullptr)
         : m_module(module)
         , m_locals(move(locals))
         , m_expression(expression)
+        , m_compiled_expression(compiled_expression)
         , m_arity(arity)
     {
     }
@@ -606,6 +611,7 @@ public:
     auto& locals() const { return m_locals; }
     auto& locals() { return m_locals; }
     auto& expression() const { return m_expression; }
+    auto compiled_expression() const { return m_compiled_expression; }
     auto arity() const { return m_arity; }
     auto label_index() const { return m_label_index; }
     auto& label_index() { return m_label_index; }
@@ -614,6 +620,7 @@ private:
     ModuleInstance const& m_module;
     Vector<Value> m_locals;
     Expression const& m_expression;
+    CompiledExpression const* m_compiled_expression { nullptr };
     size_t m_arity { 0 };
     size_t m_label_index { 0 };
 };
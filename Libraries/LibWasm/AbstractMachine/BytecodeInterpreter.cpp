@@ -30,9 +30,48 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
+// Wasm memory is little-endian and has no alignment guarantees, so accesses go through a (usually elided) memcpy.
+template<typename T>
+ALWAYS_INLINE static T read_little_endian(u8 const* data)
+{
+    if constexpr (IsSame<T, float>) {
+        return bit_cast<float>(read_little_endian<u32>(data));
+    } else if constexpr (IsSame<T, double>) {
+        return bit_cast<double>(read_little_endian<u64>(data));
+    } else {
+        T value;
+        __builtin_memcpy(&value, data, sizeof(T));
+        return AK::convert_between_host_and_little_endian(value);
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE static void write_little_endian(u8* data, T value)
+{
+    if constexpr (IsSame<T, float>) {
+        write_little_endian(data, bit_cast<u32>(value));
+    } else if constexpr (IsSame<T, double>) {
+        write_little_endian(data, bit_cast<u64>(value));
+    } else {
+        value = AK::convert_between_host_and_little_endian(value);
+        __builtin_memcpy(data, &value, sizeof(T));
+    }
+}
+
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
+
+    // Function bodies are pre-decoded when their module is instantiated; only expressions that aren't function bodies
+    // still go through the generic loop below.
+    if (auto const* compiled_expression = configuration.frame().compiled_expression()) {
+        if (configuration.should_limit_instruction_count())
+            interpret_compiled<true>(configuration, *compiled_expression);
+        else
+            interpret_compiled<false>(configuration, *compiled_expression);
+        return;
+    }
+
     auto& instructions = configuration.frame().expression().instructions();
     auto max_ip_value = InstructionPointer { instructions.size() };
     auto& current_ip_value = configuration.ip();
@@ -71,20 +110,24 @@ void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelInd
 template<typename ReadType, typename PushType>
 void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction const& instruction)
 {
-    auto& arg = instruction.arguments().get<Instruction::MemoryArgument>();
+    load_and_push<ReadType, PushType>(configuration, instruction.arguments().get<Instruction::MemoryArgument>());
+}
+
+template<typename ReadType, typename PushType>
+void BytecodeInterpreter::load_and_push(Configuration& configuration, Instruction::MemoryArgument const& arg)
+{
     auto& address = configuration.frame().module().memories()[arg.memory_index.value()];
     auto memory = configuration.store().get(address);
     auto& entry = configuration.value_stack().last();
-    auto base = entry.to<i32>();
-    u64 instance_address = static_cast<u64>(bit_cast<u32>(base)) + arg.offset;
-    if (instance_address + sizeof(ReadType) > memory->size()) {
+    // Both the base and the offset are 32-bit, so this can't overflow.
+    u64 instance_address = static_cast<u64>(entry.to<u32>()) + arg.offset;
+    if (instance_address + sizeof(ReadType) > memory->size()) [[unlikely]] {
         m_trap = Trap::from_string("Memory access out of bounds");
         dbgln_if(WASM_TRACE_DEBUG, "LibWasm: Memory access out of bounds (expected {} to be less than or equal to {})", instance_address + sizeof(ReadType), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "load({} : {}) -> stack", instance_address, sizeof(ReadType));
-    auto slice = memory->data().bytes().slice(instance_address, sizeof(ReadType));
-    entry = Value(static_cast<PushType>(read_value<ReadType>(slice)));
+    entry = Value(static_cast<PushType>(read_little_endian<ReadType>(memory->data().data() + instance_address)));
 }
 
 template<typename TDst, typename TSrc>
@@ -300,45 +343,27 @@ void BytecodeInterpreter::unary_operation(Configuration& configuration, Args&&..
     entry = Value(result);
 }
 
-template<typename T>
-struct ConvertToRaw {
-    T operator()(T value)
-    {
-        return LittleEndian<T>(value);
-    }
-};
-
-template<>
-struct ConvertToRaw<float> {
-    u32 operator()(float value)
-    {
-        ReadonlyBytes bytes { &value, sizeof(float) };
-        FixedMemoryStream stream { bytes };
-        auto res = stream.read_value<LittleEndian<u32>>().release_value_but_fixme_should_propagate_errors();
-        return static_cast<u32>(res);
-    }
-};
-
-template<>
-struct ConvertToRaw<double> {
-    u64 operator()(double value)
-    {
-        ReadonlyBytes bytes { &value, sizeof(double) };
-        FixedMemoryStream stream { bytes };
-        auto res = stream.read_value<LittleEndian<u64>>().release_value_but_fixme_should_propagate_errors();
-        return static_cast<u64>(res);
-    }
-};
-
 template<typename PopT, typename StoreT>
 void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction const& instruction)
 {
-    auto& memarg = instruction.arguments().get<Instruction::MemoryArgument>();
-    auto entry = configuration.value_stack().take_last();
-    auto value = ConvertToRaw<StoreT> {}(entry.to<PopT>());
-    dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> temporary({}b)", value, sizeof(StoreT));
-    auto base = configuration.value_stack().take_last().to<i32>();
-    store_to_memory(configuration, memarg, { &value, sizeof(StoreT) }, base);
+    pop_and_store<PopT, StoreT>(configuration, instruction.arguments().get<Instruction::MemoryArgument>());
+}
+
+template<typename PopT, typename StoreT>
+void BytecodeInterpreter::pop_and_store(Configuration& configuration, Instruction::MemoryArgument const& memarg)
+{
+    auto value = static_cast<StoreT>(configuration.value_stack().take_last().to<PopT>());
+    auto base = configuration.value_stack().take_last().to<u32>();
+    auto& address = configuration.frame().module().memories()[memarg.memory_index.value()];
+    auto memory = configuration.store().get(address);
+    u64 instance_address = static_cast<u64>(base) + memarg.offset;
+    if (instance_address + sizeof(StoreT) > memory->size()) [[unlikely]] {
+        m_trap = Trap::from_string("Memory access out of bounds");
+        dbgln_if(WASM_TRACE_DEBUG, "LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + sizeof(StoreT), memory->size());
+        return;
+    }
+    dbgln_if(WASM_TRACE_DEBUG, "stack({}) -> store({} : {})", value, instance_address, sizeof(StoreT));
+    write_little_endian(memory->data().data() + instance_address, value);
 }
 
 template<size_t N>
@@ -358,47 +383,24 @@ void BytecodeInterpreter::store_to_memory(Configuration& configuration, Instruct
     u64 instance_address = static_cast<u64>(base) + arg.offset;
     Checked addition { instance_address };
     addition += data.size();
-    if (addition.has_overflow() || addition.value() > memory->size()) {
+    if (addition.has_overflow() || addition.value() > memory->size()) [[unlikely]] {
         m_trap = Trap::from_string("Memory access out of bounds");
         dbgln_if(WASM_TRACE_DEBUG, "LibWasm: Memory access out of bounds (expected 0 <= {} and {} <= {})", instance_address, instance_address + data.size(), memory->size());
         return;
     }
     dbgln_if(WASM_TRACE_DEBUG, "temporary({}b) -> store({})", data.size(), instance_address);
-    data.copy_to(memory->data().bytes().slice(instance_address, data.size()));
+    __builtin_memcpy(memory->data().data() + instance_address, data.data(), data.size());
 }
 
 template<typename T>
 T BytecodeInterpreter::read_value(ReadonlyBytes data)
 {
-    FixedMemoryStream stream { data };
-    auto value_or_error = stream.read_value<LittleEndian<T>>();
-    if (value_or_error.is_error()) {
+    if (data.size() < sizeof(T)) [[unlikely]] {
         dbgln("Read from {} failed", data.data());
         m_trap = Trap::from_string("Read from memory failed");
+        return {};
     }
-    return value_or_error.release_value();
-}
-
-template<>
-float BytecodeInterpreter::read_value<float>(ReadonlyBytes data)
-{
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u32>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap::from_string("Read from memory failed");
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<float>(static_cast<u32>(raw_value));
-}
-
-template<>
-double BytecodeInterpreter::read_value<double>(ReadonlyBytes data)
-{
-    FixedMemoryStream stream { data };
-    auto raw_value_or_error = stream.read_value<LittleEndian<u64>>();
-    if (raw_value_or_error.is_error())
-        m_trap = Trap::from_string("Read from memory failed");
-    auto raw_value = raw_value_or_error.release_value();
-    return bit_cast<double>(static_cast<u64>(raw_value));
+    return read_little_endian<T>(data.data());
 }
 
 ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
@@ -1662,6 +1664,278 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     }
 }
 
+template<bool should_limit_instruction_count>
+void BytecodeInterpreter::interpret_compiled(Configuration& configuration, CompiledExpression const& expression)
+{
+    // Declare a lookup table for computed goto with each of the `handle_*` labels
+    // to avoid the overhead of a switch statement.
+    // This is a GCC extension, but it's also supported by Clang.
+    static void* const dispatch_table[] = {
+#define SET_UP_LABEL(name, ...) &&handle_##name,
+        ENUMERATE_WASM_COMPILED_OPCODES(SET_UP_LABEL)
+#undef SET_UP_LABEL
+#define SET_UP_FUSED_LABELS(name, ...) &&handle_##name##_local_local, &&handle_##name##_local_const,
+        ENUMERATE_WASM_COMPILED_FUSABLE_BINARY_OPERATIONS(SET_UP_FUSED_LABELS)
+#undef SET_UP_FUSED_LABELS
+    };
+
+    // Configuration::call() has reserved enough space for every operand this function can push, so the handlers
+    // below append to the value stack without growing it. The validator worked out how many operands that is.
+
+    auto const* instructions = expression.instructions().data();
+    auto const instruction_count = expression.instructions().size();
+    auto const* branch_table_labels = expression.branch_table_labels().data();
+    auto& value_stack = configuration.value_stack();
+    [[maybe_unused]] auto const value_stack_limit = value_stack.size() + expression.max_stack_height();
+    ASSERT(value_stack_limit <= value_stack.capacity());
+    auto& ip = configuration.ip();
+    [[maybe_unused]] u64 executed_instructions = 0;
+
+    // NOTE: A fused instruction only counts once, which is fine for a limit that only exists to stop runaway code.
+#define DISPATCH()                                                                                                \
+    do {                                                                                                          \
+        if (ip.value() >= instruction_count) [[unlikely]]                                                         \
+            return;                                                                                               \
+        if constexpr (should_limit_instruction_count) {                                                           \
+            if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] { \
+                m_trap = Trap::from_string("Exceeded maximum allowed number of instructions");                    \
+                return;                                                                                           \
+            }                                                                                                     \
+        }                                                                                                         \
+        goto* dispatch_table[to_underlying(instructions[ip.value()].opcode)];                                     \
+    } while (false)
+
+#define DISPATCH_NEXT() \
+    do {                \
+        ++ip;           \
+        DISPATCH();     \
+    } while (false)
+
+#define PUSH(value)                                     \
+    do {                                                \
+        ASSERT(value_stack.size() < value_stack_limit); \
+        value_stack.unchecked_append(value);            \
+    } while (false)
+
+    DISPATCH();
+
+handle_Fallback: {
+    auto old_ip = ip;
+    interpret_instruction(configuration, ip, *instructions[ip.value()].instruction);
+    if (did_trap())
+        return;
+    if (ip == old_ip) // If no jump occurred
+        ++ip;
+    DISPATCH();
+}
+
+handle_Nop:
+    DISPATCH_NEXT();
+
+handle_LocalGet:
+    PUSH(configuration.frame().locals()[instructions[ip.value()].index]);
+    DISPATCH_NEXT();
+
+handle_LocalSet:
+    configuration.frame().locals()[instructions[ip.value()].index] = value_stack.take_last();
+    DISPATCH_NEXT();
+
+handle_LocalTee:
+    configuration.frame().locals()[instructions[ip.value()].index] = value_stack.last();
+    DISPATCH_NEXT();
+
+handle_GlobalGet: {
+    auto address = configuration.frame().module().globals()[instructions[ip.value()].index];
+    PUSH(configuration.store().get(address)->value());
+    DISPATCH_NEXT();
+}
+
+handle_GlobalSet: {
+    auto address = configuration.frame().module().globals()[instructions[ip.value()].index];
+    configuration.store().get(address)->set_value(value_stack.take_last());
+    DISPATCH_NEXT();
+}
+
+handle_Const:
+    PUSH(Value(instructions[ip.value()].value));
+    DISPATCH_NEXT();
+
+handle_Drop:
+    value_stack.take_last();
+    DISPATCH_NEXT();
+
+handle_Select: {
+    auto value = value_stack.take_last().to<i32>();
+    auto rhs = value_stack.take_last();
+    auto& lhs = value_stack.last();
+    lhs = value != 0 ? lhs : rhs;
+    DISPATCH_NEXT();
+}
+
+handle_Block: {
+    auto& instruction = instructions[ip.value()];
+    configuration.label_stack().append(Label(instruction.index, instruction.value, value_stack.size() - instruction.extra));
+    DISPATCH_NEXT();
+}
+
+handle_Loop: {
+    auto& instruction = instructions[ip.value()];
+    configuration.label_stack().append(Label(instruction.index, ip.value() + 1, value_stack.size() - instruction.index));
+    DISPATCH_NEXT();
+}
+
+handle_If: {
+    auto& instruction = instructions[ip.value()];
+    auto end_ip = instruction.value & NumericLimits<u32>::max();
+    auto else_ip = instruction.value >> 32;
+    auto value = value_stack.take_last().to<i32>();
+    auto end_label = Label(instruction.index, end_ip, value_stack.size() - instruction.extra);
+    if (value != 0) {
+        configuration.label_stack().append(end_label);
+        DISPATCH_NEXT();
+    }
+    if (else_ip != 0) {
+        configuration.label_stack().append(end_label);
+        ip = else_ip;
+    } else {
+        ip = end_ip + 1;
+    }
+    DISPATCH();
+}
+
+handle_Else:
+    // Jump to the end label
+    ip = configuration.label_stack().take_last().continuation();
+    DISPATCH();
+
+handle_End:
+    configuration.label_stack().take_last();
+    DISPATCH_NEXT();
+
+handle_Br:
+    branch_to_label(configuration, LabelIndex { instructions[ip.value()].index });
+    DISPATCH();
+
+handle_BrIf:
+    if (value_stack.take_last().to<i32>() == 0)
+        DISPATCH_NEXT();
+    branch_to_label(configuration, LabelIndex { instructions[ip.value()].index });
+    DISPATCH();
+
+handle_BrTable: {
+    auto& instruction = instructions[ip.value()];
+    auto i = value_stack.take_last().to<u32>();
+    // The default label is stored right after the others.
+    auto label = branch_table_labels[instruction.index + min(i, instruction.extra)];
+    branch_to_label(configuration, LabelIndex { label });
+    DISPATCH();
+}
+
+handle_Return:
+    while (configuration.label_stack().size() - 1 != configuration.frame().label_index())
+        configuration.label_stack().take_last();
+    ip = instruction_count;
+    return;
+
+handle_Call: {
+    auto address = configuration.frame().module().functions()[instructions[ip.value()].index];
+    dbgln_if(WASM_TRACE_DEBUG, "call({})", address.value());
+    call_address(configuration, address);
+    if (did_trap())
+        return;
+    DISPATCH_NEXT();
+}
+
+handle_LocalCopy: {
+    auto& instruction = instructions[ip.value()];
+    auto& locals = configuration.frame().locals();
+    locals[instruction.extra] = locals[instruction.index];
+    ip = ip.value() + 2;
+    DISPATCH();
+}
+
+handle_I32AddConstantToLocal: {
+    auto& instruction = instructions[ip.value()];
+    auto& locals = configuration.frame().locals();
+    auto result = Operators::Add {}(locals[instruction.index].to<u32>(), Value(instruction.value).to<u32>());
+    locals[instruction.extra] = Value(static_cast<i32>(result));
+    ip = ip.value() + 4;
+    DISPATCH();
+}
+
+#define HANDLE_FUSED_BINARY_OPERATION(name, PopType, PushType, Operator)                                             \
+    handle_##name##_local_local:                                                                                     \
+    {                                                                                                                \
+        auto& instruction = instructions[ip.value()];                                                                \
+        auto& locals = configuration.frame().locals();                                                               \
+        auto result = Operator {}(locals[instruction.index].to<PopType>(), locals[instruction.extra].to<PopType>()); \
+        PUSH(Value(static_cast<PushType>(result)));                                                                  \
+        ip = ip.value() + 3;                                                                                         \
+        DISPATCH();                                                                                                  \
+    }                                                                                                                \
+    handle_##name##_local_const:                                                                                     \
+    {                                                                                                                \
+        auto& instruction = instructions[ip.value()];                                                                \
+        auto& locals = configuration.frame().locals();                                                               \
+        auto result = Operator {}(locals[instruction.index].to<PopType>(), Value(instruction.value).to<PopType>());  \
+        PUSH(Value(static_cast<PushType>(result)));                                                                  \
+        ip = ip.value() + 3;                                                                                         \
+        DISPATCH();                                                                                                  \
+    }
+    ENUMERATE_WASM_COMPILED_FUSABLE_BINARY_OPERATIONS(HANDLE_FUSED_BINARY_OPERATION)
+#undef HANDLE_FUSED_BINARY_OPERATION
+
+#define HANDLE_BINARY_OPERATION(name, PopType, PushType, Operator)            \
+    handle_##name:                                                            \
+    {                                                                         \
+        binary_numeric_operation<PopType, PushType, Operator>(configuration); \
+        if (did_trap())                                                       \
+            return;                                                           \
+        DISPATCH_NEXT();                                                      \
+    }
+    ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(HANDLE_BINARY_OPERATION)
+#undef HANDLE_BINARY_OPERATION
+
+#define HANDLE_UNARY_OPERATION(name, PopType, PushType, Operator)    \
+    handle_##name:                                                   \
+    {                                                                \
+        unary_operation<PopType, PushType, Operator>(configuration); \
+        if (did_trap())                                              \
+            return;                                                  \
+        DISPATCH_NEXT();                                             \
+    }
+    ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(HANDLE_UNARY_OPERATION)
+#undef HANDLE_UNARY_OPERATION
+
+#define HANDLE_LOAD_OPERATION(name, ReadType, PushType)                                                                            \
+    handle_##name:                                                                                                                 \
+    {                                                                                                                              \
+        auto& instruction = instructions[ip.value()];                                                                              \
+        load_and_push<ReadType, PushType>(configuration, Instruction::MemoryArgument { 0, instruction.index, instruction.extra }); \
+        if (did_trap())                                                                                                            \
+            return;                                                                                                                \
+        DISPATCH_NEXT();                                                                                                           \
+    }
+    ENUMERATE_WASM_COMPILED_LOAD_OPERATIONS(HANDLE_LOAD_OPERATION)
+#undef HANDLE_LOAD_OPERATION
+
+#define HANDLE_STORE_OPERATION(name, PopType, StoreType)                                                                           \
+    handle_##name:                                                                                                                 \
+    {                                                                                                                              \
+        auto& instruction = instructions[ip.value()];                                                                              \
+        pop_and_store<PopType, StoreType>(configuration, Instruction::MemoryArgument { 0, instruction.index, instruction.extra }); \
+        if (did_trap())                                                                                                            \
+            return;                                                                                                                \
+        DISPATCH_NEXT();                                                                                                           \
+    }
+    ENUMERATE_WASM_COMPILED_STORE_OPERATIONS(HANDLE_STORE_OPERATION)
+#undef HANDLE_STORE_OPERATION
+
+#undef PUSH
+#undef DISPATCH_NEXT
+#undef DISPATCH
+}
+
 void DebuggerBytecodeInterpreter::interpret_instruction(Configuration& configuration, InstructionPointer& ip, Instruction const& instruction)
 {
     if (pre_interpret_hook) {
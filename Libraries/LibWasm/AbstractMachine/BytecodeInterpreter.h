@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/StackInfo.h>
+#include <LibWasm/AbstractMachine/CompiledExpression.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Interpreter.h>
 
@@ -54,11 +55,17 @@ struct BytecodeInterpreter : public Interpreter {
 
 protected:
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
+    template<bool should_limit_instruction_count>
+    void interpret_compiled(Configuration&, CompiledExpression const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
     void load_and_push(Configuration&, Instruction const&);
+    template<typename ReadT, typename PushT>
+    void load_and_push(Configuration&, Instruction::MemoryArgument const&);
     template<typename PopT, typename StoreT>
     void pop_and_store(Configuration&, Instruction const&);
+    template<typename PopT, typename StoreT>
+    void pop_and_store(Configuration&, Instruction::MemoryArgument const&);
     template<size_t N>
     void pop_and_store_lane_n(Configuration&, Instruction const&);
     template<size_t M, size_t N, template<typename> typename SetSign>
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NumericLimits.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/AbstractMachine/CompiledExpression.h>
+#include <LibWasm/Opcode.h>
+
+namespace Wasm {
+
+static CompiledOpcode compiled_opcode_for_operation(OpCode opcode)
+{
+    switch (opcode.value()) {
+#define __ENUMERATE_OPERATION(name, ...) \
+    case Instructions::name.value():     \
+        return CompiledOpcode::name;
+        ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_COMPILED_LOAD_OPERATIONS(__ENUMERATE_OPERATION)
+        ENUMERATE_WASM_COMPILED_STORE_OPERATIONS(__ENUMERATE_OPERATION)
+#undef __ENUMERATE_OPERATION
+    default:
+        return CompiledOpcode::Fallback;
+    }
+}
+
+RefPtr<CompiledExpression> CompiledExpression::compile(Expression const& expression, Optional<size_t> stack_usage, ModuleInstance const& module)
+{
+    if (!stack_usage.has_value())
+        return nullptr;
+
+    auto compiled = adopt_ref(*new CompiledExpression(*stack_usage));
+    auto& source_instructions = expression.instructions();
+    compiled->m_instructions.ensure_capacity(source_instructions.size());
+
+    // Resolves the result and parameter arities of a block, so the interpreter doesn't have to look at the module's
+    // types every time it enters one.
+    struct BlockArities {
+        u32 results { 0 };
+        u32 parameters { 0 };
+    };
+    auto block_arities = [&](BlockType const& block_type) -> BlockArities {
+        switch (block_type.kind()) {
+        case BlockType::Empty:
+            return { 0, 0 };
+        case BlockType::Type:
+            return { 1, 0 };
+        case BlockType::Index: {
+            auto& type = module.types()[block_type.type_index().value()];
+            return { static_cast<u32>(type.results().size()), static_cast<u32>(type.parameters().size()) };
+        }
+        }
+        VERIFY_NOT_REACHED();
+    };
+
+    for (auto& instruction : source_instructions) {
+        CompiledInstruction compiled_instruction { .instruction = &instruction };
+
+        switch (instruction.opcode().value()) {
+        case Instructions::nop.value():
+            compiled_instruction.opcode = CompiledOpcode::Nop;
+            break;
+        case Instructions::local_get.value():
+            compiled_instruction.opcode = CompiledOpcode::LocalGet;
+            compiled_instruction.index = instruction.arguments().get<LocalIndex>().value();
+            break;
+        case Instructions::local_set.value():
+            compiled_instruction.opcode = CompiledOpcode::LocalSet;
+            compiled_instruction.index = instruction.arguments().get<LocalIndex>().value();
+            break;
+        case Instructions::local_tee.value():
+            compiled_instruction.opcode = CompiledOpcode::LocalTee;
+            compiled_instruction.index = instruction.arguments().get<LocalIndex>().value();
+            break;
+        case Instructions::global_get.value():
+            compiled_instruction.opcode = CompiledOpcode::GlobalGet;
+            compiled_instruction.index = instruction.arguments().get<GlobalIndex>().value();
+            break;
+        case Instructions::global_set.value():
+            compiled_instruction.opcode = CompiledOpcode::GlobalSet;
+            compiled_instruction.index = instruction.arguments().get<GlobalIndex>().value();
+            break;
+        case Instructions::i32_const.value():
+            compiled_instruction.opcode = CompiledOpcode::Const;
+            compiled_instruction.value = Value(instruction.arguments().get<i32>()).value().low();
+            break;
+        case Instructions::i64_const.value():
+            compiled_instruction.opcode = CompiledOpcode::Const;
+            compiled_instruction.value = Value(instruction.arguments().get<i64>()).value().low();
+            break;
+        case Instructions::f32_const.value():
+            compiled_instruction.opcode = CompiledOpcode::Const;
+            compiled_instruction.value = Value(instruction.arguments().get<float>()).value().low();
+            break;
+        case Instructions::f64_const.value():
+            compiled_instruction.opcode = CompiledOpcode::Const;
+            compiled_instruction.value = Value(instruction.arguments().get<double>()).value().low();
+            break;
+        case Instructions::drop.value():
+            compiled_instruction.opcode = CompiledOpcode::Drop;
+            break;
+        case Instructions::select.value():
+        case Instructions::select_typed.value():
+            compiled_instruction.opcode = CompiledOpcode::Select;
+            break;
+        case Instructions::block.value(): {
+            auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+            auto [arity, parameter_arity] = block_arities(args.block_type);
+            compiled_instruction.opcode = CompiledOpcode::Block;
+            compiled_instruction.index = arity;
+            compiled_instruction.extra = parameter_arity;
+            compiled_instruction.value = args.end_ip.value();
+            break;
+        }
+        case Instructions::loop.value(): {
+            auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+            compiled_instruction.opcode = CompiledOpcode::Loop;
+            compiled_instruction.index = block_arities(args.block_type).parameters;
+            break;
+        }
+        case Instructions::if_.value(): {
+            auto& args = instruction.arguments().get<Instruction::StructuredInstructionArgs>();
+            u64 else_ip = args.else_ip.has_value() ? args.else_ip->value() : 0;
+            // Both targets have to fit in a single immediate; leave pathologically large functions to the slow path.
+            if (args.end_ip.value() > NumericLimits<u32>::max() || else_ip > NumericLimits<u32>::max())
+                break;
+            auto [arity, parameter_arity] = block_arities(args.block_type);
+            compiled_instruction.opcode = CompiledOpcode::If;
+            compiled_instruction.index = arity;
+            compiled_instruction.extra = parameter_arity;
+            compiled_instruction.value = args.end_ip.value() | (else_ip << 32);
+            break;
+        }
+        case Instructions::structured_else.value():
+            compiled_instruction.opcode = CompiledOpcode::Else;
+            break;
+        case Instructions::structured_end.value():
+            compiled_instruction.opcode = CompiledOpcode::End;
+            break;
+        case Instructions::br.value():
+            compiled_instruction.opcode = CompiledOpcode::Br;
+            compiled_instruction.index = instruction.arguments().get<LabelIndex>().value();
+            break;
+        case Instructions::br_if.value():
+            compiled_instruction.opcode = CompiledOpcode::BrIf;
+            compiled_instruction.index = instruction.arguments().get<LabelIndex>().value();
+            break;
+        case Instructions::br_table.value(): {
+            auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+            compiled_instruction.opcode = CompiledOpcode::BrTable;
+            compiled_instruction.index = compiled->m_branch_table_labels.size();
+            compiled_instruction.extra = args.labels.size();
+            for (auto label : args.labels)
+                compiled->m_branch_table_labels.append(label.value());
+            compiled->m_branch_table_labels.append(args.default_.value());
+            break;
+        }
+        case Instructions::return_.value():
+            compiled_instruction.opcode = CompiledOpcode::Return;
+            break;
+        case Instructions::call.value():
+            compiled_instruction.opcode = CompiledOpcode::Call;
+            compiled_instruction.index = instruction.arguments().get<FunctionIndex>().value();
+            break;
+        default:
+            compiled_instruction.opcode = compiled_opcode_for_operation(instruction.opcode());
+            if (auto const* memory_argument = instruction.arguments().get_pointer<Instruction::MemoryArgument>(); memory_argument && compiled_instruction.opcode != CompiledOpcode::Fallback) {
+                compiled_instruction.index = memory_argument->offset;
+                compiled_instruction.extra = memory_argument->memory_index.value();
+            }
+            break;
+        }
+
+        compiled->m_instructions.unchecked_append(compiled_instruction);
+    }
+
+    compiled->fuse_instructions();
+    return compiled;
+}
+
+void CompiledExpression::fuse_instructions()
+{
+    auto& instructions = m_instructions;
+    for (size_t i = 0; i + 1 < instructions.size(); ++i) {
+        auto& first = instructions[i];
+        auto& second = instructions[i + 1];
+        if (first.opcode != CompiledOpcode::LocalGet)
+            continue;
+
+        // local.get a; local.set b
+        if (second.opcode == CompiledOpcode::LocalSet) {
+            first.opcode = CompiledOpcode::LocalCopy;
+            first.extra = second.index;
+            i += 1;
+            continue;
+        }
+
+        if (i + 2 >= instructions.size() || (second.opcode != CompiledOpcode::LocalGet && second.opcode != CompiledOpcode::Const))
+            continue;
+        auto& third = instructions[i + 2];
+
+        // local.get a; i32.const c; i32.add; local.set b
+        if (second.opcode == CompiledOpcode::Const && third.opcode == CompiledOpcode::i32_add
+            && i + 3 < instructions.size() && instructions[i + 3].opcode == CompiledOpcode::LocalSet) {
+            first.opcode = CompiledOpcode::I32AddConstantToLocal;
+            first.extra = instructions[i + 3].index;
+            first.value = second.value;
+            i += 3;
+            continue;
+        }
+
+        // local.get a; (local.get b | const c); binary operation
+        auto is_local_local = second.opcode == CompiledOpcode::LocalGet;
+        switch (third.opcode) {
+#define __ENUMERATE_FUSABLE_OPERATION(name, ...)                                                                 \
+    case CompiledOpcode::name:                                                                                   \
+        first.opcode = is_local_local ? CompiledOpcode::name##_local_local : CompiledOpcode::name##_local_const; \
+        break;
+            ENUMERATE_WASM_COMPILED_FUSABLE_BINARY_OPERATIONS(__ENUMERATE_FUSABLE_OPERATION)
+#undef __ENUMERATE_FUSABLE_OPERATION
+        default:
+            continue;
+        }
+        if (is_local_local)
+            first.extra = second.index;
+        else
+            first.value = second.value;
+        i += 2;
+    }
+}
+
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
+#include <LibWasm/Types.h>
+
+namespace Wasm {
+
+class ModuleInstance;
+
+#define ENUMERATE_WASM_COMPILED_CONTROL_OPCODES(O) \
+    O(Fallback)                                    \
+    O(Nop)                                         \
+    O(LocalGet)                                    \
+    O(LocalSet)                                    \
+    O(LocalTee)                                    \
+    O(GlobalGet)                                   \
+    O(GlobalSet)                                   \
+    O(Const)                                       \
+    O(Drop)                                        \
+    O(Select)                                      \
+    O(Block)                                       \
+    O(Loop)                                        \
+    O(If)                                          \
+    O(Else)                                        \
+    O(End)                                         \
+    O(Br)                                          \
+    O(BrIf)                                        \
+    O(BrTable)                                     \
+    O(Return)                                      \
+    O(Call)                                        \
+    O(LocalCopy)                                   \
+    O(I32AddConstantToLocal)
+
+#define ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(O)       \
+    O(i32_eq, i32, i32, Operators::Equals)                 \
+    O(i32_ne, i32, i32, Operators::NotEquals)              \
+    O(i32_lts, i32, i32, Operators::LessThan)              \
+    O(i32_ltu, u32, i32, Operators::LessThan)              \
+    O(i32_gts, i32, i32, Operators::GreaterThan)           \
+    O(i32_gtu, u32, i32, Operators::GreaterThan)           \
+    O(i32_les, i32, i32, Operators::LessThanOrEquals)      \
+    O(i32_leu, u32, i32, Operators::LessThanOrEquals)      \
+    O(i32_ges, i32, i32, Operators::GreaterThanOrEquals)   \
+    O(i32_geu, u32, i32, Operators::GreaterThanOrEquals)   \
+    O(i64_eq, i64, i32, Operators::Equals)                 \
+    O(i64_ne, i64, i32, Operators::NotEquals)              \
+    O(i64_lts, i64, i32, Operators::LessThan)              \
+    O(i64_ltu, u64, i32, Operators::LessThan)              \
+    O(i64_gts, i64, i32, Operators::GreaterThan)           \
+    O(i64_gtu, u64, i32, Operators::GreaterThan)           \
+    O(i64_les, i64, i32, Operators::LessThanOrEquals)      \
+    O(i64_leu, u64, i32, Operators::LessThanOrEquals)      \
+    O(i64_ges, i64, i32, Operators::GreaterThanOrEquals)   \
+    O(i64_geu, u64, i32, Operators::GreaterThanOrEquals)   \
+    O(f32_eq, float, i32, Operators::Equals)               \
+    O(f32_ne, float, i32, Operators::NotEquals)            \
+    O(f32_lt, float, i32, Operators::LessThan)             \
+    O(f32_gt, float, i32, Operators::GreaterThan)          \
+    O(f32_le, float, i32, Operators::LessThanOrEquals)     \
+    O(f32_ge, float, i32, Operators::GreaterThanOrEquals)  \
+    O(f64_eq, double, i32, Operators::Equals)              \
+    O(f64_ne, double, i32, Operators::NotEquals)           \
+    O(f64_lt, double, i32, Operators::LessThan)            \
+    O(f64_gt, double, i32, Operators::GreaterThan)         \
+    O(f64_le, double, i32, Operators::LessThanOrEquals)    \
+    O(f64_ge, double, i32, Operators::GreaterThanOrEquals) \
+    O(i32_add, u32, i32, Operators::Add)                   \
+    O(i32_sub, u32, i32, Operators::Subtract)              \
+    O(i32_mul, u32, i32, Operators::Multiply)              \
+    O(i32_divs, i32, i32, Operators::Divide)               \
+    O(i32_divu, u32, i32, Operators::Divide)               \
+    O(i32_rems, i32, i32, Operators::Modulo)               \
+    O(i32_remu, u32, i32, Operators::Modulo)               \
+    O(i32_and, i32, i32, Operators::BitAnd)                \
+    O(i32_or, i32, i32, Operators::BitOr)                  \
+    O(i32_xor, i32, i32, Operators::BitXor)                \
+    O(i32_shl, u32, i32, Operators::BitShiftLeft)          \
+    O(i32_shrs, i32, i32, Operators::BitShiftRight)        \
+    O(i32_shru, u32, i32, Operators::BitShiftRight)        \
+    O(i32_rotl, u32, i32, Operators::BitRotateLeft)        \
+    O(i32_rotr, u32, i32, Operators::BitRotateRight)       \
+    O(i64_add, u64, i64, Operators::Add)                   \
+    O(i64_sub, u64, i64, Operators::Subtract)              \
+    O(i64_mul, u64, i64, Operators::Multiply)              \
+    O(i64_divs, i64, i64, Operators::Divide)               \
+    O(i64_divu, u64, i64, Operators::Divide)               \
+    O(i64_rems, i64, i64, Operators::Modulo)               \
+    O(i64_remu, u64, i64, Operators::Modulo)               \
+    O(i64_and, i64, i64, Operators::BitAnd)                \
+    O(i64_or, i64, i64, Operators::BitOr)                  \
+    O(i64_xor, i64, i64, Operators::BitXor)                \
+    O(i64_shl, u64, i64, Operators::BitShiftLeft)          \
+    O(i64_shrs, i64, i64, Operators::BitShiftRight)        \
+    O(i64_shru, u64, i64, Operators::BitShiftRight)        \
+    O(i64_rotl, u64, i64, Operators::BitRotateLeft)        \
+    O(i64_rotr, u64, i64, Operators::BitRotateRight)       \
+    O(f32_add, float, float, Operators::Add)               \
+    O(f32_sub, float, float, Operators::Subtract)          \
+    O(f32_mul, float, float, Operators::Multiply)          \
+    O(f32_div, float, float, Operators::Divide)            \
+    O(f32_min, float, float, Operators::Minimum)           \
+    O(f32_max, float, float, Operators::Maximum)           \
+    O(f32_copysign, float, float, Operators::CopySign)     \
+    O(f64_add, double, double, Operators::Add)             \
+    O(f64_sub, double, double, Operators::Subtract)        \
+    O(f64_mul, double, double, Operators::Multiply)        \
+    O(f64_div, double, double, Operators::Divide)          \
+    O(f64_min, double, double, Operators::Minimum)         \
+    O(f64_max, double, double, Operators::Maximum)         \
+    O(f64_copysign, double, double, Operators::CopySign)
+
+#define ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(O)           \
+    O(i32_eqz, i32, i32, Operators::EqualsZero)               \
+    O(i64_eqz, i64, i32, Operators::EqualsZero)               \
+    O(i32_clz, i32, i32, Operators::CountLeadingZeros)        \
+    O(i32_ctz, i32, i32, Operators::CountTrailingZeros)       \
+    O(i32_popcnt, i32, i32, Operators::PopCount)              \
+    O(i64_clz, i64, i64, Operators::CountLeadingZeros)        \
+    O(i64_ctz, i64, i64, Operators::CountTrailingZeros)       \
+    O(i64_popcnt, i64, i64, Operators::PopCount)              \
+    O(f32_abs, float, float, Operators::Absolute)             \
+    O(f32_neg, float, float, Operators::Negate)               \
+    O(f32_ceil, float, float, Operators::Ceil)                \
+    O(f32_floor, float, float, Operators::Floor)              \
+    O(f32_trunc, float, float, Operators::Truncate)           \
+    O(f32_nearest, float, float, Operators::NearbyIntegral)   \
+    O(f32_sqrt, float, float, Operators::SquareRoot)          \
+    O(f64_abs, double, double, Operators::Absolute)           \
+    O(f64_neg, double, double, Operators::Negate)             \
+    O(f64_ceil, double, double, Operators::Ceil)              \
+    O(f64_floor, double, double, Operators::Floor)            \
+    O(f64_trunc, double, double, Operators::Truncate)         \
+    O(f64_nearest, double, double, Operators::NearbyIntegral) \
+    O(f64_sqrt, double, double, Operators::SquareRoot)        \
+    O(f32_demote_f64, double, float, Operators::Demote)       \
+    O(f64_promote_f32, float, double, Operators::Promote)
+
+#define ENUMERATE_WASM_COMPILED_LOAD_OPERATIONS(O) \
+    O(i32_load, i32, i32)                          \
+    O(i64_load, i64, i64)                          \
+    O(f32_load, float, float)                      \
+    O(f64_load, double, double)                    \
+    O(i32_load8_s, i8, i32)                        \
+    O(i32_load8_u, u8, i32)                        \
+    O(i32_load16_s, i16, i32)                      \
+    O(i32_load16_u, u16, i32)                      \
+    O(i64_load8_s, i8, i64)                        \
+    O(i64_load8_u, u8, i64)                        \
+    O(i64_load16_s, i16, i64)                      \
+    O(i64_load16_u, u16, i64)                      \
+    O(i64_load32_s, i32, i64)                      \
+    O(i64_load32_u, u32, i64)
+
+#define ENUMERATE_WASM_COMPILED_STORE_OPERATIONS(O) \
+    O(i32_store, i32, i32)                          \
+    O(i64_store, i64, i64)                          \
+    O(f32_store, float, float)                      \
+    O(f64_store, double, double)                    \
+    O(i32_store8, i32, i8)                          \
+    O(i32_store16, i32, i16)                        \
+    O(i64_store8, i64, i8)                          \
+    O(i64_store16, i64, i16)                        \
+    O(i64_store32, i64, i32)
+
+// Binary operations that can't trap, and can therefore be fused with the local.get/const instructions feeding them.
+#define ENUMERATE_WASM_COMPILED_FUSABLE_BINARY_OPERATIONS(O) \
+    O(i32_eq, i32, i32, Operators::Equals)                   \
+    O(i32_ne, i32, i32, Operators::NotEquals)                \
+    O(i32_lts, i32, i32, Operators::LessThan)                \
+    O(i32_ltu, u32, i32, Operators::LessThan)                \
+    O(i32_gts, i32, i32, Operators::GreaterThan)             \
+    O(i32_gtu, u32, i32, Operators::GreaterThan)             \
+    O(i32_les, i32, i32, Operators::LessThanOrEquals)        \
+    O(i32_leu, u32, i32, Operators::LessThanOrEquals)        \
+    O(i32_ges, i32, i32, Operators::GreaterThanOrEquals)     \
+    O(i32_geu, u32, i32, Operators::GreaterThanOrEquals)     \
+    O(i32_add, u32, i32, Operators::Add)                     \
+    O(i32_sub, u32, i32, Operators::Subtract)                \
+    O(i32_mul, u32, i32, Operators::Multiply)                \
+    O(i32_and, i32, i32, Operators::BitAnd)                  \
+    O(i32_or, i32, i32, Operators::BitOr)                    \
+    O(i32_xor, i32, i32, Operators::BitXor)                  \
+    O(i32_shl, u32, i32, Operators::BitShiftLeft)            \
+    O(i32_shrs, i32, i32, Operators::BitShiftRight)          \
+    O(i32_shru, u32, i32, Operators::BitShiftRight)          \
+    O(i64_add, u64, i64, Operators::Add)                     \
+    O(i64_sub, u64, i64, Operators::Subtract)                \
+    O(i64_mul, u64, i64, Operators::Multiply)                \
+    O(i64_and, i64, i64, Operators::BitAnd)                  \
+    O(i64_or, i64, i64, Operators::BitOr)                    \
+    O(i64_xor, i64, i64, Operators::BitXor)
+
+#define ENUMERATE_WASM_COMPILED_OPCODES(O)       \
+    ENUMERATE_WASM_COMPILED_CONTROL_OPCODES(O)   \
+    ENUMERATE_WASM_COMPILED_BINARY_OPERATIONS(O) \
+    ENUMERATE_WASM_COMPILED_UNARY_OPERATIONS(O)  \
+    ENUMERATE_WASM_COMPILED_LOAD_OPERATIONS(O)   \
+    ENUMERATE_WASM_COMPILED_STORE_OPERATIONS(O)
+
+enum class CompiledOpcode : u8 {
+#define __ENUMERATE_COMPILED_OPCODE(name, ...) name,
+    ENUMERATE_WASM_COMPILED_OPCODES(__ENUMERATE_COMPILED_OPCODE)
+#undef __ENUMERATE_COMPILED_OPCODE
+#define __ENUMERATE_FUSED_OPCODES(name, ...) name##_local_local, name##_local_const,
+    ENUMERATE_WASM_COMPILED_FUSABLE_BINARY_OPERATIONS(__ENUMERATE_FUSED_OPCODES)
+#undef __ENUMERATE_FUSED_OPCODES
+};
+
+// A pre-decoded instruction. Compiled instructions map 1:1 onto the instructions of the source expression, so
+// instruction pointers, labels and the structured instruction targets computed by the parser stay valid.
+//
+// A fused instruction (a superinstruction) stands in for a short run of instructions and skips over the rest of it;
+// the skipped instructions keep their unfused form. Such runs never contain a branch target, since those always
+// follow a structured instruction.
+struct CompiledInstruction {
+    CompiledOpcode opcode { CompiledOpcode::Fallback };
+
+    // Local, global or function index, label depth, memory offset, block result arity, or br_table label offset.
+    u32 index { 0 };
+
+    // Memory index, block parameter arity, br_table label count, or the second local of a fused instruction.
+    u32 extra { 0 };
+
+    // Raw constant bits, or the end (low half) and else (high half) instruction pointers of a block.
+    u64 value { 0 };
+
+    // The source instruction, used for anything the compiled form doesn't handle itself.
+    Instruction const* instruction { nullptr };
+};
+
+class CompiledExpression : public RefCounted<CompiledExpression> {
+public:
+    // The stack usage is the one the validator found for the expression, as the interpreter relies on it being accurate.
+    // Returns null if the expression hasn't been validated.
+    static RefPtr<CompiledExpression> compile(Expression const&, Optional<size_t> stack_usage, ModuleInstance const&);
+
+    auto& instructions() const { return m_instructions; }
+    auto& branch_table_labels() const { return m_branch_table_labels; }
+
+    // The value stack space a call to this expression needs. It is reserved up front, so that the interpreter can
+    // push operands without checking for capacity.
+    size_t max_stack_height() const { return m_max_stack_height; }
+
+private:
+    explicit CompiledExpression(size_t max_stack_height)
+        : m_max_stack_height(max_stack_height)
+    {
+    }
+
+    void fuse_instructions();
+
+    Vector<CompiledInstruction> m_instructions;
+    size_t m_max_stack_height { 0 };
+
+    // The targets of every br_table, flattened. Each table's default label is stored after its other labels.
+    Vector<u32> m_branch_table_labels;
+};
+
+}
@@ -24,6 +24,10 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
     if (!function)
         return Trap::from_string("Attempt to call nonexistent function by address");
     if (auto* wasm_function = function->get_pointer<WasmFunction>()) {
+        auto const* compiled_expression = wasm_function->compiled_expression();
+        if (compiled_expression)
+            m_value_stack.ensure_capacity(m_value_stack.size() + compiled_expression->max_stack_height());
+
         Vector<Value> locals = move(arguments);
         locals.ensure_capacity(locals.size() + wasm_function->code().func().locals().size());
         for (auto& local : wasm_function->code().func().locals()) {
@@ -36,6 +40,7 @@ Result Configuration::call(Interpreter& interpreter, FunctionAddress address, Ve
             move(locals),
             wasm_function->code().func().body(),
             wasm_function->type().results().size(),
+            compiled_expression,
         });
         m_ip = 0;
         return execute(interpreter);
@@ -138,6 +138,7 @@ ErrorOr<void, ValidationError> Validator::validate(Module& module)
     }
     TRY(validate(module.code_section()));
 
+    module.set_function_stack_usage(move(m_function_stack_usage), {});
     module.set_validation_status(Module::ValidationStatus::Valid, {});
     return {};
 }
@@ -275,6 +276,8 @@ ErrorOr<void, ValidationError> Validator::validate(CodeSection const& section)
         auto results = TRY(function_validator.validate(function.body(), function_type.results()));
         if (results.result_types.size() != function_type.results().size())
             return Errors::invalid("function result"sv, function_type.results(), results.result_types);
+
+        m_function_stack_usage.append(results.max_stack_size);
     }
 
     return {};
@@ -3727,6 +3730,8 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
         is_constant_expression &= is_constant;
     }
 
+    auto max_stack_size = stack.max_known_size();
+
     auto expected_result_types = result_types;
     while (!expected_result_types.is_empty())
         TRY(stack.take(expected_result_types.take_last()));
@@ -3736,7 +3741,7 @@ ErrorOr<Validator::ExpressionTypeResult, ValidationError> Validator::validate(Ex
     m_frames.take_last();
     VERIFY(m_frames.is_empty());
 
-    return ExpressionTypeResult { stack.release_vector(), is_constant_expression };
+    return ExpressionTypeResult { stack.release_vector(), is_constant_expression, max_stack_size };
 }
 
 ByteString Validator::Errors::find_instruction_name(SourceLocation const& location)
@@ -228,8 +228,11 @@ public:
         void append(StackEntry entry)
         {
             Vector<StackEntry>::append(entry);
+            m_max_known_size = max(m_max_known_size, size());
         }
 
+        size_t max_known_size() const { return m_max_known_size; }
+
         ErrorOr<StackEntry, ValidationError> take(ValueType type, SourceLocation location = SourceLocation::current())
         {
             auto type_on_stack = TRY(take_last());
@@ -258,11 +261,15 @@ public:
 
     private:
         Vector<Frame> const& m_frames;
+        size_t m_max_known_size { 0 };
     };
 
     struct ExpressionTypeResult {
         Vector<StackEntry> result_types;
         bool is_constant { false };
+
+        // The maximum number of operands the expression keeps on the value stack.
+        size_t max_stack_size { 0 };
     };
     ErrorOr<ExpressionTypeResult, ValidationError> validate(Expression const&, Vector<ValueType> const&);
     ErrorOr<void, ValidationError> validate(Instruction const& instruction, Stack& stack, bool& is_constant);
@@ -346,6 +353,7 @@ private:
 
     Context m_context;
     Vector<Frame> m_frames;
+    Vector<size_t> m_function_stack_usage;
     COWVector<GlobalType> m_globals_without_internal_globals;
 };
 
@@ -0,0 +1,165 @@
+// Function bodies run through the pre-decoded interpreter loop, which fuses common sequences of local accesses into
+// single instructions and pushes operands without growing the value stack. These build small modules by hand so that
+// both are exercised without needing the spec testsuite.
+
+const I32 = 0x7f;
+const I64 = 0x7e;
+
+const encodeUnsigned = value => {
+    const bytes = [];
+    do {
+        let byte = value & 0x7f;
+        value >>>= 7;
+        if (value !== 0) byte |= 0x80;
+        bytes.push(byte);
+    } while (value !== 0);
+    return bytes;
+};
+
+const encodeSigned = value => {
+    const bytes = [];
+    while (true) {
+        const byte = value & 0x7f;
+        value >>= 7;
+        if ((value === 0 && (byte & 0x40) === 0) || (value === -1 && (byte & 0x40) !== 0)) {
+            bytes.push(byte);
+            return bytes;
+        }
+        bytes.push(byte | 0x80);
+    }
+};
+
+const encodeVector = items => [...encodeUnsigned(items.length), ...items.flat()];
+const encodeSection = (id, contents) => [id, ...encodeUnsigned(contents.length), ...contents];
+const encodeName = name => encodeVector(Array.from(name, c => [c.charCodeAt(0)]));
+
+const op = {
+    block: 0x02,
+    loop: 0x03,
+    if: 0x04,
+    else: 0x05,
+    end: 0x0b,
+    br: 0x0c,
+    br_if: 0x0d,
+    call: 0x10,
+    local_get: 0x20,
+    local_set: 0x21,
+    i32_const: 0x41,
+    i32_eqz: 0x45,
+    i32_lt_s: 0x48,
+    i32_lt_u: 0x49,
+    i32_ge_s: 0x4e,
+    i32_add: 0x6a,
+    i32_sub: 0x6b,
+    i64_add: 0x7c,
+};
+
+const i32Const = value => [op.i32_const, ...encodeSigned(value)];
+const localGet = index => [op.local_get, ...encodeUnsigned(index)];
+const localSet = index => [op.local_set, ...encodeUnsigned(index)];
+
+// Every function gets a type of its own, and is exported under its name.
+const instantiate = functions => {
+    const types = functions.map(f => [0x60, ...encodeVector(f.params.map(p => [p])), ...encodeVector(f.results.map(r => [r]))]);
+    const bodies = functions.map(f => {
+        const body = [...encodeVector((f.locals ?? []).map(([count, type]) => [...encodeUnsigned(count), type])), ...f.body, op.end];
+        return [...encodeUnsigned(body.length), ...body];
+    });
+    // prettier-ignore
+    const binary = new Uint8Array([
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+        ...encodeSection(1, encodeVector(types)),
+        ...encodeSection(3, encodeVector(functions.map((_, i) => encodeUnsigned(i)))),
+        ...encodeSection(7, encodeVector(functions.map((f, i) => [...encodeName(f.name), 0x00, ...encodeUnsigned(i)]))),
+        ...encodeSection(10, encodeVector(bodies)),
+    ]);
+    const module = parseWebAssemblyModule(binary);
+    const exports = {};
+    for (const f of functions) exports[f.name] = (...args) => module.invoke(module.getExport(f.name), ...args);
+    return exports;
+};
+
+test("fused binary operations on two locals", () => {
+    const { add, lt_s, lt_u, add64 } = instantiate([
+        { name: "add", params: [I32, I32], results: [I32], body: [...localGet(0), ...localGet(1), op.i32_add] },
+        { name: "lt_s", params: [I32, I32], results: [I32], body: [...localGet(0), ...localGet(1), op.i32_lt_s] },
+        { name: "lt_u", params: [I32, I32], results: [I32], body: [...localGet(0), ...localGet(1), op.i32_lt_u] },
+        { name: "add64", params: [I64, I64], results: [I64], body: [...localGet(0), ...localGet(1), op.i64_add] },
+    ]);
+
+    expect(add(2, 3)).toBe(5);
+    expect(add(0x7fffffff, 1)).toBe(-0x80000000);
+    expect(lt_s(-1, 1)).toBe(1);
+    expect(lt_u(-1, 1)).toBe(0);
+    expect(add64(2n ** 40n, 1n)).toBe(2n ** 40n + 1n);
+});
+
+test("fused binary operations on a local and a constant", () => {
+    const { subtract_seven } = instantiate([
+        { name: "subtract_seven", params: [I32], results: [I32], body: [...localGet(0), ...i32Const(7), op.i32_sub] },
+    ]);
+
+    expect(subtract_seven(3)).toBe(-4);
+    expect(subtract_seven(-0x80000000)).toBe(0x7ffffff9);
+});
+
+test("fused local copies and increments in a loop", () => {
+    // Sums 0 to n - 1. Locals: 0 = n, 1 = i, 2 = sum, 3 = copy of sum.
+    const { sum_below } = instantiate([
+        {
+            name: "sum_below",
+            params: [I32],
+            results: [I32],
+            locals: [[3, I32]],
+            // prettier-ignore
+            body: [
+                op.block, 0x40,
+                op.loop, 0x40,
+                ...localGet(1), ...localGet(0), op.i32_ge_s, op.br_if, 1,
+                ...localGet(2), ...localGet(1), op.i32_add, ...localSet(2),
+                ...localGet(1), ...i32Const(1), op.i32_add, ...localSet(1),
+                op.br, 0,
+                op.end,
+                op.end,
+                ...localGet(2), ...localSet(3),
+                ...localGet(3),
+            ],
+        },
+    ]);
+
+    expect(sum_below(0)).toBe(0);
+    expect(sum_below(10)).toBe(45);
+    expect(sum_below(1000)).toBe(499500);
+});
+
+test("functions that use a lot of operand stack", () => {
+    const depth = 300;
+    const ones = Array.from({ length: depth }, () => i32Const(1)).flat();
+    const adds = Array(depth - 1).fill(op.i32_add);
+
+    // Every call leaves `depth` operands on the stack while it calls itself, so the value stack has to grow for
+    // every frame.
+    const { deep, deep_recursive } = instantiate([
+        { name: "deep", params: [], results: [I32], body: [...ones, ...adds] },
+        {
+            name: "deep_recursive",
+            params: [I32],
+            results: [I32],
+            // prettier-ignore
+            body: [
+                ...ones,
+                ...localGet(0), op.i32_eqz,
+                op.if, I32,
+                ...i32Const(0),
+                op.else,
+                ...localGet(0), ...i32Const(1), op.i32_sub, op.call, 1,
+                op.end,
+                ...adds, op.i32_add,
+            ],
+        },
+    ]);
+
+    expect(deep()).toBe(depth);
+    expect(deep_recursive(0)).toBe(depth);
+    expect(deep_recursive(50)).toBe(depth * 51);
+});
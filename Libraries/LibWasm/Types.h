@@ -1029,6 +1029,16 @@ public:
     StringView validation_error() const { return *m_validation_error; }
     void set_validation_error(ByteString error) { m_validation_error = move(error); }
 
+    // The maximum number of operands the body of each function in the code section keeps on the value stack, as
+    // found by the validator.
+    void set_function_stack_usage(Vector<size_t> stack_usage, Badge<Validator>) { m_function_stack_usage = move(stack_usage); }
+    Optional<size_t> function_stack_usage(size_t code_index) const
+    {
+        if (code_index >= m_function_stack_usage.size())
+            return {};
+        return m_function_stack_usage[code_index];
+    }
+
     static ParseResult<NonnullRefPtr<Module>> parse(Stream& stream);
 
 private:
@@ -1050,6 +1060,7 @@ private:
 
     ValidationStatus m_validation_status { ValidationStatus::Unchecked };
     Optional<ByteString> m_validation_error;
+    Vector<size_t> m_function_stack_usage;
 };
 
 }
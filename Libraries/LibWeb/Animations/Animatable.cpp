@@ -128,6 +128,11 @@ void Animatable::disassociate_with_animation(GC::Ref<Animation> animation)
     impl.associated_animations.remove_first_matching([&](auto element) { return animation == element; });
 }
 
+bool Animatable::has_associated_animations() const
+{
+    return m_impl && !m_impl->associated_animations.is_empty();
+}
+
 void Animatable::add_transitioned_properties(Vector<Vector<CSS::PropertyID>> properties, CSS::StyleValueVector delays, CSS::StyleValueVector durations, CSS::StyleValueVector timing_functions, CSS::StyleValueVector transition_behaviors)
 {
     auto& impl = ensure_impl();
@@ -959,13 +959,16 @@ void KeyframeEffect::update_computed_properties()
         return TraversalDecision::Continue;
     });
 
+    Painting::Paintable* target_paintable = nullptr;
     if (!pseudo_element_type().has_value()) {
         if (target->layout_node())
             target->layout_node()->apply_style(*style);
+        target_paintable = target->paintable();
     } else {
         auto pseudo_element_node = target->get_pseudo_element_node(pseudo_element_type().value());
         if (auto* node_with_style = dynamic_cast<Layout::NodeWithStyle*>(pseudo_element_node.ptr())) {
             node_with_style->apply_style(*style);
+            target_paintable = node_with_style->first_paintable();
         }
     }
 
@@ -981,7 +984,11 @@ void KeyframeEffect::update_computed_properties()
         }
     }
     if (invalidation.repaint) {
-        document.set_needs_display();
+        // Only the part of the display list that paints the target has to be recorded again.
+        if (target_paintable)
+            target_paintable->set_needs_display();
+        else
+            document.set_needs_display();
         document.set_needs_to_resolve_paint_only_properties();
     }
     if (invalidation.rebuild_stacking_context_tree)
@@ -1253,4 +1253,45 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
     }
 }
 
+bool matches_same_pseudo_classes(CSS::PseudoClassBitmap const& pseudo_classes, DOM::Element const& a, DOM::Element const& b)
+{
+    for (size_t i = 0; i < to_underlying(CSS::PseudoClass::__Count); ++i) {
+        auto type = static_cast<CSS::PseudoClass>(i);
+        if (!pseudo_classes.get(type))
+            continue;
+
+        switch (type) {
+        case CSS::PseudoClass::Host:
+        case CSS::PseudoClass::Is:
+        case CSS::PseudoClass::Lang:
+        case CSS::PseudoClass::Not:
+        case CSS::PseudoClass::Root:
+        case CSS::PseudoClass::Scope:
+        case CSS::PseudoClass::Where:
+            continue;
+        case CSS::PseudoClass::Dir:
+        case CSS::PseudoClass::FirstChild:
+        case CSS::PseudoClass::FirstOfType:
+        case CSS::PseudoClass::Has:
+        case CSS::PseudoClass::LastChild:
+        case CSS::PseudoClass::LastOfType:
+        case CSS::PseudoClass::NthChild:
+        case CSS::PseudoClass::NthLastChild:
+        case CSS::PseudoClass::NthLastOfType:
+        case CSS::PseudoClass::NthOfType:
+        case CSS::PseudoClass::OnlyChild:
+        case CSS::PseudoClass::OnlyOfType:
+            return false;
+        default:
+            break;
+        }
+
+        CSS::Selector::SimpleSelector::PseudoClassSelector pseudo_class { .type = type };
+        MatchContext context;
+        if (matches_pseudo_class(pseudo_class, a, nullptr, context, nullptr, SelectorKind::Normal) != matches_pseudo_class(pseudo_class, b, nullptr, context, nullptr, SelectorKind::Normal))
+            return false;
+    }
+    return true;
+}
+
 }
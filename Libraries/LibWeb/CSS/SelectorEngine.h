@@ -25,4 +25,8 @@ struct MatchContext {
 
 bool matches(CSS::Selector const&, DOM::Element const&, GC::Ptr<DOM::Element const> shadow_host, MatchContext& context, Optional<CSS::PseudoElement> = {}, GC::Ptr<DOM::ParentNode const> scope = {}, SelectorKind selector_kind = SelectorKind::Normal, GC::Ptr<DOM::Element const> anchor = nullptr);
 
+// Returns true if both elements agree on every pseudo-class in the set. Pseudo-classes that only depend on an element's
+// tag, attributes and ancestors are assumed to agree; ones that depend on its siblings or on arguments never do.
+bool matches_same_pseudo_classes(CSS::PseudoClassBitmap const&, DOM::Element const&, DOM::Element const&);
+
 }
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/CSS/SelectorListCache.h>
+
+namespace Web::CSS {
+
+SelectorListCache::SelectorListCache(size_t capacity)
+    : m_entries(capacity)
+{
+}
+
+SelectorListCache::~SelectorListCache() = default;
+
+Optional<SelectorList> SelectorListCache::get(StringView selector_text)
+{
+    if (auto const* selectors = m_entries.get(selector_text))
+        return *selectors;
+    return {};
+}
+
+void SelectorListCache::set(StringView selector_text, SelectorList selectors)
+{
+    m_entries.set(MUST(String::from_utf8(selector_text)), move(selectors));
+}
+
+void SelectorListCache::clear()
+{
+    m_entries.clear();
+}
+
+}
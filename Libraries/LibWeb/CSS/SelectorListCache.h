@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/LRUCache.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibWeb/CSS/Selector.h>
+
+namespace Web::CSS {
+
+// Keeps recently parsed selector lists around, as scripts tend to pass the same few selectors to querySelector(),
+// querySelectorAll(), matches() and friends over and over again.
+class SelectorListCache {
+    AK_MAKE_NONCOPYABLE(SelectorListCache);
+    AK_MAKE_NONMOVABLE(SelectorListCache);
+
+public:
+    explicit SelectorListCache(size_t capacity);
+    ~SelectorListCache();
+
+    Optional<SelectorList> get(StringView selector_text);
+    void set(StringView selector_text, SelectorList);
+
+    void clear();
+
+    size_t size() const { return m_entries.size(); }
+    size_t hit_count() const { return m_entries.hit_count(); }
+    size_t miss_count() const { return m_entries.miss_count(); }
+
+private:
+    LRUCache<String, SelectorList> m_entries;
+};
+
+}
@@ -74,11 +74,14 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/Fetch/Infrastructure/FetchController.h>
 #include <LibWeb/Fetch/Response.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
+#include <LibWeb/HTML/HTMLBodyElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
+#include <LibWeb/HTML/HTMLTableCellElement.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Layout/Node.h>
@@ -1651,10 +1654,8 @@ void StyleComputer::start_needed_transitions(ComputedProperties const& previous_
 
 // https://www.w3.org/TR/css-cascade/#cascading
 // https://drafts.csswg.org/css-cascade-5/#layering
-GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element& element, Optional<CSS::PseudoElement> pseudo_element, bool& did_match_any_pseudo_element_rules, PseudoClassBitmap& attempted_pseudo_class_matches, ComputeStyleMode mode) const
+GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element& element, Optional<CSS::PseudoElement> pseudo_element, bool& did_match_any_pseudo_element_rules, PseudoClassBitmap& attempted_pseudo_class_matches, ComputeStyleMode mode, MatchedPropertiesCacheEntry const*& matched_properties_cache_hit, Optional<MatchedPropertiesCacheKey>& matched_properties_cache_key) const
 {
-    auto cascaded_properties = m_document->heap().allocate<CascadedProperties>();
-
     // First, we collect all the CSS rules whose selectors match `element`:
     MatchingRuleSet matching_rule_set;
     matching_rule_set.user_agent_rules = collect_matching_rules(element, CascadeOrigin::UserAgent, pseudo_element, attempted_pseudo_class_matches);
@@ -1672,6 +1673,20 @@ GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element&
     sort_matching_rules(unlayered_author_rules);
     matching_rule_set.author_rules.append({ {}, unlayered_author_rules });
 
+    // If another element with the same parent style matched exactly the same declarations, we can reuse its cascade.
+    if (!pseudo_element.has_value()) {
+        matched_properties_cache_key = matched_properties_cache_key_for(element, matching_rule_set);
+        if (matched_properties_cache_key.has_value()) {
+            if (auto entry = m_matched_properties_cache.get(*matched_properties_cache_key); entry.has_value()) {
+                element.set_custom_properties({}, entry->custom_properties);
+                matched_properties_cache_hit = &entry.value();
+                return entry->cascaded_properties;
+            }
+        }
+    }
+
+    auto cascaded_properties = m_document->heap().allocate<CascadedProperties>();
+
     if (mode == ComputeStyleMode::CreatePseudoElementStyleIfNeeded) {
         VERIFY(pseudo_element.has_value());
         if (matching_rule_set.author_rules.is_empty() && matching_rule_set.user_rules.is_empty() && matching_rule_set.user_agent_rules.is_empty()) {
@@ -1742,6 +1757,72 @@ GC::Ref<CascadedProperties> StyleComputer::compute_cascaded_values(DOM::Element&
     return cascaded_properties;
 }
 
+// Elements whose style involves per-element state that can't be carried over from another element's style.
+static bool is_eligible_for_style_reuse(DOM::Element const& element)
+{
+    if (element.use_pseudo_element().has_value())
+        return false;
+    if (element.has_associated_animations() || element.cached_animation_name_animation({}) || element.cached_transition_property_source())
+        return false;
+    return true;
+}
+
+Optional<MatchedPropertiesCacheKey> StyleComputer::matched_properties_cache_key_for(DOM::Element const& element, MatchingRuleSet const& matching_rule_set) const
+{
+    // The parent's style stands in for everything the element inherits, so it has to be what we inherit from.
+    auto const* parent = element.parent_element();
+    if (!parent || parent != element_to_inherit_style_from(&element, {}) || !parent->computed_properties())
+        return {};
+
+    if (!is_eligible_for_style_reuse(element))
+        return {};
+
+    // Inline style, presentational hints and SVG presentation attributes are specific to the element.
+    if (element.inline_style() || element.is_svg_element() || element.supports_dimension_attributes())
+        return {};
+    // NOTE: These elements derive presentational hints from other elements' attributes.
+    if (is<HTML::HTMLBodyElement>(element) || is<HTML::HTMLTableCellElement>(element))
+        return {};
+    bool has_presentational_hints = false;
+    element.for_each_attribute([&](FlyString const& name, String const&) {
+        if (element.is_presentational_hint(name))
+            has_presentational_hints = true;
+    });
+    if (has_presentational_hints)
+        return {};
+
+    MatchedPropertiesCacheKey key {
+        .parent_style = parent->computed_properties(),
+        .local_name = element.local_name(),
+        .namespace_uri = element.namespace_uri(),
+    };
+    u32 hash = pair_int_hash(ptr_hash(key.parent_style.ptr()), key.local_name.hash());
+
+    auto append_rules = [&](Vector<MatchingRule const*> const& rules) {
+        for (auto const* rule : rules) {
+            // Substituting var() and attr() depends on more than the parent's style.
+            if (rule->contains_unresolved_values)
+                return false;
+            auto const* declaration = &rule->declaration();
+            key.declarations.append(declaration);
+            hash = pair_int_hash(hash, ptr_hash(declaration));
+        }
+        // Keep the rules of each origin and layer apart.
+        key.declarations.append(nullptr);
+        return true;
+    };
+
+    if (!append_rules(matching_rule_set.user_agent_rules) || !append_rules(matching_rule_set.user_rules))
+        return {};
+    for (auto const& layer : matching_rule_set.author_rules) {
+        if (!append_rules(layer.rules))
+            return {};
+    }
+
+    key.hash = hash;
+    return key;
+}
+
 DOM::Element const* element_to_inherit_style_from(DOM::Element const* element, Optional<CSS::PseudoElement> pseudo_element)
 {
     // Pseudo-elements treat their originating element as their parent.
@@ -2489,6 +2570,100 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_pseudo_element_style_if_neede
     return compute_style_impl(element, move(pseudo_element), ComputeStyleMode::CreatePseudoElementStyleIfNeeded);
 }
 
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    if (a.attribute_list_size() == 0)
+        return true;
+
+    auto const& a_attributes = *a.attributes();
+    auto const& b_attributes = *b.attributes();
+    for (u32 i = 0; i < a_attributes.length(); ++i) {
+        auto const& a_attribute = *a_attributes.item(i);
+        auto const& b_attribute = *b_attributes.item(i);
+        if (a_attribute.local_name() != b_attribute.local_name()
+            || a_attribute.namespace_uri() != b_attribute.namespace_uri()
+            || a_attribute.value() != b_attribute.value())
+            return false;
+    }
+    return true;
+}
+
+// Style sharing: an element that is indistinguishable from one of its previous siblings to every selector that was
+// tried against that sibling ends up with the same computed style, so we can copy it instead of running the cascade.
+// Siblings also have identical ancestors, and therefore an identical ancestor filter, so descendant and child
+// combinators evaluate the same way for both of them.
+GC::Ptr<ComputedProperties> StyleComputer::share_style_with_sibling_if_possible(DOM::Element& element) const
+{
+    static constexpr size_t max_candidates_to_check = 8;
+
+    // Whether a :has() selector matches may depend on the siblings' subtrees, which we don't compare.
+    if (m_selector_insights->has_has_selectors)
+        return {};
+
+    auto parent = element.parent_element();
+    if (!parent || parent->needs_style_update() || !parent->computed_properties())
+        return {};
+    // Slotted elements inherit from their slot and can match ::slotted(), so leave them to the full cascade.
+    if (parent->is_shadow_host())
+        return {};
+    if (element.is_shadow_host() || !is_eligible_for_style_reuse(element))
+        return {};
+
+    size_t candidates_checked = 0;
+    for (auto* candidate = element.previous_element_sibling(); candidate && candidates_checked < max_candidates_to_check; candidate = candidate->previous_element_sibling(), ++candidates_checked) {
+        auto candidate_style = candidate->computed_properties();
+        auto candidate_cascaded_properties = candidate->cascaded_properties({});
+        if (!candidate_style || !candidate_cascaded_properties || candidate->needs_style_update())
+            continue;
+
+        if (candidate->local_name() != element.local_name() || candidate->namespace_uri() != element.namespace_uri())
+            continue;
+        if (!have_same_attributes(*candidate, element))
+            continue;
+        if (candidate->is_shadow_host() || !is_eligible_for_style_reuse(*candidate))
+            continue;
+
+        // The candidate's style must not depend on its position among its siblings.
+        if (candidate->style_affected_by_structural_changes()
+            || candidate->affected_by_has_pseudo_class_in_subject_position()
+            || candidate->affected_by_has_pseudo_class_in_non_subject_position())
+            continue;
+
+        // Animations and transitions are started per element while computing properties.
+        if (candidate_style->animation_name_source() || candidate_style->transition_property_source() || !candidate_style->animated_property_values().is_empty())
+            continue;
+
+        if (!SelectorEngine::matches_same_pseudo_classes(candidate_style->m_attempted_pseudo_class_matches, *candidate, element))
+            continue;
+
+        element.set_cascaded_properties({}, candidate_cascaded_properties);
+        element.set_custom_properties({}, candidate->custom_properties({}));
+        if (candidate->style_uses_css_custom_properties())
+            element.set_style_uses_css_custom_properties(true);
+        ++m_style_recalc_counters.shared_styles;
+        return clone_computed_properties(*candidate_style);
+    }
+    return {};
+}
+
+// NOTE: Animated values and the sources of animation and transition declarations belong to a single element, so they
+//       are not carried over.
+GC::Ref<ComputedProperties> StyleComputer::clone_computed_properties(ComputedProperties const& other) const
+{
+    auto style = document().heap().allocate<ComputedProperties>();
+    style->m_property_values = other.m_property_values;
+    style->m_property_important = other.m_property_important;
+    style->m_property_inherited = other.m_property_inherited;
+    style->m_math_depth = other.m_math_depth;
+    style->m_font_list = other.m_font_list;
+    style->m_first_available_computed_font = other.m_first_available_computed_font;
+    style->m_line_height = other.m_line_height;
+    style->m_attempted_pseudo_class_matches = other.m_attempted_pseudo_class_matches;
+    return style;
+}
+
 GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& element, Optional<CSS::PseudoElement> pseudo_element, ComputeStyleMode mode) const
 {
     build_rule_cache_if_needed();
@@ -2508,10 +2683,18 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    if (!pseudo_element.has_value()) {
+        ++m_style_recalc_counters.style_recalcs;
+        if (auto shared_style = share_style_with_sibling_if_possible(element))
+            return shared_style;
+    }
+
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
     PseudoClassBitmap attempted_pseudo_class_matches;
-    auto cascaded_properties = compute_cascaded_values(element, pseudo_element, did_match_any_pseudo_element_rules, attempted_pseudo_class_matches, mode);
+    MatchedPropertiesCacheEntry const* matched_properties_cache_hit = nullptr;
+    Optional<MatchedPropertiesCacheKey> matched_properties_cache_key;
+    auto cascaded_properties = compute_cascaded_values(element, pseudo_element, did_match_any_pseudo_element_rules, attempted_pseudo_class_matches, mode, matched_properties_cache_hit, matched_properties_cache_key);
 
     element.set_cascaded_properties(pseudo_element, cascaded_properties);
 
@@ -2544,7 +2727,16 @@ GC::Ptr<ComputedProperties> StyleComputer::compute_style_impl(DOM::Element& elem
         }
     }
 
-    auto computed_properties = compute_properties(element, pseudo_element, cascaded_properties);
+    GC::Ptr<ComputedProperties> computed_properties;
+    if (matched_properties_cache_hit) {
+        ++m_style_recalc_counters.matched_properties_cache_hits;
+        computed_properties = clone_computed_properties(matched_properties_cache_hit->computed_properties);
+        element.adjust_computed_style(*computed_properties);
+    } else {
+        if (matched_properties_cache_key.has_value())
+            ++m_style_recalc_counters.matched_properties_cache_misses;
+        computed_properties = compute_properties(element, pseudo_element, cascaded_properties, move(matched_properties_cache_key));
+    }
     computed_properties->set_attempted_pseudo_class_matches(attempted_pseudo_class_matches);
     return computed_properties;
 }
@@ -2632,7 +2824,7 @@ RefPtr<CSSStyleValue const> StyleComputer::recascade_font_size_if_needed(
     return CSS::LengthStyleValue::create(CSS::Length::make_px(current_size_in_px));
 }
 
-GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& element, Optional<PseudoElement> pseudo_element, CascadedProperties& cascaded_properties) const
+GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& element, Optional<PseudoElement> pseudo_element, CascadedProperties& cascaded_properties, Optional<MatchedPropertiesCacheKey> matched_properties_cache_key) const
 {
     auto computed_style = document().heap().allocate<CSS::ComputedProperties>();
 
@@ -2768,6 +2960,18 @@ GC::Ref<ComputedProperties> StyleComputer::compute_properties(DOM::Element& elem
     resolve_effective_overflow_values(computed_style);
     compute_text_align(computed_style, element, pseudo_element);
 
+    // Remember the style for other elements that match the same declarations, unless it depends on this element's
+    // ancestors beyond the parent or on animations that belong to this element.
+    if (matched_properties_cache_key.has_value() && !new_font_size && m_matched_properties_cache.size() < max_matched_properties_cache_size
+        && !computed_style->animation_name_source() && !computed_style->transition_property_source() && computed_style->animated_property_values().is_empty()) {
+        m_matched_properties_cache.set(matched_properties_cache_key.release_value(),
+            MatchedPropertiesCacheEntry {
+                .cascaded_properties = cascaded_properties,
+                .computed_properties = clone_computed_properties(computed_style),
+                .custom_properties = element.custom_properties({}),
+            });
+    }
+
     // 8. Let the element adjust computed style
     element.adjust_computed_style(computed_style);
 
@@ -2892,6 +3096,9 @@ void StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_ori
                     cascade_origin,
                     false,
                 };
+                matching_rule.contains_unresolved_values = any_of(matching_rule.declaration().properties(), [](auto const& property) {
+                    return property.value->is_unresolved();
+                });
 
                 auto const& qualified_layer_name = matching_rule.qualified_layer_name();
                 auto& rule_cache = qualified_layer_name.is_empty() ? rule_caches.main : *rule_caches.by_layer.ensure(qualified_layer_name, [] { return make<RuleCache>(); });
@@ -3072,6 +3279,7 @@ void StyleComputer::build_rule_cache()
 void StyleComputer::invalidate_rule_cache()
 {
     m_author_rule_cache = nullptr;
+    m_matched_properties_cache.clear();
 
     // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
     //       Currently we are re-parsing the user style sheet every time we build the caches,
@@ -3222,22 +3430,41 @@ static void for_each_element_hash(DOM::Element const& element, auto callback)
     });
 }
 
+void StyleComputer::visit_edges(JS::Cell::Visitor& visitor)
+{
+    for (auto const& [key, entry] : m_matched_properties_cache) {
+        visitor.visit(key.parent_style);
+        visitor.visit(entry.cascaded_properties);
+        visitor.visit(entry.computed_properties);
+    }
+}
+
 void StyleComputer::reset_ancestor_filter()
 {
     m_ancestor_filter.clear();
 }
 
 void StyleComputer::push_ancestor(DOM::Element const& element)
+{
+    m_ancestor_filter.push_ancestor(element);
+}
+
+void StyleComputer::pop_ancestor(DOM::Element const& element)
+{
+    m_ancestor_filter.pop_ancestor(element);
+}
+
+void AncestorFilter::push_ancestor(DOM::Element const& element)
 {
     for_each_element_hash(element, [&](u32 hash) {
-        m_ancestor_filter.increment(hash);
+        m_filter.increment(hash);
     });
 }
 
-void StyleComputer::pop_ancestor(DOM::Element const& element)
+void AncestorFilter::pop_ancestor(DOM::Element const& element)
 {
     for_each_element_hash(element, [&](u32 hash) {
-        m_ancestor_filter.decrement(hash);
+        m_filter.decrement(hash);
     });
 }
 
@@ -3366,7 +3593,7 @@ void RuleCache::for_each_matching_rules(DOM::Element const& element, Optional<Ps
     }
 
     IterationDecision decision = IterationDecision::Continue;
-    element.for_each_attribute([&](auto& name, auto&) {
+    element.for_each_attribute([&](FlyString const& name, String const&) {
         if (auto it = rules_by_attribute_name.find(name); it != rules_by_attribute_name.end()) {
             decision = callback(it->value);
         }
@@ -74,6 +74,22 @@ private:
     CounterType m_buckets[bucket_count];
 };
 
+// Tracks the names, IDs, classes and attributes of the ancestors of the element being matched, so that selectors
+// requiring an ancestor that isn't there can be rejected without walking up the tree.
+class AncestorFilter {
+public:
+    AncestorFilter() { clear(); }
+
+    void clear() { m_filter.clear(); }
+    void push_ancestor(DOM::Element const&);
+    void pop_ancestor(DOM::Element const&);
+
+    [[nodiscard]] inline bool should_reject(Selector const&) const;
+
+private:
+    CountingBloomFilter<u8, 14> m_filter;
+};
+
 struct MatchingRule {
     GC::Ptr<DOM::ShadowRoot const> shadow_root;
     GC::Ptr<CSSRule const> rule; // Either CSSStyleRule or CSSNestedDeclarations
@@ -86,6 +102,7 @@ struct MatchingRule {
     u32 specificity { 0 };
     CascadeOrigin cascade_origin;
     bool contains_pseudo_element { false };
+    bool contains_unresolved_values { false };
 
     // Helpers to deal with the fact that `rule` might be a CSSStyleRule or a CSSNestedDeclarations
     CSSStyleProperties const& declaration() const;
@@ -93,6 +110,22 @@ struct MatchingRule {
     FlyString const& qualified_layer_name() const;
 };
 
+// Identifies the outcome of the cascade and the computation of values by everything that went into them: the style
+// of the element's parent, the element's tag, and the exact declarations it matched, in cascade order.
+struct MatchedPropertiesCacheKey {
+    GC::Ptr<ComputedProperties const> parent_style;
+    FlyString local_name;
+    Optional<FlyString> namespace_uri;
+    Vector<CSSStyleProperties const*> declarations;
+    u32 hash { 0 };
+
+    bool operator==(MatchedPropertiesCacheKey const&) const = default;
+};
+
+struct MatchedPropertiesCacheKeyTraits : public DefaultTraits<MatchedPropertiesCacheKey> {
+    static unsigned hash(MatchedPropertiesCacheKey const& key) { return key.hash; }
+};
+
 struct FontFaceKey;
 
 struct OwnFontFaceKey {
@@ -147,10 +180,23 @@ public:
     DOM::Document& document() { return m_document; }
     DOM::Document const& document() const { return m_document; }
 
+    void visit_edges(JS::Cell::Visitor&);
+
     void reset_ancestor_filter();
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    void clear_matched_properties_cache() { m_matched_properties_cache.clear(); }
+
+    struct StyleRecalcCounters {
+        u64 style_recalcs { 0 };
+        u64 shared_styles { 0 };
+        u64 matched_properties_cache_hits { 0 };
+        u64 matched_properties_cache_misses { 0 };
+    };
+    StyleRecalcCounters const& style_recalc_counters() const { return m_style_recalc_counters; }
+    void reset_style_recalc_counters() { m_style_recalc_counters = {}; }
+
     [[nodiscard]] GC::Ref<ComputedProperties> create_document_style() const;
 
     [[nodiscard]] GC::Ref<ComputedProperties> compute_style(DOM::Element&, Optional<CSS::PseudoElement> = {}) const;
@@ -194,7 +240,7 @@ public:
 
     size_t number_of_css_font_faces_with_loading_in_progress() const;
 
-    [[nodiscard]] GC::Ref<ComputedProperties> compute_properties(DOM::Element&, Optional<PseudoElement>, CascadedProperties&) const;
+    [[nodiscard]] GC::Ref<ComputedProperties> compute_properties(DOM::Element&, Optional<PseudoElement>, CascadedProperties&, Optional<MatchedPropertiesCacheKey> = {}) const;
 
     void absolutize_values(ComputedProperties&, GC::Ptr<DOM::Element const>) const;
     void compute_font(ComputedProperties&, DOM::Element const*, Optional<CSS::PseudoElement>) const;
@@ -210,7 +256,17 @@ private:
     struct MatchingFontCandidate;
 
     [[nodiscard]] GC::Ptr<ComputedProperties> compute_style_impl(DOM::Element&, Optional<CSS::PseudoElement>, ComputeStyleMode) const;
-    [[nodiscard]] GC::Ref<CascadedProperties> compute_cascaded_values(DOM::Element&, Optional<CSS::PseudoElement>, bool& did_match_any_pseudo_element_rules, PseudoClassBitmap& attempted_pseudo_class_matches, ComputeStyleMode) const;
+    [[nodiscard]] GC::Ptr<ComputedProperties> share_style_with_sibling_if_possible(DOM::Element&) const;
+    [[nodiscard]] GC::Ref<ComputedProperties> clone_computed_properties(ComputedProperties const&) const;
+
+    static constexpr size_t max_matched_properties_cache_size = 4096;
+    struct MatchedPropertiesCacheEntry {
+        GC::Ref<CascadedProperties> cascaded_properties;
+        // NOTE: This is the computed style before the element got to adjust it.
+        GC::Ref<ComputedProperties> computed_properties;
+        HashMap<FlyString, StyleProperty> custom_properties;
+    };
+    [[nodiscard]] GC::Ref<CascadedProperties> compute_cascaded_values(DOM::Element&, Optional<CSS::PseudoElement>, bool& did_match_any_pseudo_element_rules, PseudoClassBitmap& attempted_pseudo_class_matches, ComputeStyleMode, MatchedPropertiesCacheEntry const*& matched_properties_cache_hit, Optional<MatchedPropertiesCacheKey>& matched_properties_cache_key) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     RefPtr<Gfx::FontCascadeList const> font_matching_algorithm(FlyString const& family_name, int weight, int slope, float font_size_in_pt) const;
@@ -254,6 +310,8 @@ private:
         Vector<LayerMatchingRules> author_rules;
     };
 
+    [[nodiscard]] Optional<MatchedPropertiesCacheKey> matched_properties_cache_key_for(DOM::Element const&, MatchingRuleSet const&) const;
+
     void cascade_declarations(
         CascadedProperties&,
         DOM::Element&,
@@ -306,7 +364,10 @@ private:
 
     CSSPixelRect m_viewport_rect;
 
-    CountingBloomFilter<u8, 14> m_ancestor_filter;
+    AncestorFilter m_ancestor_filter;
+
+    mutable HashMap<MatchedPropertiesCacheKey, MatchedPropertiesCacheEntry, MatchedPropertiesCacheKeyTraits> m_matched_properties_cache;
+    mutable StyleRecalcCounters m_style_recalc_counters;
 };
 
 class FontLoader : public Weakable<FontLoader> {
@@ -338,15 +399,20 @@ private:
     Function<void(RefPtr<Gfx::Typeface const>)> m_on_load;
 };
 
-inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+inline bool AncestorFilter::should_reject(Selector const& selector) const
 {
     for (u32 hash : selector.ancestor_hashes()) {
         if (hash == 0)
             break;
-        if (!m_ancestor_filter.may_contain(hash))
+        if (!m_filter.may_contain(hash))
             return true;
     }
     return false;
 }
 
+inline bool StyleComputer::should_reject_with_ancestor_filter(Selector const& selector) const
+{
+    return m_ancestor_filter.should_reject(selector);
+}
+
 }
@@ -41,6 +41,7 @@
 #include <LibWeb/CSS/MediaQueryListEvent.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/SelectorEngine.h>
+#include <LibWeb/CSS/SelectorListCache.h>
 #include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/CSS/StyleSheetIdentifier.h>
 #include <LibWeb/CSS/StyleValues/ColorSchemeStyleValue.h>
@@ -141,10 +142,13 @@
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/IntersectionObserver/IntersectionObserver.h>
 #include <LibWeb/Layout/BlockFormattingContext.h>
+#include <LibWeb/Layout/FieldSetBox.h>
+#include <LibWeb/Layout/ListItemBox.h>
 #include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/StackingContext.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/PermissionsPolicy/AutoplayAllowlist.h>
 #include <LibWeb/ResizeObserver/ResizeObserver.h>
@@ -525,6 +529,8 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_window);
     visitor.visit(m_layout_root);
     visitor.visit(m_style_sheets);
+    if (m_style_computer)
+        m_style_computer->visit_edges(visitor);
     visitor.visit(m_hovered_node);
     visitor.visit(m_inspected_node);
     visitor.visit(m_highlighted_node);
@@ -1086,6 +1092,7 @@ WebIDL::ExceptionOr<void> Document::set_title(String const& title)
 void Document::tear_down_layout_tree()
 {
     m_layout_root = nullptr;
+    m_retained_layout_state = nullptr;
     m_paintable = nullptr;
     m_needs_full_layout_tree_update = true;
 }
@@ -1291,6 +1298,117 @@ static void propagate_overflow_to_viewport(Element& root_element, Layout::Viewpo
     overflow_origin_computed_values.set_overflow_y(CSS::Overflow::Visible);
 }
 
+// A relayout boundary is a box whose used size and position can't depend on anything inside of it, so the things
+// inside of it can be laid out again without laying out anything around it.
+static bool is_relayout_boundary(Layout::Box const& box)
+{
+    if (!is<Layout::BlockContainer>(box) || box.is_viewport() || box.is_replaced_box() || box.is_anonymous())
+        return false;
+
+    // NOTE: List item markers and fieldset legends are laid out by the formatting context around their box.
+    if (is<Layout::ListItemBox>(box) || is<Layout::FieldSetBox>(box))
+        return false;
+
+    if (Layout::FormattingContext::formatting_context_type_created_by_box(box) != Layout::FormattingContext::Type::Block)
+        return false;
+
+    if (!box.display().is_block_outside() || box.is_out_of_flow())
+        return false;
+
+    // The box has to sit in normal block flow all the way up, where nothing around it is sized or aligned by its
+    // contents. For example, the baseline of an inline-block, a table cell or a flex item may come from a line box
+    // inside of this box, and so may the position of a list item's marker.
+    if (!box.parent() || box.parent()->is_viewport())
+        return false;
+    for (auto const* ancestor = box.parent(); ancestor && !ancestor->is_viewport(); ancestor = ancestor->parent()) {
+        if (!is<Layout::BlockContainer>(*ancestor) || ancestor->children_are_inline())
+            return false;
+        if (is<Layout::ListItemBox>(*ancestor) || is<Layout::FieldSetBox>(*ancestor))
+            return false;
+        auto display = ancestor->display();
+        if (!display.is_block_outside() || (!display.is_flow_inside() && !display.is_flow_root_inside()))
+            return false;
+    }
+
+    // Anything but a fixed size could depend on the contents, e.g. when an ancestor asks for its intrinsic size.
+    auto const& computed_values = box.computed_values();
+    if (!computed_values.width().is_length() || !computed_values.height().is_length())
+        return false;
+    if (!computed_values.min_width().is_auto() && !computed_values.min_width().is_length())
+        return false;
+    if (!computed_values.min_height().is_auto() && !computed_values.min_height().is_length())
+        return false;
+    if (!computed_values.max_width().is_none() && !computed_values.max_width().is_length())
+        return false;
+    if (!computed_values.max_height().is_none() && !computed_values.max_height().is_length())
+        return false;
+
+    return true;
+}
+
+bool Document::lay_out_changed_relayout_boundaries(CSSPixelRect const& viewport_rect)
+{
+    if (!m_retained_layout_state)
+        return false;
+    auto& layout_state = *m_retained_layout_state;
+
+    // Used values that were cleared for a relayout aren't reclaimed, so start over once they outnumber the live ones.
+    if (layout_state.cleared_used_values_count() > layout_state.used_values_count())
+        return false;
+
+    auto const* viewport_state = layout_state.try_get(*m_layout_root);
+    if (!viewport_state || viewport_state->content_width() != viewport_rect.width() || viewport_state->content_height() != viewport_rect.height())
+        return false;
+
+    // Nodes that were only marked because something inside of them changed don't need layout themselves, but anything
+    // that changed outside of a relayout boundary means the whole tree has to be laid out again.
+    Vector<GC::Ref<Layout::BlockContainer const>> boundaries;
+    bool needs_full_layout = false;
+    m_layout_root->for_each_in_inclusive_subtree([&](Layout::Node const& node) {
+        if (!node.needs_layout_update())
+            return TraversalDecision::SkipChildrenAndContinue;
+        if (!node.only_descendants_need_layout_update()) {
+            needs_full_layout = true;
+            return TraversalDecision::Break;
+        }
+
+        auto const* box = as_if<Layout::Box>(node);
+        if (!box || !is_relayout_boundary(*box) || !layout_state.try_get(*box))
+            return TraversalDecision::Continue;
+
+        // Everything inside has to be positioned relative to the boundary, or we'd need used values from outside of it.
+        auto has_containing_block_outside = box->for_each_in_subtree([&](Layout::Node const& descendant) {
+            auto containing_block = descendant.containing_block();
+            if (!containing_block || !box->is_inclusive_ancestor_of(*containing_block))
+                return TraversalDecision::Break;
+            return TraversalDecision::Continue;
+        });
+        if (has_containing_block_outside == TraversalDecision::Break)
+            return TraversalDecision::Continue;
+
+        boundaries.append(static_cast<Layout::BlockContainer const&>(*box));
+        return TraversalDecision::SkipChildrenAndContinue;
+    });
+
+    if (needs_full_layout)
+        return false;
+
+    for (auto const& boundary : boundaries) {
+        layout_state.clear_used_values_inside(*boundary);
+
+        auto const& boundary_state = layout_state.get(*boundary);
+        Layout::BlockFormattingContext formatting_context(layout_state, Layout::LayoutMode::Normal, *boundary, nullptr);
+        formatting_context.run(
+            Layout::AvailableSpace(
+                Layout::AvailableSize::make_definite(boundary_state.content_width()),
+                Layout::AvailableSize::make_definite(boundary_state.content_height())));
+        formatting_context.parent_context_did_dimension_child_root_box();
+    }
+
+    dbgln_if(UPDATE_LAYOUT_DEBUG, "RELAYOUT {} boundaries", boundaries.size());
+    return true;
+}
+
 void Document::update_layout(UpdateLayoutReason reason)
 {
     auto navigable = this->navigable();
@@ -1333,12 +1451,17 @@ void Document::update_layout(UpdateLayoutReason reason)
 
         set_needs_full_layout_tree_update(false);
 
+        // The tree builder may have replaced any number of layout nodes, so none of the previous used values can be trusted.
+        m_retained_layout_state = nullptr;
+
         if constexpr (UPDATE_LAYOUT_DEBUG) {
             dbgln("TREEBUILD {} µs", timer.elapsed_time().to_microseconds());
         }
     }
 
+    u32 layout_index = 0;
     m_layout_root->for_each_in_inclusive_subtree([&](auto& layout_node) {
+        layout_node.set_layout_index({}, layout_index++);
         layout_node.recompute_containing_block({});
         return TraversalDecision::Continue;
     });
@@ -1371,9 +1494,13 @@ void Document::update_layout(UpdateLayoutReason reason)
         return TraversalDecision::Continue;
     });
 
-    Layout::LayoutState layout_state;
+    if (lay_out_changed_relayout_boundaries(viewport_rect)) {
+        ++m_layout_counters.relayout_boundary_layouts;
+    } else {
+        ++m_layout_counters.full_layouts;
+        m_retained_layout_state = make<Layout::LayoutState>();
+        auto& layout_state = *m_retained_layout_state;
 
-    {
         Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
 
         auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
@@ -1392,7 +1519,7 @@ void Document::update_layout(UpdateLayoutReason reason)
                 Layout::AvailableSize::make_definite(viewport_rect.height())));
     }
 
-    layout_state.commit(*m_layout_root);
+    m_retained_layout_state->commit(*m_layout_root);
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
@@ -1553,8 +1680,13 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    // NOTE: Cached styles depend on the viewport and the parent styles of this pass, so they only live for the duration of it.
+    style_computer().clear_matched_properties_cache();
     auto invalidation = update_style_recursively(*this, style_computer(), false);
-    if (!invalidation.is_none())
+    style_computer().clear_matched_properties_cache();
+    // NOTE: Elements that only need to be repainted have already invalidated the parts of the display list that paint
+    //       them, everything else invalidates all of it.
+    if (invalidation.relayout || invalidation.rebuild_layout_tree)
         invalidate_display_list();
     if (invalidation.rebuild_stacking_context_tree)
         invalidate_stacking_context_tree();
@@ -3719,6 +3851,7 @@ void Document::set_page_showing(bool page_showing)
 
 void Document::invalidate_stacking_context_tree()
 {
+    invalidate_display_list();
     if (auto* paintable_box = this->paintable_box())
         paintable_box->invalidate_stacking_context();
 }
@@ -6384,6 +6517,7 @@ void Document::set_needs_display(CSSPixelRect const&, InvalidateDisplayList shou
 void Document::invalidate_display_list()
 {
     m_cached_display_list.clear();
+    ++m_retained_display_list_generation;
 
     auto navigable = this->navigable();
     if (!navigable)
@@ -6394,6 +6528,47 @@ void Document::invalidate_display_list()
     }
 }
 
+void Document::invalidate_display_list_for_paintable(Painting::Paintable const& paintable)
+{
+    // NOTE: The viewport paints things on behalf of the whole document, like focus and selection.
+    if (&paintable == this->paintable()) {
+        invalidate_display_list();
+        return;
+    }
+
+    m_cached_display_list.clear();
+
+    for (auto const* ancestor = &paintable; ancestor; ancestor = ancestor->parent()) {
+        if (!ancestor->is_paintable_box())
+            continue;
+        if (auto* stacking_context = const_cast<Painting::PaintableBox&>(static_cast<Painting::PaintableBox const&>(*ancestor)).stacking_context()) {
+            stacking_context->invalidate_retained_display_list();
+            break;
+        }
+    }
+
+    // Stacking contexts inside the paintable replay the clips it applies to its contents (overflow clip rects and
+    // border radii) as part of their own commands, so they have to be recorded again as well.
+    paintable.for_each_in_subtree([](Painting::Paintable const& descendant) {
+        if (!descendant.is_paintable_box())
+            return TraversalDecision::Continue;
+        if (auto* stacking_context = const_cast<Painting::PaintableBox&>(static_cast<Painting::PaintableBox const&>(descendant)).stacking_context())
+            stacking_context->invalidate_retained_display_list();
+        return TraversalDecision::Continue;
+    });
+
+    auto navigable = this->navigable();
+    if (!navigable)
+        return;
+
+    if (auto container = navigable->container()) {
+        if (auto const* container_paintable = container->paintable())
+            container->document().invalidate_display_list_for_paintable(*container_paintable);
+        else
+            container->document().invalidate_display_list();
+    }
+}
+
 RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
 {
     if (m_cached_display_list && m_cached_display_list_paint_config == config) {
@@ -6440,8 +6615,16 @@ RefPtr<Painting::DisplayList> Document::record_display_list(PaintConfig config)
         VERIFY_NOT_REACHED();
     }
 
-    Web::PaintContext context(display_list_recorder, page().palette(), page().client().device_pixels_per_css_pixel());
+    auto device_pixels_per_css_pixel = page().client().device_pixels_per_css_pixel();
+    if (m_retained_display_list_paint_config != config || m_retained_display_list_device_pixels_per_css_pixel != device_pixels_per_css_pixel) {
+        ++m_retained_display_list_generation;
+        m_retained_display_list_paint_config = config;
+        m_retained_display_list_device_pixels_per_css_pixel = device_pixels_per_css_pixel;
+    }
+
+    Web::PaintContext context(display_list_recorder, page().palette(), device_pixels_per_css_pixel);
     context.set_device_viewport_rect(viewport_rect);
+    context.set_retained_display_list_generation(m_retained_display_list_generation);
     context.set_should_show_line_box_borders(config.should_show_line_box_borders);
     context.set_should_paint_overlay(config.paint_overlay);
     context.set_has_focus(config.has_focus);
@@ -6567,6 +6750,13 @@ ElementByIdMap& Document::element_by_id() const
     return *m_element_by_id;
 }
 
+CSS::SelectorListCache& Document::query_selector_cache()
+{
+    if (!m_query_selector_cache)
+        m_query_selector_cache = make<CSS::SelectorListCache>(256);
+    return *m_query_selector_cache;
+}
+
 GC::Ptr<Element> ElementByIdMap::get(FlyString const& element_id) const
 {
     if (auto elements = m_map.get(element_id); elements.has_value() && !elements->is_empty()) {
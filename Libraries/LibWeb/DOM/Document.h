@@ -335,6 +335,13 @@ public:
     void update_style();
     void update_layout(UpdateLayoutReason);
     void update_paint_and_hit_testing_properties_if_needed();
+
+    struct LayoutCounters {
+        u64 full_layouts { 0 };
+        u64 relayout_boundary_layouts { 0 };
+    };
+    LayoutCounters const& layout_counters() const { return m_layout_counters; }
+    void reset_layout_counters() { m_layout_counters = {}; }
     void update_animated_style_if_needed();
 
     void invalidate_layout_tree(InvalidateLayoutTreeReason);
@@ -846,6 +853,9 @@ public:
     RefPtr<Painting::DisplayList> record_display_list(PaintConfig);
 
     void invalidate_display_list();
+    // Only the stacking context that paints the given paintable, the ones containing it and the ones inside it record
+    // their commands again, the rest of the display list is reused.
+    void invalidate_display_list_for_paintable(Painting::Paintable const&);
 
     Unicode::Segmenter& grapheme_segmenter() const;
     Unicode::Segmenter& word_segmenter() const;
@@ -911,6 +921,9 @@ public:
 
     ElementByIdMap& element_by_id() const;
 
+    // Selectors parsed for querySelector() and friends, by their text.
+    CSS::SelectorListCache& query_selector_cache();
+
     auto& script_blocking_style_sheet_set() { return m_script_blocking_style_sheet_set; }
     auto const& script_blocking_style_sheet_set() const { return m_script_blocking_style_sheet_set; }
 
@@ -927,6 +940,7 @@ private:
     void invalidate_style_of_elements_affected_by_has();
 
     void tear_down_layout_tree();
+    bool lay_out_changed_relayout_boundaries(CSSPixelRect const& viewport_rect);
 
     void update_active_element();
 
@@ -972,11 +986,17 @@ private:
     WeakPtr<HTML::BrowsingContext> m_browsing_context;
     URL::URL m_url;
     mutable OwnPtr<ElementByIdMap> m_element_by_id;
+    OwnPtr<CSS::SelectorListCache> m_query_selector_cache;
 
     GC::Ptr<HTML::Window> m_window;
 
     GC::Ptr<Layout::Viewport> m_layout_root;
 
+    // The used values from the last layout, kept so that the next one can lay out just the relayout boundaries that
+    // changed. Only valid for as long as the layout tree isn't rebuilt.
+    OwnPtr<Layout::LayoutState> m_retained_layout_state;
+    LayoutCounters m_layout_counters;
+
     GC::Ptr<Node> m_hovered_node;
     GC::Ptr<Node> m_inspected_node;
     GC::Ptr<Node> m_highlighted_node;
@@ -1240,6 +1260,11 @@ private:
     Optional<PaintConfig> m_cached_display_list_paint_config;
     RefPtr<Painting::DisplayList> m_cached_display_list;
 
+    // Bumped whenever the commands retained by stacking contexts can no longer be reused.
+    u64 m_retained_display_list_generation { 0 };
+    Optional<PaintConfig> m_retained_display_list_paint_config;
+    double m_retained_display_list_device_pixels_per_css_pixel { 0 };
+
     mutable OwnPtr<Unicode::Segmenter> m_grapheme_segmenter;
     mutable OwnPtr<Unicode::Segmenter> m_word_segmenter;
 
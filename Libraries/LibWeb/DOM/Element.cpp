@@ -770,6 +770,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_inherited_style()
         return invalidation;
 
     layout_node()->apply_style(*computed_properties);
+    if (invalidation.repaint && paintable())
+        paintable()->set_needs_display();
     return invalidation;
 }
 
@@ -6,9 +6,13 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/SelectorEngine.h>
+#include <LibWeb/CSS/SelectorListCache.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
 #include <LibWeb/DOM/HTMLCollection.h>
 #include <LibWeb/DOM/NodeOperations.h>
 #include <LibWeb/DOM/ParentNode.h>
@@ -43,6 +47,80 @@ static bool contains_named_namespace(const CSS::SelectorList& selectors)
     return false;
 }
 
+// Returns the only simple selector of a selector list like "#id", ".class" or "tag", which can be matched without going
+// through the selector engine.
+static CSS::Selector::SimpleSelector const* single_simple_selector(CSS::SelectorList const& selectors)
+{
+    if (selectors.size() != 1 || selectors.first()->compound_selectors().size() != 1)
+        return nullptr;
+    auto const& simple_selectors = selectors.first()->compound_selectors().first().simple_selectors;
+    if (simple_selectors.size() != 1)
+        return nullptr;
+
+    auto const& simple_selector = simple_selectors.first();
+    switch (simple_selector.type) {
+    case CSS::Selector::SimpleSelector::Type::Id:
+    case CSS::Selector::SimpleSelector::Type::Class:
+        return &simple_selector;
+    case CSS::Selector::SimpleSelector::Type::TagName: {
+        // NOTE: Without a style sheet to declare a default namespace, these match elements in any namespace.
+        auto namespace_type = simple_selector.qualified_name().namespace_type;
+        if (namespace_type == CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Default || namespace_type == CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Any)
+            return &simple_selector;
+        return nullptr;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+// NOTE: This must give the same result as SelectorEngine::matches() for the selectors single_simple_selector() returns.
+static bool matches_simple_selector(CSS::Selector::SimpleSelector const& simple_selector, Element const& element)
+{
+    switch (simple_selector.type) {
+    case CSS::Selector::SimpleSelector::Type::Id:
+        return simple_selector.name() == element.id();
+    case CSS::Selector::SimpleSelector::Type::Class:
+        return element.has_class(simple_selector.name(), element.document().in_quirks_mode() ? CaseSensitivity::CaseInsensitive : CaseSensitivity::CaseSensitive);
+    case CSS::Selector::SimpleSelector::Type::TagName: {
+        auto const& name = simple_selector.qualified_name().name;
+        if (element.document().document_type() == Document::Type::HTML && element.namespace_uri() == Namespace::HTML)
+            return name.lowercase_name == element.local_name();
+        return name.name == element.local_name();
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// Like for_each_in_subtree_of_type<Element>(), but keeps the ancestor filter (if any) filled with the ancestors of the
+// element being visited.
+template<typename Callback>
+static void for_each_element_in_subtree(ParentNode& root, CSS::AncestorFilter* ancestor_filter, Callback callback)
+{
+    Node* current = root.first_child();
+    while (current) {
+        if (is<Element>(*current) && callback(static_cast<Element&>(*current)) == TraversalDecision::Break)
+            return;
+
+        if (auto* first_child = current->first_child()) {
+            if (ancestor_filter && is<Element>(*current))
+                ancestor_filter->push_ancestor(static_cast<Element&>(*current));
+            current = first_child;
+            continue;
+        }
+
+        while (current != &root && !current->next_sibling()) {
+            current = current->parent();
+            if (ancestor_filter && current != &root && is<Element>(*current))
+                ancestor_filter->pop_ancestor(static_cast<Element&>(*current));
+        }
+        if (current == &root)
+            return;
+        current = current->next_sibling();
+    }
+}
+
 enum class ReturnMatches {
     First,
     All,
@@ -52,36 +130,77 @@ static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_m
 {
     // To scope-match a selectors string selectors against a node, run these steps:
     // 1. Let s be the result of parse a selector selectors.
-    auto maybe_selectors = parse_selector(CSS::Parser::ParsingParams { node.document() }, selector_text);
+    auto& selector_cache = node.document().query_selector_cache();
+    auto maybe_selectors = selector_cache.get(selector_text);
+    if (!maybe_selectors.has_value()) {
+        maybe_selectors = parse_selector(CSS::Parser::ParsingParams { node.document() }, selector_text);
+
+        // 2. If s is failure, then throw a "SyntaxError" DOMException.
+        if (!maybe_selectors.has_value())
+            return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_string);
 
-    // 2. If s is failure, then throw a "SyntaxError" DOMException.
-    if (!maybe_selectors.has_value())
-        return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_string);
+        // "Note: Support for namespaces within selectors is not planned and will not be added."
+        if (contains_named_namespace(*maybe_selectors))
+            return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_string);
 
-    auto selectors = maybe_selectors.value();
+        selector_cache.set(selector_text, *maybe_selectors);
+    }
 
-    // "Note: Support for namespaces within selectors is not planned and will not be added."
-    if (contains_named_namespace(selectors))
-        return WebIDL::SyntaxError::create(node.realm(), "Failed to parse selector"_string);
+    auto selectors = maybe_selectors.release_value();
 
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     GC::Ptr<Element> single_result;
     Vector<GC::Root<Node>> results;
+    auto add_result = [&](Element& element) {
+        if (return_matches == ReturnMatches::First) {
+            single_result = &element;
+            return TraversalDecision::Break;
+        }
+        results.append(element);
+        return TraversalDecision::Continue;
+    };
+
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
-    node.for_each_in_subtree_of_type<Element>([&](auto& element) {
-        for (auto& selector : selectors) {
-            SelectorEngine::MatchContext context;
-            if (SelectorEngine::matches(selector, element, nullptr, context, {}, node)) {
-                if (return_matches == ReturnMatches::First) {
-                    single_result = &element;
-                    return TraversalDecision::Break;
-                }
-                results.append(element);
-                break;
+    if (auto const* simple_selector = single_simple_selector(selectors)) {
+        // Connected documents and shadow roots know where all of their elements with a given ID are.
+        if (simple_selector->type == CSS::Selector::SimpleSelector::Type::Id && node.is_connected() && (node.root().is_document() || node.root().is_shadow_root())) {
+            auto& root = node.root();
+            auto& element_by_id = root.is_document() ? static_cast<Document&>(root).element_by_id() : static_cast<ShadowRoot&>(root).element_by_id();
+            element_by_id.for_each_element_with_id(simple_selector->name(), [&](Element& element) {
+                if (!element.is_descendant_of(node))
+                    return IterationDecision::Continue;
+                return add_result(element) == TraversalDecision::Break ? IterationDecision::Break : IterationDecision::Continue;
+            });
+        } else {
+            node.for_each_in_subtree_of_type<Element>([&](auto& element) {
+                if (!matches_simple_selector(*simple_selector, element))
+                    return TraversalDecision::Continue;
+                return add_result(element);
+            });
+        }
+    } else {
+        // NOTE: Class names are hashed as they're written, so quirks mode (where they're matched case-insensitively)
+        //       can't use the ancestor filter.
+        OwnPtr<CSS::AncestorFilter> ancestor_filter;
+        if (!node.document().in_quirks_mode() && any_of(selectors, [](auto const& selector) { return selector->can_use_ancestor_filter(); })) {
+            ancestor_filter = make<CSS::AncestorFilter>();
+            for (auto* ancestor = static_cast<Node*>(&node); ancestor; ancestor = ancestor->parent()) {
+                if (is<Element>(*ancestor))
+                    ancestor_filter->push_ancestor(static_cast<Element&>(*ancestor));
             }
         }
-        return TraversalDecision::Continue;
-    });
+
+        for_each_element_in_subtree(node, ancestor_filter.ptr(), [&](Element& element) {
+            for (auto& selector : selectors) {
+                if (ancestor_filter && selector->can_use_ancestor_filter() && ancestor_filter->should_reject(selector))
+                    continue;
+                SelectorEngine::MatchContext context;
+                if (SelectorEngine::matches(selector, element, nullptr, context, {}, node))
+                    return add_result(element);
+            }
+            return TraversalDecision::Continue;
+        });
+    }
 
     if (return_matches == ReturnMatches::First)
         return { single_result };
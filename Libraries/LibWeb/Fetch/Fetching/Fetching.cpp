@@ -2299,6 +2299,11 @@ WebIDL::ExceptionOr<GC::Ref<PendingResponse>> nonstandard_resource_loader_file_o
     load_request.set_page(page);
     load_request.set_method(ByteString::copy(request->method()));
 
+    // NOTE: RequestServer keeps a persistent HTTP cache that is shared between all of its clients. Pass along the
+    //       network partition key so that it can partition that cache in the same way as our in-process one.
+    if (auto partition_key = Infrastructure::determine_the_network_partition_key(*request); partition_key.has_value() && !partition_key->top_level_origin.is_opaque())
+        load_request.set_cache_partition_key(partition_key->top_level_origin.serialize().to_byte_string());
+
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
 
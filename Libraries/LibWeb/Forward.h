@@ -285,6 +285,7 @@ class Screen;
 class ScreenOrientation;
 class ScrollbarGutterStyleValue;
 class Selector;
+class SelectorListCache;
 class ShadowStyleValue;
 class ShorthandStyleValue;
 class Size;
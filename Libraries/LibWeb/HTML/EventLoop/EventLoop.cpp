@@ -214,6 +214,22 @@ void EventLoop::process()
         for (auto& win : same_loop_windows()) {
             win->start_an_idle_period();
         }
+
+        // OPTIMIZATION: Spend some of the idle period on the garbage collection work that was left for later, i.e. marking
+        //               if the heap is in the middle of an incremental collection, and sweeping. The slices are kept
+        //               short, so that we can react quickly to anything that happens meanwhile.
+        if (heap().is_incremental_marking_in_progress() || heap().is_lazy_sweeping_in_progress()) {
+            static constexpr double maximum_garbage_collection_slice_ms = 5;
+            auto idle_time_left = compute_deadline() - HighResolutionTime::unsafe_shared_current_time();
+            if (idle_time_left > 0) {
+                auto budget = AK::Duration::from_microseconds(static_cast<i64>(min(idle_time_left, maximum_garbage_collection_slice_ms) * 1000));
+                auto has_work_left = heap().is_incremental_marking_in_progress()
+                    ? heap().perform_incremental_marking_step(budget)
+                    : heap().perform_lazy_sweeping_step(budget);
+                if (has_work_left || heap().is_lazy_sweeping_in_progress())
+                    schedule();
+            }
+        }
     }
 
     // If there are eligible tasks in the queue, schedule a new round of processing. :^)
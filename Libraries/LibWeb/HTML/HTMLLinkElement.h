@@ -68,6 +68,12 @@ private:
 
     // ^HTMLElement
     virtual void visit_edges(Cell::Visitor&) override;
+    virtual void finalize() override
+    {
+        Base::finalize();
+        // NOTE: Only weak pointers to the cell itself are revoked by the garbage collector, not those to the clients.
+        Weakable<ResourceClient>::revoke_weak_ptrs();
+    }
     virtual bool is_implicitly_potentially_render_blocking() const override;
 
     struct LinkProcessingOptions {
@@ -5,6 +5,7 @@
  */
 
 #include <LibCore/EventLoop.h>
+#include <LibCore/System.h>
 #include <LibWeb/HTML/RenderingThread.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Painting/BackingStore.h>
@@ -35,6 +36,16 @@ void RenderingThread::start(DisplayListPlayerType display_list_player_type)
 {
     m_display_list_player_type = display_list_player_type;
     VERIFY(m_skia_player);
+
+    if (Painting::g_enable_tiled_rasterization) {
+        if (auto thread_count = Core::System::hardware_concurrency(); thread_count > 1) {
+            if (auto tiled_rasterizer = Painting::TiledRasterizer::create(thread_count); !tiled_rasterizer.is_error())
+                m_tiled_rasterizer = tiled_rasterizer.release_value();
+            else
+                dbgln("Failed to create tiled rasterizer: {}", tiled_rasterizer.error());
+        }
+    }
+
     m_thread = Threading::Thread::construct([this] {
         rendering_thread_loop();
         return static_cast<intptr_t>(0);
@@ -65,7 +76,8 @@ void RenderingThread::rendering_thread_loop()
         }
 
         auto painting_surface = painting_surface_for_backing_store(task->backing_store);
-        m_skia_player->execute(*task->display_list, task->scroll_state_snapshot, painting_surface);
+        if (!rasterize_tiled_if_possible(*task->display_list, task->scroll_state_snapshot, painting_surface))
+            m_skia_player->execute(*task->display_list, task->scroll_state_snapshot, painting_surface);
         if (m_exit)
             break;
         m_main_thread_event_loop.deferred_invoke([callback = move(task->callback)] {
@@ -81,6 +93,25 @@ void RenderingThread::enqueue_rendering_task(NonnullRefPtr<Painting::DisplayList
     m_rendering_task_ready_wake_condition.signal();
 }
 
+bool RenderingThread::rasterize_tiled_if_possible(Painting::DisplayList& display_list, Painting::ScrollStateSnapshot const& scroll_state_snapshot, Gfx::PaintingSurface& painting_surface)
+{
+    if (!m_tiled_rasterizer)
+        return false;
+
+    // Small surfaces are not worth the cost of handing tiles to other threads.
+    auto size = painting_surface.size();
+    if (size.width() <= Painting::TiledRasterizer::tile_size && size.height() <= Painting::TiledRasterizer::tile_size)
+        return false;
+
+    if (!Painting::TiledRasterizer::can_rasterize(display_list))
+        return false;
+
+    if (!m_tiled_rasterizer->rasterize(display_list, scroll_state_snapshot, painting_surface))
+        return false;
+    painting_surface.flush();
+    return true;
+}
+
 NonnullRefPtr<Gfx::PaintingSurface> RenderingThread::painting_surface_for_backing_store(Painting::BackingStore& backing_store)
 {
     auto& bitmap = backing_store.bitmap();
@@ -15,6 +15,7 @@
 #include <LibWeb/Forward.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
 
 namespace Web::HTML {
 
@@ -35,11 +36,13 @@ public:
 private:
     void rendering_thread_loop();
     NonnullRefPtr<Gfx::PaintingSurface> painting_surface_for_backing_store(Painting::BackingStore& backing_store);
+    bool rasterize_tiled_if_possible(Painting::DisplayList&, Painting::ScrollStateSnapshot const&, Gfx::PaintingSurface&);
 
     Core::EventLoop& m_main_thread_event_loop;
     DisplayListPlayerType m_display_list_player_type;
 
     OwnPtr<Painting::DisplayListPlayerSkia> m_skia_player;
+    OwnPtr<Painting::TiledRasterizer> m_tiled_rasterizer;
     RefPtr<Gfx::SkiaBackendContext> m_skia_backend_context;
 
     RefPtr<Threading::Thread> m_thread;
@@ -7,6 +7,7 @@
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -239,6 +240,36 @@ void Internals::set_browser_zoom(double factor)
     page().client().page_did_set_browser_zoom(factor);
 }
 
+JS::Object* Internals::get_style_recalc_counters()
+{
+    auto const& counters = window().associated_document().style_computer().style_recalc_counters();
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("styleRecalcs"_fly_string, JS::Value(static_cast<double>(counters.style_recalcs)), JS::default_attributes);
+    result->define_direct_property("sharedStyles"_fly_string, JS::Value(static_cast<double>(counters.shared_styles)), JS::default_attributes);
+    result->define_direct_property("matchedPropertiesCacheHits"_fly_string, JS::Value(static_cast<double>(counters.matched_properties_cache_hits)), JS::default_attributes);
+    result->define_direct_property("matchedPropertiesCacheMisses"_fly_string, JS::Value(static_cast<double>(counters.matched_properties_cache_misses)), JS::default_attributes);
+    return result;
+}
+
+void Internals::reset_style_recalc_counters()
+{
+    window().associated_document().style_computer().reset_style_recalc_counters();
+}
+
+JS::Object* Internals::get_layout_counters()
+{
+    auto const& counters = window().associated_document().layout_counters();
+    auto result = JS::Object::create(realm(), nullptr);
+    result->define_direct_property("fullLayouts"_fly_string, JS::Value(static_cast<double>(counters.full_layouts)), JS::default_attributes);
+    result->define_direct_property("relayoutBoundaryLayouts"_fly_string, JS::Value(static_cast<double>(counters.relayout_boundary_layouts)), JS::default_attributes);
+    return result;
+}
+
+void Internals::reset_layout_counters()
+{
+    window().associated_document().reset_layout_counters();
+}
+
 bool Internals::headless()
 {
     return page().client().is_headless();
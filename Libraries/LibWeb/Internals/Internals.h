@@ -58,6 +58,12 @@ public:
 
     void set_browser_zoom(double factor);
 
+    JS::Object* get_style_recalc_counters();
+    void reset_style_recalc_counters();
+
+    JS::Object* get_layout_counters();
+    void reset_layout_counters();
+
     bool headless();
 
 private:
@@ -22,32 +22,85 @@ LayoutState::~LayoutState()
 {
 }
 
-LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+LayoutState::UsedValues const* LayoutState::try_get(Node const& node) const
 {
-    if (auto* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
-        return *used_values;
+    auto layout_index = node.layout_index();
+    VERIFY(layout_index != Node::no_layout_index);
+
+    auto page_index = layout_index / used_values_page_size;
+    if (page_index >= m_used_values_pages.size() || !m_used_values_pages[page_index])
+        return nullptr;
+    return (*m_used_values_pages[page_index])[layout_index % used_values_page_size];
+}
 
+LayoutState::UsedValues*& LayoutState::used_values_slot(Node const& node)
+{
+    auto layout_index = node.layout_index();
+    VERIFY(layout_index != Node::no_layout_index);
+
+    auto page_index = layout_index / used_values_page_size;
+    if (page_index >= m_used_values_pages.size())
+        m_used_values_pages.resize(page_index + 1);
+    auto& page = m_used_values_pages[page_index];
+    if (!page)
+        page = make<UsedValuesPage>();
+    return (*page)[layout_index % used_values_page_size];
+}
+
+LayoutState::UsedValues& LayoutState::create_used_values(NodeWithStyle const& node)
+{
+    // NOTE: This may create used values for the containing block chain first, so we have to do it before taking a slot.
     auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    // Start out small, as most states are only used to find the intrinsic size of a single box.
+    if (m_used_values_chunks.is_empty() || m_used_values_chunks.last()->size() == m_used_values_chunks.last()->capacity()) {
+        auto chunk = make<Vector<UsedValues>>();
+        chunk->ensure_capacity(m_used_values_chunks.is_empty() ? 16 : min<size_t>(m_used_values_chunks.last()->capacity() * 2, 4096));
+        m_used_values_chunks.append(move(chunk));
+    }
+    auto& chunk = *m_used_values_chunks.last();
+    chunk.unchecked_append(UsedValues {});
+    auto& used_values = chunk.last();
+    used_values.set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
+
+    auto& slot = used_values_slot(node);
+    VERIFY(!slot);
+    slot = &used_values;
+    ++m_used_values_count;
+    return used_values;
+}
+
+LayoutState::UsedValues& LayoutState::get_mutable(NodeWithStyle const& node)
+{
+    if (auto* used_values = try_get_mutable(node))
+        return *used_values;
+    return create_used_values(node);
 }
 
 LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
 {
-    if (auto const* used_values = used_values_per_layout_node.get(node).value_or(nullptr))
+    if (auto const* used_values = try_get(node))
         return *used_values;
+    return const_cast<LayoutState&>(*this).create_used_values(node);
+}
 
-    auto const* containing_block_used_values = node.is_viewport() ? nullptr : &get(*node.containing_block());
+void LayoutState::clear_used_values_inside(Box const& box)
+{
+    box.for_each_in_subtree([&](Node const& node) {
+        auto& slot = used_values_slot(node);
+        if (slot) {
+            slot = nullptr;
+            --m_used_values_count;
+            ++m_cleared_used_values_count;
+        }
+        return TraversalDecision::Continue;
+    });
 
-    auto new_used_values = adopt_own(*new UsedValues);
-    auto* new_used_values_ptr = new_used_values.ptr();
-    new_used_values->set_node(const_cast<NodeWithStyle&>(node), containing_block_used_values);
-    const_cast<LayoutState*>(this)->used_values_per_layout_node.set(node, move(new_used_values));
-    return *new_used_values_ptr;
+    auto* used_values = try_get_mutable(box);
+    if (!used_values)
+        return;
+    used_values->line_boxes.clear();
+    used_values->clear_floating_descendants();
 }
 
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
@@ -142,8 +195,7 @@ void LayoutState::resolve_relative_positions()
 {
     // This function resolves relative position offsets of fragments that belong to inline paintables.
     // It runs *after* the paint tree has been constructed, so it modifies paintable node & fragment offsets directly.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         for (auto& paintable : node.paintables()) {
@@ -172,7 +224,7 @@ void LayoutState::resolve_relative_positions()
                 const_cast<Painting::PaintableFragment&>(fragment).set_offset(fragment.offset().translated(offset));
             }
         }
-    }
+    });
 }
 
 static void build_paint_tree(Node& node, Painting::Paintable* parent_paintable = nullptr)
@@ -232,7 +284,7 @@ void LayoutState::commit(Box& root)
                 auto& inline_node = const_cast<InlineNode&>(static_cast<InlineNode const&>(*parent));
                 auto line_paintable = inline_node.create_paintable_for_line_with_index(line_index);
                 line_paintable->add_fragment(fragment);
-                if (auto const* used_values = used_values_per_layout_node.get(inline_node).value_or(nullptr))
+                if (auto const* used_values = try_get(inline_node))
                     transfer_box_model_metrics(line_paintable->box_model(), *used_values);
                 if (!inline_node_paintables.contains(line_paintable.ptr())) {
                     inline_node_paintables.set(line_paintable.ptr());
@@ -244,8 +296,7 @@ void LayoutState::commit(Box& root)
         return false;
     };
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         auto paintable = node.create_paintable();
@@ -288,7 +339,9 @@ void LayoutState::commit(Box& root)
 
             if (used_values.computed_svg_path().has_value() && is<Painting::SVGPathPaintable>(paintable_box)) {
                 auto& svg_geometry_paintable = static_cast<Painting::SVGPathPaintable&>(paintable_box);
-                svg_geometry_paintable.set_computed_path(move(*used_values.computed_svg_path()));
+                // NOTE: The path is copied rather than moved, as the used values may be committed again after an
+                //       incremental relayout.
+                svg_geometry_paintable.set_computed_path(*used_values.computed_svg_path());
             }
 
             if (node.display().is_grid_inside()) {
@@ -296,7 +349,7 @@ void LayoutState::commit(Box& root)
                 paintable_box.set_used_values_for_grid_template_rows(used_values.grid_template_rows());
             }
         }
-    }
+    });
 
     // Create paintables for inline nodes without fragments to make possible querying their geometry.
     for (auto& inline_node : inline_nodes) {
@@ -306,19 +359,18 @@ void LayoutState::commit(Box& root)
         auto line_paintable = inline_node->create_paintable_for_line_with_index(0);
         inline_node->add_paintable(line_paintable);
         inline_node_paintables.set(line_paintable.ptr());
-        if (auto const* used_values = used_values_per_layout_node.get(*inline_node).value_or(nullptr))
+        if (auto const* used_values = try_get(*inline_node))
             transfer_box_model_metrics(line_paintable->box_model(), *used_values);
     }
 
     // Resolve relative positions for regular boxes (not line box fragments):
     // NOTE: This needs to occur before fragments are transferred into the corresponding inline paintables, because
     //       after this transfer, the containing_line_box_fragment will no longer be valid.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
         if (!node.is_box())
-            continue;
+            return;
 
         auto& paintable = as<Painting::PaintableBox>(*node.first_paintable());
         CSSPixelPoint offset;
@@ -344,7 +396,7 @@ void LayoutState::commit(Box& root)
             offset.translate_by(inset.left, inset.top);
         }
         paintable.set_offset(offset);
-    }
+    });
 
     for (auto* text_node : text_nodes) {
         text_node->add_paintable(text_node->create_paintable());
@@ -400,10 +452,9 @@ void LayoutState::commit(Box& root)
     }
 
     // Measure overflow in scroll containers.
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         if (!used_values.node().is_box())
-            continue;
+            return;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
         measure_scrollable_overflow(box);
 
@@ -413,10 +464,9 @@ void LayoutState::commit(Box& root)
         auto& paintable_box = const_cast<Painting::PaintableBox&>(*box.paintable_box());
         if (!paintable_box.scroll_offset().is_zero())
             paintable_box.set_scroll_offset(paintable_box.scroll_offset());
-    }
+    });
 
-    for (auto& it : used_values_per_layout_node) {
-        auto& used_values = *it.value;
+    for_each_used_values([&](UsedValues& used_values) {
         auto& node = used_values.node();
         for (auto& paintable : node.paintables()) {
             Painting::PaintableBox* paintable_box = nullptr;
@@ -454,7 +504,7 @@ void LayoutState::commit(Box& root)
                 paintable_box->set_sticky_insets(move(sticky_insets));
             }
         }
-    }
+    });
 }
 
 void LayoutState::UsedValues::set_node(NodeWithStyle& node, UsedValues const* containing_block_used_values)
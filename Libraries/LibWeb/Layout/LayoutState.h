@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/HashMap.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
@@ -135,6 +136,7 @@ struct LayoutState {
 
         void add_floating_descendant(Box const& box) { m_floating_descendants.set(&box); }
         auto const& floating_descendants() const { return m_floating_descendants; }
+        void clear_floating_descendants() { m_floating_descendants.clear(); }
 
         void set_override_borders_data(Painting::PaintableBox::BordersDataWithElementKind const& override_borders_data) { m_override_borders_data = override_borders_data; }
         auto const& override_borders_data() const { return m_override_borders_data; }
@@ -205,10 +207,47 @@ struct LayoutState {
     UsedValues& get_mutable(NodeWithStyle const&);
     UsedValues const& get(NodeWithStyle const&) const;
 
-    OrderedHashMap<GC::Ref<Layout::Node const>, NonnullOwnPtr<UsedValues>> used_values_per_layout_node;
+    // Unlike get(), these don't create used values for nodes that don't have any yet.
+    UsedValues const* try_get(Node const&) const;
+    UsedValues* try_get_mutable(Node const& node) { return const_cast<UsedValues*>(try_get(node)); }
+
+    // Visits the used values of every node in this state, in the order they were created.
+    template<typename Callback>
+    void for_each_used_values(Callback callback)
+    {
+        for (size_t chunk_index = 0; chunk_index < m_used_values_chunks.size(); ++chunk_index) {
+            auto& chunk = *m_used_values_chunks[chunk_index];
+            for (size_t i = 0; i < chunk.size(); ++i) {
+                // NOTE: Used values that were cleared stay behind in their chunk, but no longer belong to their node.
+                if (try_get(chunk[i].node()) == &chunk[i])
+                    callback(chunk[i]);
+            }
+        }
+    }
+
+    // Forgets the used values of everything inside the given box, which can then be laid out again on its own.
+    // The used values of the box itself are kept, as they were decided by the formatting context around it.
+    void clear_used_values_inside(Box const&);
+
+    size_t used_values_count() const { return m_used_values_count; }
+    size_t cleared_used_values_count() const { return m_cleared_used_values_count; }
 
 private:
     void resolve_relative_positions();
+
+    UsedValues*& used_values_slot(Node const&);
+    UsedValues& create_used_values(NodeWithStyle const&);
+
+    // Used values are looked up by Node::layout_index(), one page of the index space at a time. That way, states for
+    // intrinsic sizing that only see a small part of the tree don't have to allocate a slot for every node in it.
+    static constexpr size_t used_values_page_size = 256;
+    using UsedValuesPage = Array<UsedValues*, used_values_page_size>;
+    Vector<OwnPtr<UsedValuesPage>> m_used_values_pages;
+
+    // The used values themselves live in chunks that are never reallocated, so references to them stay valid.
+    Vector<NonnullOwnPtr<Vector<UsedValues>>> m_used_values_chunks;
+    size_t m_used_values_count { 0 };
+    size_t m_cleared_used_values_count { 0 };
 };
 
 inline CSSPixels clamp_to_max_dimension_value(CSSPixels value)
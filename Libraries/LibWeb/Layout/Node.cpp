@@ -1409,7 +1409,7 @@ void NodeWithStyleAndBoxModelMetrics::visit_edges(Cell::Visitor& visitor)
 
 void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
 {
-    if (m_needs_layout_update)
+    if (m_needs_layout_update && !m_only_descendants_need_layout_update)
         return;
 
     if constexpr (UPDATE_LAYOUT_DEBUG) {
@@ -1420,12 +1420,14 @@ void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
     }
 
     m_needs_layout_update = true;
+    m_only_descendants_need_layout_update = false;
 
     // Mark any anonymous children generated by this node for layout update.
     // NOTE: if this node generated an anonymous parent, all ancestors are indiscriminately marked below.
     for_each_child_of_type<Box>([&](Box& child) {
         if (child.is_anonymous() && !is<TableWrapper>(child)) {
             child.m_needs_layout_update = true;
+            child.m_only_descendants_need_layout_update = false;
         }
         return IterationDecision::Continue;
     });
@@ -1434,6 +1436,7 @@ void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
         if (ancestor->m_needs_layout_update)
             break;
         ancestor->m_needs_layout_update = true;
+        ancestor->m_only_descendants_need_layout_update = true;
     }
 }
 
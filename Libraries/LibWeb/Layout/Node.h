@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/NonnullRefPtr.h>
+#include <AK/NumericLimits.h>
 #include <AK/Vector.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/CSS/StyleValues/ImageStyleValue.h>
@@ -47,7 +48,14 @@ public:
 
     bool needs_layout_update() const { return m_needs_layout_update; }
     void set_needs_layout_update(DOM::SetNeedsLayoutReason);
-    void reset_needs_layout_update() { m_needs_layout_update = false; }
+    void reset_needs_layout_update()
+    {
+        m_needs_layout_update = false;
+        m_only_descendants_need_layout_update = false;
+    }
+
+    // True if this node was only marked for layout update because something inside of it changed.
+    bool only_descendants_need_layout_update() const { return m_needs_layout_update && m_only_descendants_need_layout_update; }
 
     bool is_generated() const { return m_generated_for.has_value(); }
     bool is_generated_for_before_pseudo_element() const { return m_generated_for == CSS::GeneratedPseudoElement::Before; }
@@ -136,6 +144,11 @@ public:
 
     void recompute_containing_block(Badge<DOM::Document>);
 
+    // A dense index into the per-layout storage of LayoutState, assigned in tree order by the document before layout.
+    static constexpr u32 no_layout_index = NumericLimits<u32>::max();
+    u32 layout_index() const { return m_layout_index; }
+    void set_layout_index(Badge<DOM::Document>, u32 layout_index) { m_layout_index = layout_index; }
+
     [[nodiscard]] Box const* static_position_containing_block() const;
     [[nodiscard]] Box* static_position_containing_block() { return const_cast<Box*>(const_cast<Node const*>(this)->static_position_containing_block()); }
 
@@ -227,10 +240,12 @@ private:
     bool m_has_been_wrapped_in_table_wrapper { false };
 
     bool m_needs_layout_update { false };
+    bool m_only_descendants_need_layout_update { false };
 
     Optional<CSS::GeneratedPseudoElement> m_generated_for {};
 
     u32 m_initial_quote_nesting_level { 0 };
+    u32 m_layout_index { no_layout_index };
 };
 
 class NodeWithStyle : public Node {
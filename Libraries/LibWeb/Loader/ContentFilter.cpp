@@ -4,11 +4,15 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/StringBuilder.h>
+#include <AK/BinarySearch.h>
+#include <AK/ByteString.h>
+#include <AK/Queue.h>
 #include <LibWeb/Loader/ContentFilter.h>
 
 namespace Web {
 
+static constexpr u32 root_state = 0;
+
 ContentFilter& ContentFilter::the()
 {
     static ContentFilter filter;
@@ -27,21 +31,127 @@ bool ContentFilter::is_filtered(const URL::URL& url) const
     if (url.scheme() == "data")
         return false;
 
+    if (m_states.is_empty())
+        return false;
+
     auto url_string = url.to_byte_string();
+    return matches_any_pattern(url_string.view());
+}
+
+Optional<u32> ContentFilter::transition(u32 state, u8 byte) const
+{
+    auto const& node = m_states[state];
+    auto edges = m_edges.span().slice(node.first_edge, node.edge_count);
+
+    auto* edge = binary_search(edges, byte, nullptr, [](u8 byte, Edge const& edge) {
+        return static_cast<int>(byte) - static_cast<int>(edge.byte);
+    });
+    if (!edge)
+        return {};
+    return edge->target;
+}
+
+bool ContentFilter::matches_any_pattern(StringView haystack) const
+{
+    u32 state = root_state;
+    if (m_states[state].is_match)
+        return true;
+
+    for (auto byte : haystack.bytes()) {
+        Optional<u32> next;
+        while (!(next = transition(state, byte)).has_value() && state != root_state)
+            state = m_states[state].failure;
 
-    for (auto& pattern : m_patterns) {
-        if (url_string.find(pattern.text).has_value())
+        state = next.value_or(root_state);
+        if (m_states[state].is_match)
             return true;
     }
+
     return false;
 }
 
 ErrorOr<void> ContentFilter::set_patterns(ReadonlySpan<String> patterns)
 {
-    m_patterns.clear_with_capacity();
+    m_states.clear_with_capacity();
+    m_edges.clear_with_capacity();
+
+    if (patterns.is_empty())
+        return {};
+
+    // First build a plain trie of all patterns. Children are kept sorted by byte so that they can be flattened into
+    // m_edges as-is and binary searched when matching.
+    struct TrieNode {
+        Vector<Edge> children;
+        bool is_match { false };
+    };
+    Vector<TrieNode> trie;
+    TRY(trie.try_empend());
 
     for (auto const& pattern : patterns) {
-        TRY(m_patterns.try_empend(pattern));
+        u32 node = root_state;
+
+        for (auto byte : pattern.bytes()) {
+            auto& children = trie[node].children;
+
+            size_t insertion_index = 0;
+            auto* existing = binary_search(children, byte, &insertion_index, [](u8 byte, Edge const& edge) {
+                return static_cast<int>(byte) - static_cast<int>(edge.byte);
+            });
+            if (existing) {
+                node = existing->target;
+                continue;
+            }
+
+            if (insertion_index < children.size() && children[insertion_index].byte < byte)
+                ++insertion_index;
+
+            auto child = static_cast<u32>(trie.size());
+            TRY(children.try_insert(insertion_index, Edge { byte, child }));
+            TRY(trie.try_empend());
+            node = child;
+        }
+
+        trie[node].is_match = true;
+    }
+
+    TRY(m_states.try_ensure_capacity(trie.size()));
+    for (auto& node : trie) {
+        State state;
+        state.first_edge = static_cast<u32>(m_edges.size());
+        state.edge_count = static_cast<u16>(node.children.size());
+        state.is_match = node.is_match;
+        TRY(m_edges.try_extend(node.children));
+        m_states.unchecked_append(state);
+    }
+
+    // Then compute failure links breadth-first. A state matches if any pattern ends at it, or at any state on its
+    // failure chain, so we can stop at the first matching state while scanning.
+    Queue<u32> queue;
+    queue.enqueue(root_state);
+
+    while (!queue.is_empty()) {
+        auto state = queue.dequeue();
+        auto const& node = m_states[state];
+
+        for (u32 i = 0; i < node.edge_count; ++i) {
+            auto const& edge = m_edges[node.first_edge + i];
+            auto& child = m_states[edge.target];
+
+            if (state == root_state) {
+                child.failure = root_state;
+            } else {
+                auto fallback = m_states[state].failure;
+                Optional<u32> next;
+                while (!(next = transition(fallback, edge.byte)).has_value() && fallback != root_state)
+                    fallback = m_states[fallback].failure;
+                child.failure = next.value_or(root_state);
+            }
+
+            if (m_states[child.failure].is_match)
+                child.is_match = true;
+
+            queue.enqueue(edge.target);
+        }
     }
 
     return {};
@@ -26,10 +26,23 @@ private:
     ContentFilter();
     ~ContentFilter();
 
-    struct Pattern {
-        String text;
+    bool matches_any_pattern(StringView) const;
+    Optional<u32> transition(u32 state, u8 byte) const;
+
+    // All patterns are compiled into a single Aho-Corasick automaton, so that a URL can be matched against the whole
+    // filter list in one pass over its bytes, regardless of how many patterns there are.
+    struct Edge {
+        u8 byte { 0 };
+        u32 target { 0 };
     };
-    Vector<Pattern> m_patterns;
+    struct State {
+        u32 first_edge { 0 };
+        u16 edge_count { 0 };
+        bool is_match { false };
+        u32 failure { 0 };
+    };
+    Vector<State> m_states;
+    Vector<Edge> m_edges;
     bool m_filtering_enabled { true };
 };
 
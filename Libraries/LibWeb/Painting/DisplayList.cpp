@@ -61,96 +61,130 @@ void DisplayListPlayer::execute_impl(DisplayList& display_list, ScrollStateSnaps
     VERIFY(!m_surfaces.is_empty());
 
     for (size_t command_index = 0; command_index < commands.size(); command_index++) {
-        auto scroll_frame_id = commands[command_index].scroll_frame_id;
         auto command = commands[command_index].command;
+        apply_scroll_offsets(command, commands[command_index].scroll_frame_id, scroll_state, device_pixels_per_css_pixel);
+        execute_command(command);
+    }
 
-        if (command.has<PaintScrollBar>()) {
-            auto& paint_scroll_bar = command.get<PaintScrollBar>();
-            auto scroll_offset = scroll_state.own_offset_for_frame_with_id(paint_scroll_bar.scroll_frame_id);
-            if (paint_scroll_bar.vertical) {
-                auto offset = scroll_offset.y() * paint_scroll_bar.scroll_size;
-                paint_scroll_bar.thumb_rect.translate_by(0, -offset.to_int() * device_pixels_per_css_pixel);
-            } else {
-                auto offset = scroll_offset.x() * paint_scroll_bar.scroll_size;
-                paint_scroll_bar.thumb_rect.translate_by(-offset.to_int() * device_pixels_per_css_pixel, 0);
-            }
-        }
+    if (surface)
+        flush();
+}
+
+Vector<Command> DisplayListPlayer::resolve_commands(DisplayList const& display_list, ScrollStateSnapshot const& scroll_state)
+{
+    auto const& commands = display_list.commands();
+    Vector<Command> resolved_commands;
+    resolved_commands.ensure_capacity(commands.size());
+    for (auto const& item : commands) {
+        auto command = item.command;
+        apply_scroll_offsets(command, item.scroll_frame_id, scroll_state, display_list.device_pixels_per_css_pixel());
+        resolved_commands.unchecked_append(move(command));
+    }
+    return resolved_commands;
+}
+
+void DisplayListPlayer::execute_resolved_commands(ReadonlySpan<Command> commands, Gfx::PaintingSurface& surface, Gfx::IntPoint origin)
+{
+    m_surfaces.append(surface);
+    ScopeGuard guard = [&surfaces = m_surfaces] { (void)surfaces.take_last(); };
+
+    save({});
+    translate(Translate { -origin });
+    for (auto const& command : commands)
+        execute_command(command);
+    restore({});
 
-        if (scroll_frame_id.has_value()) {
-            auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id.value());
-            auto scroll_offset = cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
-            command.visit(
-                [&](auto& command) {
-                    if constexpr (requires { command.translate_by(scroll_offset); }) {
-                        command.translate_by(scroll_offset);
-                    }
-                });
+    flush();
+}
+
+void DisplayListPlayer::apply_scroll_offsets(Command& command, Optional<i32> scroll_frame_id, ScrollStateSnapshot const& scroll_state, double device_pixels_per_css_pixel)
+{
+    if (command.has<PaintScrollBar>()) {
+        auto& paint_scroll_bar = command.get<PaintScrollBar>();
+        auto scroll_offset = scroll_state.own_offset_for_frame_with_id(paint_scroll_bar.scroll_frame_id);
+        if (paint_scroll_bar.vertical) {
+            auto offset = scroll_offset.y() * paint_scroll_bar.scroll_size;
+            paint_scroll_bar.thumb_rect.translate_by(0, -offset.to_int() * device_pixels_per_css_pixel);
+        } else {
+            auto offset = scroll_offset.x() * paint_scroll_bar.scroll_size;
+            paint_scroll_bar.thumb_rect.translate_by(-offset.to_int() * device_pixels_per_css_pixel, 0);
         }
+    }
 
-        auto bounding_rect = command_bounding_rectangle(command);
-        if (bounding_rect.has_value() && (bounding_rect->is_empty() || would_be_fully_clipped_by_painter(*bounding_rect))) {
-            // Any clip or mask that's located outside of the visible region is equivalent to a simple clip-rect,
-            // so replace it with one to avoid doing unnecessary work.
-            if (command_is_clip_or_mask(command)) {
-                if (command.has<AddClipRect>()) {
-                    add_clip_rect(command.get<AddClipRect>());
-                } else {
-                    add_clip_rect({ bounding_rect.release_value() });
+    if (scroll_frame_id.has_value()) {
+        auto cumulative_offset = scroll_state.cumulative_offset_for_frame_with_id(scroll_frame_id.value());
+        auto scroll_offset = cumulative_offset.to_type<double>().scaled(device_pixels_per_css_pixel).to_type<int>();
+        command.visit(
+            [&](auto& command) {
+                if constexpr (requires { command.translate_by(scroll_offset); }) {
+                    command.translate_by(scroll_offset);
                 }
+            });
+    }
+}
+
+void DisplayListPlayer::execute_command(Command const& command)
+{
+    auto bounding_rect = command_bounding_rectangle(command);
+    if (bounding_rect.has_value() && (bounding_rect->is_empty() || would_be_fully_clipped_by_painter(*bounding_rect))) {
+        // Any clip or mask that's located outside of the visible region is equivalent to a simple clip-rect,
+        // so replace it with one to avoid doing unnecessary work.
+        if (command_is_clip_or_mask(command)) {
+            if (command.has<AddClipRect>()) {
+                add_clip_rect(command.get<AddClipRect>());
+            } else {
+                add_clip_rect({ bounding_rect.release_value() });
             }
-            continue;
         }
+        return;
+    }
 
 #define HANDLE_COMMAND(command_type, executor_method) \
     if (command.has<command_type>()) {                \
         executor_method(command.get<command_type>()); \
     }
 
-        // clang-format off
-        HANDLE_COMMAND(DrawGlyphRun, draw_glyph_run)
-        else HANDLE_COMMAND(FillRect, fill_rect)
-        else HANDLE_COMMAND(DrawPaintingSurface, draw_painting_surface)
-        else HANDLE_COMMAND(DrawScaledImmutableBitmap, draw_scaled_immutable_bitmap)
-        else HANDLE_COMMAND(DrawRepeatedImmutableBitmap, draw_repeated_immutable_bitmap)
-        else HANDLE_COMMAND(AddClipRect, add_clip_rect)
-        else HANDLE_COMMAND(Save, save)
-        else HANDLE_COMMAND(SaveLayer, save_layer)
-        else HANDLE_COMMAND(Restore, restore)
-        else HANDLE_COMMAND(Translate, translate)
-        else HANDLE_COMMAND(PushStackingContext, push_stacking_context)
-        else HANDLE_COMMAND(PopStackingContext, pop_stacking_context)
-        else HANDLE_COMMAND(PaintLinearGradient, paint_linear_gradient)
-        else HANDLE_COMMAND(PaintRadialGradient, paint_radial_gradient)
-        else HANDLE_COMMAND(PaintConicGradient, paint_conic_gradient)
-        else HANDLE_COMMAND(PaintOuterBoxShadow, paint_outer_box_shadow)
-        else HANDLE_COMMAND(PaintInnerBoxShadow, paint_inner_box_shadow)
-        else HANDLE_COMMAND(PaintTextShadow, paint_text_shadow)
-        else HANDLE_COMMAND(FillRectWithRoundedCorners, fill_rect_with_rounded_corners)
-        else HANDLE_COMMAND(FillPathUsingColor, fill_path_using_color)
-        else HANDLE_COMMAND(FillPathUsingPaintStyle, fill_path_using_paint_style)
-        else HANDLE_COMMAND(StrokePathUsingColor, stroke_path_using_color)
-        else HANDLE_COMMAND(StrokePathUsingPaintStyle, stroke_path_using_paint_style)
-        else HANDLE_COMMAND(DrawEllipse, draw_ellipse)
-        else HANDLE_COMMAND(FillEllipse, fill_ellipse)
-        else HANDLE_COMMAND(DrawLine, draw_line)
-        else HANDLE_COMMAND(ApplyBackdropFilter, apply_backdrop_filter)
-        else HANDLE_COMMAND(DrawRect, draw_rect)
-        else HANDLE_COMMAND(DrawTriangleWave, draw_triangle_wave)
-        else HANDLE_COMMAND(AddRoundedRectClip, add_rounded_rect_clip)
-        else HANDLE_COMMAND(AddMask, add_mask)
-        else HANDLE_COMMAND(PaintScrollBar, paint_scrollbar)
-        else HANDLE_COMMAND(PaintNestedDisplayList, paint_nested_display_list)
-        else HANDLE_COMMAND(ApplyOpacity, apply_opacity)
-        else HANDLE_COMMAND(ApplyCompositeAndBlendingOperator, apply_composite_and_blending_operator)
-        else HANDLE_COMMAND(ApplyFilters, apply_filters)
-        else HANDLE_COMMAND(ApplyTransform, apply_transform)
-        else HANDLE_COMMAND(ApplyMaskBitmap, apply_mask_bitmap)
-        else VERIFY_NOT_REACHED();
-        // clang-format on
-    }
-
-    if (surface)
-        flush();
+    // clang-format off
+    HANDLE_COMMAND(DrawGlyphRun, draw_glyph_run)
+    else HANDLE_COMMAND(FillRect, fill_rect)
+    else HANDLE_COMMAND(DrawPaintingSurface, draw_painting_surface)
+    else HANDLE_COMMAND(DrawScaledImmutableBitmap, draw_scaled_immutable_bitmap)
+    else HANDLE_COMMAND(DrawRepeatedImmutableBitmap, draw_repeated_immutable_bitmap)
+    else HANDLE_COMMAND(AddClipRect, add_clip_rect)
+    else HANDLE_COMMAND(Save, save)
+    else HANDLE_COMMAND(SaveLayer, save_layer)
+    else HANDLE_COMMAND(Restore, restore)
+    else HANDLE_COMMAND(Translate, translate)
+    else HANDLE_COMMAND(PushStackingContext, push_stacking_context)
+    else HANDLE_COMMAND(PopStackingContext, pop_stacking_context)
+    else HANDLE_COMMAND(PaintLinearGradient, paint_linear_gradient)
+    else HANDLE_COMMAND(PaintRadialGradient, paint_radial_gradient)
+    else HANDLE_COMMAND(PaintConicGradient, paint_conic_gradient)
+    else HANDLE_COMMAND(PaintOuterBoxShadow, paint_outer_box_shadow)
+    else HANDLE_COMMAND(PaintInnerBoxShadow, paint_inner_box_shadow)
+    else HANDLE_COMMAND(PaintTextShadow, paint_text_shadow)
+    else HANDLE_COMMAND(FillRectWithRoundedCorners, fill_rect_with_rounded_corners)
+    else HANDLE_COMMAND(FillPathUsingColor, fill_path_using_color)
+    else HANDLE_COMMAND(FillPathUsingPaintStyle, fill_path_using_paint_style)
+    else HANDLE_COMMAND(StrokePathUsingColor, stroke_path_using_color)
+    else HANDLE_COMMAND(StrokePathUsingPaintStyle, stroke_path_using_paint_style)
+    else HANDLE_COMMAND(DrawEllipse, draw_ellipse)
+    else HANDLE_COMMAND(FillEllipse, fill_ellipse)
+    else HANDLE_COMMAND(DrawLine, draw_line)
+    else HANDLE_COMMAND(ApplyBackdropFilter, apply_backdrop_filter)
+    else HANDLE_COMMAND(DrawRect, draw_rect)
+    else HANDLE_COMMAND(DrawTriangleWave, draw_triangle_wave)
+    else HANDLE_COMMAND(AddRoundedRectClip, add_rounded_rect_clip)
+    else HANDLE_COMMAND(AddMask, add_mask)
+    else HANDLE_COMMAND(PaintScrollBar, paint_scrollbar)
+    else HANDLE_COMMAND(PaintNestedDisplayList, paint_nested_display_list)
+    else HANDLE_COMMAND(ApplyOpacity, apply_opacity)
+    else HANDLE_COMMAND(ApplyCompositeAndBlendingOperator, apply_composite_and_blending_operator)
+    else HANDLE_COMMAND(ApplyFilters, apply_filters)
+    else HANDLE_COMMAND(ApplyTransform, apply_transform)
+    else HANDLE_COMMAND(ApplyMaskBitmap, apply_mask_bitmap)
+    else VERIFY_NOT_REACHED();
+    // clang-format on
 }
 
 }
@@ -28,11 +28,21 @@ public:
 
     void execute(DisplayList&, ScrollStateSnapshot const&, RefPtr<Gfx::PaintingSurface>);
 
+    // Returns a copy of the display list's commands with the scroll offsets from the snapshot applied, so they can be
+    // replayed any number of times (and by multiple players at once) without further mutation.
+    static Vector<Command> resolve_commands(DisplayList const&, ScrollStateSnapshot const&);
+
+    // Replays the region of the page that starts at `origin` onto `surface`.
+    void execute_resolved_commands(ReadonlySpan<Command>, Gfx::PaintingSurface&, Gfx::IntPoint origin);
+
 protected:
     Gfx::PaintingSurface& surface() const { return m_surfaces.last(); }
     void execute_impl(DisplayList&, ScrollStateSnapshot const& scroll_state, RefPtr<Gfx::PaintingSurface>);
 
 private:
+    static void apply_scroll_offsets(Command&, Optional<i32> scroll_frame_id, ScrollStateSnapshot const&, double device_pixels_per_css_pixel);
+    void execute_command(Command const&);
+
     virtual void flush() = 0;
     virtual void draw_glyph_run(DrawGlyphRun const&) = 0;
     virtual void fill_rect(FillRect const&) = 0;
@@ -18,10 +18,7 @@ DisplayListRecorder::~DisplayListRecorder() = default;
 
 void DisplayListRecorder::append(Command&& command)
 {
-    Optional<i32> scroll_frame_id;
-    if (!m_scroll_frame_id_stack.is_empty())
-        scroll_frame_id = m_scroll_frame_id_stack.last();
-    m_command_list.append(move(command), scroll_frame_id);
+    m_command_list.append(move(command), current_scroll_frame_id());
 }
 
 void DisplayListRecorder::paint_nested_display_list(RefPtr<DisplayList> display_list, ScrollStateSnapshot&& scroll_state_snapshot, Gfx::IntRect rect)
@@ -298,6 +295,13 @@ void DisplayListRecorder::pop_scroll_frame_id()
     (void)m_scroll_frame_id_stack.take_last();
 }
 
+Optional<i32> DisplayListRecorder::current_scroll_frame_id() const
+{
+    if (m_scroll_frame_id_stack.is_empty())
+        return {};
+    return m_scroll_frame_id_stack.last();
+}
+
 void DisplayListRecorder::push_stacking_context(PushStackingContextParams params)
 {
     append(PushStackingContext {
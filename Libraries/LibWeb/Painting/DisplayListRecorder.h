@@ -112,6 +112,7 @@ public:
 
     void push_scroll_frame_id(Optional<i32> id);
     void pop_scroll_frame_id();
+    Optional<i32> current_scroll_frame_id() const;
 
     void save();
     void save_layer();
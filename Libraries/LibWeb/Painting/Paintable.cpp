@@ -162,7 +162,7 @@ void Paintable::set_needs_display(InvalidateDisplayList should_invalidate_displa
 {
     auto& document = const_cast<DOM::Document&>(this->document());
     if (should_invalidate_display_list == InvalidateDisplayList::Yes)
-        document.invalidate_display_list();
+        document.invalidate_display_list_for_paintable(*this);
 
     auto* containing_block = this->containing_block();
     if (!containing_block)
@@ -300,7 +300,89 @@ static Gfx::FloatMatrix4x4 matrix_with_scaled_translation(Gfx::FloatMatrix4x4 ma
     return matrix;
 }
 
+void StackingContext::invalidate_retained_display_list()
+{
+    for (auto* stacking_context = this; stacking_context; stacking_context = stacking_context->m_parent)
+        stacking_context->m_retained_display_list.clear();
+}
+
 void StackingContext::paint(PaintContext& context) const
+{
+    auto& display_list = context.display_list_recorder().display_list();
+    auto start = display_list.commands().size();
+
+    auto generation = context.retained_display_list_generation();
+    if (generation.has_value() && m_retained_display_list.has_value() && m_retained_display_list->generation == *generation
+        && m_retained_display_list->scroll_frame_id == context.display_list_recorder().current_scroll_frame_id()) {
+        replay_retained_display_list(display_list);
+    } else {
+        paint_with_effects(context);
+        if (generation.has_value())
+            retain_display_list(context, start);
+    }
+
+    // NOTE: Contexts without a generation record into display lists of their own, which we can't refer to later.
+    if (generation.has_value())
+        m_last_recorded_range = RecordedRange { context.paint_generation_id(), start, display_list.commands().size() };
+}
+
+void StackingContext::retain_display_list(PaintContext& context, size_t start) const
+{
+    auto const& commands = context.display_list_recorder().display_list().commands();
+    auto end = commands.size();
+
+    // Find the children that were painted as part of this stacking context, in the order they were painted.
+    Vector<StackingContext const*> painted_children;
+    for (auto const* child : m_children) {
+        if (!child->m_last_recorded_range.has_value() || child->m_last_recorded_range->paint_generation_id != context.paint_generation_id())
+            continue;
+        // A child we can't replay means we can't be replayed either.
+        if (!child->m_retained_display_list.has_value() || child->m_retained_display_list->generation != *context.retained_display_list_generation()) {
+            m_retained_display_list.clear();
+            return;
+        }
+        painted_children.append(child);
+    }
+    quick_sort(painted_children, [](auto const* a, auto const* b) {
+        return a->m_last_recorded_range->start < b->m_last_recorded_range->start;
+    });
+
+    RetainedDisplayList retained_display_list {
+        .generation = *context.retained_display_list_generation(),
+        .scroll_frame_id = context.display_list_recorder().current_scroll_frame_id(),
+        .items = {},
+    };
+    retained_display_list.items.ensure_capacity(end - start + painted_children.size());
+
+    auto index = start;
+    auto retain_commands_until = [&](size_t until) {
+        for (; index < until; ++index)
+            retained_display_list.items.unchecked_append(commands[index]);
+    };
+    for (auto const* child : painted_children) {
+        retain_commands_until(child->m_last_recorded_range->start);
+        retained_display_list.items.unchecked_append(child);
+        index = child->m_last_recorded_range->end;
+    }
+    retain_commands_until(end);
+
+    m_retained_display_list = move(retained_display_list);
+}
+
+void StackingContext::replay_retained_display_list(DisplayList& display_list) const
+{
+    for (auto const& item : m_retained_display_list->items) {
+        item.visit(
+            [&](DisplayList::CommandListItem const& command) {
+                display_list.append(Command { command.command }, command.scroll_frame_id);
+            },
+            [&](StackingContext const* child) {
+                child->replay_retained_display_list(display_list);
+            });
+    }
+}
+
+void StackingContext::paint_with_effects(PaintContext& context) const
 {
     auto opacity = paintable_box().computed_values().opacity();
     if (opacity == 0.0f)
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/Variant.h>
 #include <AK/Vector.h>
 #include <LibGfx/Matrix4x4.h>
+#include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/Paintable.h>
 
 namespace Web::Painting {
@@ -46,6 +48,10 @@ public:
 
     void set_last_paint_generation_id(u64 generation_id);
 
+    // Drops the commands retained from the last time this stacking context was painted, along with those of every
+    // stacking context that contains it, since their commands include ours.
+    void invalidate_retained_display_list();
+
 private:
     GC::Ref<PaintableBox> m_paintable;
     StackingContext* const m_parent { nullptr };
@@ -56,8 +62,29 @@ private:
     Vector<GC::Ref<PaintableBox const>> m_positioned_descendants_and_stacking_contexts_with_stack_level_0;
     Vector<GC::Ref<PaintableBox const>> m_non_positioned_floating_descendants;
 
+    // The commands this stacking context recorded directly, interleaved with the child stacking contexts that were
+    // painted in between. Children are replayed from their own retained commands, so a stacking context is only
+    // retained while all of its children are.
+    struct RetainedDisplayList {
+        u64 generation { 0 };
+        Optional<i32> scroll_frame_id;
+        Vector<Variant<DisplayList::CommandListItem, StackingContext const*>> items;
+    };
+    mutable Optional<RetainedDisplayList> m_retained_display_list;
+
+    // Where the commands of this stacking context ended up in the display list that was recorded last.
+    struct RecordedRange {
+        u64 paint_generation_id { 0 };
+        size_t start { 0 };
+        size_t end { 0 };
+    };
+    mutable Optional<RecordedRange> m_last_recorded_range;
+
     static void paint_child(PaintContext&, StackingContext const&);
+    void paint_with_effects(PaintContext&) const;
     void paint_internal(PaintContext&) const;
+    void retain_display_list(PaintContext&, size_t start) const;
+    void replay_retained_display_list(DisplayList&) const;
 };
 
 }
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <core/SkPixmap.h>
+#include <core/SkSurface.h>
+
+#include <AK/Atomic.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
+
+namespace Web::Painting {
+
+bool g_enable_tiled_rasterization = false;
+
+ErrorOr<NonnullOwnPtr<TiledRasterizer>> TiledRasterizer::create(size_t thread_count)
+{
+    // The thread that asks for a display list to be rasterized works on tiles too, so it doesn't need a worker.
+    VERIFY(thread_count > 1);
+
+    Vector<NonnullOwnPtr<Worker>> workers;
+    TRY(workers.try_ensure_capacity(thread_count - 1));
+    for (size_t i = 0; i < thread_count - 1; ++i)
+        workers.unchecked_append(TRY(Worker::create("Rasterizer"sv)));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) TiledRasterizer(move(workers)));
+}
+
+TiledRasterizer::TiledRasterizer(Vector<NonnullOwnPtr<Worker>> workers)
+    : m_workers(move(workers))
+{
+}
+
+TiledRasterizer::~TiledRasterizer() = default;
+
+bool TiledRasterizer::can_rasterize(DisplayList const& display_list)
+{
+    for (auto const& item : display_list.commands()) {
+        auto const& command = item.command;
+
+        // Filters sample pixels around the ones they produce, which may belong to a neighboring tile.
+        if (command.has<ApplyBackdropFilter>() || command.has<ApplyFilters>())
+            return false;
+
+        // Nested display lists, painting surfaces and paint styles are not safe to share between threads.
+        if (command.has<PaintNestedDisplayList>() || command.has<AddMask>() || command.has<DrawPaintingSurface>())
+            return false;
+        if (command.has<FillPathUsingPaintStyle>() || command.has<StrokePathUsingPaintStyle>())
+            return false;
+    }
+    return true;
+}
+
+bool TiledRasterizer::rasterize(DisplayList& display_list, ScrollStateSnapshot const& scroll_state, Gfx::PaintingSurface& target)
+{
+    SkPixmap target_pixels;
+    if (!target.sk_surface().peekPixels(&target_pixels))
+        return false;
+
+    auto commands = DisplayListPlayer::resolve_commands(display_list, scroll_state);
+
+    Vector<Gfx::IntRect> tiles;
+    auto target_rect = target.rect();
+    for (int y = target_rect.top(); y < target_rect.bottom(); y += tile_size) {
+        for (int x = target_rect.left(); x < target_rect.right(); x += tile_size)
+            tiles.append(Gfx::IntRect { x, y, tile_size, tile_size }.intersected(target_rect));
+    }
+
+    // Tiles are handed out one at a time, so threads that get cheap tiles move on to the next one.
+    Atomic<size_t> next_tile_index { 0 };
+    auto rasterize_tiles = [&]() -> ErrorOr<void> {
+        DisplayListPlayerSkia player;
+        auto tile_surface = Gfx::PaintingSurface::create_with_size(nullptr, { tile_size, tile_size }, Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied);
+        SkPixmap tile_pixels;
+        auto has_tile_pixels = tile_surface->sk_surface().peekPixels(&tile_pixels);
+        VERIFY(has_tile_pixels);
+
+        while (true) {
+            auto tile_index = next_tile_index.fetch_add(1);
+            if (tile_index >= tiles.size())
+                return {};
+            auto const& tile = tiles[tile_index];
+
+            SkPixmap target_tile_pixels;
+            auto has_target_tile_pixels = target_pixels.extractSubset(&target_tile_pixels, SkIRect::MakeXYWH(tile.x(), tile.y(), tile.width(), tile.height()));
+            VERIFY(has_target_tile_pixels);
+
+            // The display list paints on top of what is already in the target, so the tile starts out with that.
+            // NOTE: Tiles along the right and bottom edges may be smaller than the tile surface. Copies between the two
+            //       are clipped to the smaller of them.
+            target_tile_pixels.readPixels(tile_pixels);
+            player.execute_resolved_commands(commands, *tile_surface, tile.location());
+            tile_pixels.readPixels(target_tile_pixels);
+        }
+    };
+
+    size_t tile_count = tiles.size();
+    size_t workers_to_start = min(m_workers.size(), tile_count > 0 ? tile_count - 1 : 0);
+    for (size_t i = 0; i < workers_to_start; ++i) {
+        auto started = m_workers[i]->start_task(rasterize_tiles);
+        VERIFY(started);
+    }
+
+    MUST(rasterize_tiles());
+
+    for (size_t i = 0; i < workers_to_start; ++i)
+        MUST(m_workers[i]->wait_until_task_is_finished());
+
+    return true;
+}
+
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibThreading/WorkerThread.h>
+#include <LibWeb/Painting/DisplayList.h>
+
+namespace Web::Painting {
+
+extern bool g_enable_tiled_rasterization;
+
+// Rasterizes display lists on the CPU by splitting the target surface into tiles. Each tile is replayed into a surface
+// of its own on a pool of worker threads, and then copied into the target surface.
+class TiledRasterizer {
+    AK_MAKE_NONCOPYABLE(TiledRasterizer);
+    AK_MAKE_NONMOVABLE(TiledRasterizer);
+
+public:
+    static constexpr int tile_size = 256;
+
+    static ErrorOr<NonnullOwnPtr<TiledRasterizer>> create(size_t thread_count);
+    ~TiledRasterizer();
+
+    // Whether every command in the display list only touches the pixels within its own tile, and can be replayed
+    // concurrently with the other tiles.
+    static bool can_rasterize(DisplayList const&);
+
+    // Returns false if the surface is not CPU-backed, in which case nothing has been painted.
+    bool rasterize(DisplayList&, ScrollStateSnapshot const&, Gfx::PaintingSurface&);
+
+private:
+    using Worker = Threading::WorkerThread<Error>;
+
+    explicit TiledRasterizer(Vector<NonnullOwnPtr<Worker>>);
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+};
+
+}
@@ -108,11 +108,15 @@ void Application::initialize(Main::Arguments const& arguments)
     bool disable_site_isolation = false;
     bool enable_idl_tracing = false;
     bool enable_http_cache = false;
+    bool enable_http_disk_cache = false;
     bool enable_autoplay = false;
     bool expose_internals_object = false;
     bool force_cpu_painting = false;
+    bool enable_tiled_rasterization = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
+    bool enable_incremental_garbage_collection = false;
+    bool enable_generational_garbage_collection = false;
     bool disable_scrollbar_painting = false;
 
     Core::ArgsParser args_parser;
@@ -132,11 +136,15 @@ void Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(disable_site_isolation, "Disable site isolation", "disable-site-isolation");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
+    args_parser.add_option(enable_http_disk_cache, "Enable persistent HTTP disk cache", "enable-http-disk-cache");
     args_parser.add_option(enable_autoplay, "Enable multimedia autoplay", "enable-autoplay");
     args_parser.add_option(expose_internals_object, "Expose internals object", "expose-internals-object");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
+    args_parser.add_option(enable_tiled_rasterization, "Rasterize CPU painted pages in tiles on multiple threads", "enable-tiled-rasterization");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation", 'g');
+    args_parser.add_option(enable_incremental_garbage_collection, "Mark the JS heap incrementally during idle periods", "enable-incremental-gc");
+    args_parser.add_option(enable_generational_garbage_collection, "Collect short-lived JS heap cells separately from the rest of the heap", "enable-generational-gc");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical scrollbars on the main viewport", "disable-scrollbar-painting");
     args_parser.add_option(dns_server_address, "Set the DNS server address", "dns-server", 0, "host|address");
     args_parser.add_option(dns_server_port, "Set the DNS server port", "dns-port", 0, "port (default: 53 or 853 if --dot)");
@@ -184,6 +192,7 @@ void Application::initialize(Main::Arguments const& arguments)
         .allow_popups = allow_popups ? AllowPopups::Yes : AllowPopups::No,
         .disable_scripting = disable_scripting ? DisableScripting::Yes : DisableScripting::No,
         .disable_sql_database = disable_sql_database ? DisableSQLDatabase::Yes : DisableSQLDatabase::No,
+        .enable_http_disk_cache = enable_http_disk_cache ? EnableHTTPDiskCache::Yes : EnableHTTPDiskCache::No,
         .debug_helper_process = move(debug_process_type),
         .profile_helper_process = move(profile_process_type),
         .dns_settings = (dns_server_address.has_value()
@@ -207,9 +216,12 @@ void Application::initialize(Main::Arguments const& arguments)
         .enable_http_cache = enable_http_cache ? EnableHTTPCache::Yes : EnableHTTPCache::No,
         .expose_internals_object = expose_internals_object ? ExposeInternalsObject::Yes : ExposeInternalsObject::No,
         .force_cpu_painting = force_cpu_painting ? ForceCPUPainting::Yes : ForceCPUPainting::No,
+        .enable_tiled_rasterization = enable_tiled_rasterization ? EnableTiledRasterization::Yes : EnableTiledRasterization::No,
         .force_fontconfig = force_fontconfig ? ForceFontconfig::Yes : ForceFontconfig::No,
         .enable_autoplay = enable_autoplay ? EnableAutoplay::Yes : EnableAutoplay::No,
         .collect_garbage_on_every_allocation = collect_garbage_on_every_allocation ? CollectGarbageOnEveryAllocation::Yes : CollectGarbageOnEveryAllocation::No,
+        .enable_incremental_garbage_collection = enable_incremental_garbage_collection ? EnableIncrementalGarbageCollection::Yes : EnableIncrementalGarbageCollection::No,
+        .enable_generational_garbage_collection = enable_generational_garbage_collection ? EnableGenerationalGarbageCollection::Yes : EnableGenerationalGarbageCollection::No,
         .paint_viewport_scrollbars = disable_scrollbar_painting ? PaintViewportScrollbars::No : PaintViewportScrollbars::Yes,
     };
 
@@ -112,10 +112,16 @@ static ErrorOr<NonnullRefPtr<WebView::WebContentClient>> launch_web_content_proc
         arguments.append("--expose-internals-object"sv);
     if (web_content_options.force_cpu_painting == WebView::ForceCPUPainting::Yes)
         arguments.append("--force-cpu-painting"sv);
+    if (web_content_options.enable_tiled_rasterization == WebView::EnableTiledRasterization::Yes)
+        arguments.append("--enable-tiled-rasterization"sv);
     if (web_content_options.force_fontconfig == WebView::ForceFontconfig::Yes)
         arguments.append("--force-fontconfig"sv);
     if (web_content_options.collect_garbage_on_every_allocation == WebView::CollectGarbageOnEveryAllocation::Yes)
         arguments.append("--collect-garbage-on-every-allocation"sv);
+    if (web_content_options.enable_incremental_garbage_collection == WebView::EnableIncrementalGarbageCollection::Yes)
+        arguments.append("--enable-incremental-gc"sv);
+    if (web_content_options.enable_generational_garbage_collection == WebView::EnableGenerationalGarbageCollection::Yes)
+        arguments.append("--enable-generational-gc"sv);
     if (web_content_options.is_headless == WebView::IsHeadless::Yes)
         arguments.append("--headless"sv);
     if (web_content_options.paint_viewport_scrollbars == PaintViewportScrollbars::No)
@@ -209,6 +215,9 @@ ErrorOr<NonnullRefPtr<Requests::RequestClient>> launch_request_server_process()
     for (auto const& certificate : WebView::Application::browser_options().certificates)
         arguments.append(ByteString::formatted("--certificate={}", certificate));
 
+    if (WebView::Application::browser_options().enable_http_disk_cache == WebView::EnableHTTPDiskCache::Yes)
+        arguments.append("--enable-http-disk-cache"sv);
+
     if (auto server = mach_server_name(); server.has_value()) {
         arguments.append("--mach-server-name"sv);
         arguments.append(server.value());
@@ -45,6 +45,11 @@ enum class EnableAutoplay {
     Yes,
 };
 
+enum class EnableHTTPDiskCache {
+    No,
+    Yes,
+};
+
 struct SystemDNS { };
 struct DNSOverTLS {
     ByteString server_address;
@@ -68,6 +73,7 @@ struct BrowserOptions {
     AllowPopups allow_popups { AllowPopups::No };
     DisableScripting disable_scripting { DisableScripting::No };
     DisableSQLDatabase disable_sql_database { DisableSQLDatabase::No };
+    EnableHTTPDiskCache enable_http_disk_cache { EnableHTTPDiskCache::No };
     Optional<ProcessType> debug_helper_process {};
     Optional<ProcessType> profile_helper_process {};
     Optional<ByteString> webdriver_content_ipc_path {};
@@ -110,11 +116,26 @@ enum class ForceCPUPainting {
     Yes,
 };
 
+enum class EnableTiledRasterization {
+    No,
+    Yes,
+};
+
 enum class ForceFontconfig {
     No,
     Yes,
 };
 
+enum class EnableIncrementalGarbageCollection {
+    No,
+    Yes,
+};
+
+enum class EnableGenerationalGarbageCollection {
+    No,
+    Yes,
+};
+
 enum class CollectGarbageOnEveryAllocation {
     No,
     Yes,
@@ -142,9 +163,12 @@ struct WebContentOptions {
     EnableHTTPCache enable_http_cache { EnableHTTPCache::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
     ForceCPUPainting force_cpu_painting { ForceCPUPainting::No };
+    EnableTiledRasterization enable_tiled_rasterization { EnableTiledRasterization::No };
     ForceFontconfig force_fontconfig { ForceFontconfig::No };
     EnableAutoplay enable_autoplay { EnableAutoplay::No };
     CollectGarbageOnEveryAllocation collect_garbage_on_every_allocation { CollectGarbageOnEveryAllocation::No };
+    EnableIncrementalGarbageCollection enable_incremental_garbage_collection { EnableIncrementalGarbageCollection::No };
+    EnableGenerationalGarbageCollection enable_generational_garbage_collection { EnableGenerationalGarbageCollection::No };
     Optional<u16> echo_server_port {};
     IsHeadless is_headless { IsHeadless::No };
     PaintViewportScrollbars paint_viewport_scrollbars { PaintViewportScrollbars::Yes };
@@ -57,6 +57,7 @@ set(SPAM_DEBUG ON)
 set(STYLE_INVALIDATION_DEBUG ON)
 set(SYNTAX_HIGHLIGHTING_DEBUG ON)
 set(TEXTEDITOR_DEBUG ON)
+set(TEXT_SHAPING_DEBUG ON)
 set(TIFF_DEBUG ON)
 set(TIME_ZONE_DEBUG ON)
 set(TLS_DEBUG ON)
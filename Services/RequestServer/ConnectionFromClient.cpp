@@ -21,6 +21,7 @@
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Message.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/RequestClientEndpoint.h>
 #ifdef AK_OS_WINDOWS
 // needed because curl.h includes winsock2.h
@@ -31,6 +32,7 @@
 namespace RequestServer {
 
 ByteString g_default_certificate_path;
+OwnPtr<DiskCache> g_disk_cache;
 static HashMap<int, RefPtr<ConnectionFromClient>> s_connections;
 static IDAllocator s_client_ids;
 static long s_connect_timeout_seconds = 90L;
@@ -115,6 +117,14 @@ struct ConnectionFromClient::ActiveRequest {
     Optional<String> reason_phrase;
     ByteBuffer body;
 
+    // Only set if the response may be stored in, or was revalidated against, the disk cache.
+    Optional<ByteString> cache_partition_key;
+    URL::URL cache_url;
+    HTTP::HeaderMap cache_request_headers;
+    UnixDateTime cache_request_time;
+    OwnPtr<CacheEntryWriter> cache_writer;
+    OwnPtr<CacheEntryReader> cache_entry_being_revalidated;
+
     ActiveRequest(ConnectionFromClient& client, CURLM* multi, CURL* easy, i32 request_id, int writer_fd)
         : multi(multi)
         , easy(easy)
@@ -145,10 +155,35 @@ struct ConnectionFromClient::ActiveRequest {
         long http_status_code = 0;
         auto result = curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_status_code);
         VERIFY(result == CURLE_OK);
+
+        if (cache_partition_key.has_value() && g_disk_cache)
+            cache_writer = g_disk_cache->create_entry(*cache_partition_key, cache_url, cache_request_headers, http_status_code, reason_phrase, headers, cache_request_time);
+
         client->async_headers_became_available(request_id, headers, http_status_code, reason_phrase);
     }
 };
 
+struct ConnectionFromClient::CachedRequest {
+    i32 request_id { 0 };
+    int writer_fd { 0 };
+    NonnullOwnPtr<CacheEntryReader> entry;
+    size_t bytes_written { 0 };
+    RefPtr<Core::Notifier> notifier;
+
+    CachedRequest(i32 request_id, int writer_fd, NonnullOwnPtr<CacheEntryReader> entry)
+        : request_id(request_id)
+        , writer_fd(writer_fd)
+        , entry(move(entry))
+    {
+    }
+
+    ~CachedRequest()
+    {
+        if (writer_fd > 0)
+            MUST(Core::System::close(writer_fd));
+    }
+};
+
 size_t ConnectionFromClient::on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data)
 {
     auto* request = static_cast<ActiveRequest*>(user_data);
@@ -211,6 +246,13 @@ size_t ConnectionFromClient::on_data_received(void* buffer, size_t size, size_t
 
     request->downloaded_so_far += total_size;
 
+    if (request->cache_writer) {
+        if (auto result = request->cache_writer->write_data({ static_cast<u8 const*>(buffer), total_size }); result.is_error()) {
+            dbgln("on_data_received: Not caching {}: {}", request->url, result.error());
+            request->cache_writer.clear();
+        }
+    }
+
     return total_size;
 }
 
@@ -296,6 +338,7 @@ ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transpo
 ConnectionFromClient::~ConnectionFromClient()
 {
     m_active_requests.clear();
+    m_cached_requests.clear();
 
     curl_multi_cleanup(m_curl_multi);
     m_curl_multi = nullptr;
@@ -384,13 +427,49 @@ void ConnectionFromClient::set_use_system_dns()
 }
 
 #ifdef AK_OS_WINDOWS
-void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData)
+void ConnectionFromClient::start_request(i32, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString>)
 {
     VERIFY(0 && "RequestServer::ConnectionFromClient::start_request is not implemented");
 }
 #else
-void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data)
+void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL::URL url, HTTP::HeaderMap request_headers, ByteBuffer request_body, Core::ProxyData proxy_data, Optional<ByteString> cache_partition_key)
 {
+    OwnPtr<CacheEntryReader> cache_entry;
+    HTTP::HeaderMap cache_request_headers;
+
+    if (!g_disk_cache || !DiskCache::is_cacheable_request(method, request_headers))
+        cache_partition_key.clear();
+
+    if (cache_partition_key.has_value()) {
+        cache_entry = g_disk_cache->open_entry(*cache_partition_key, url, request_headers);
+        cache_request_headers = request_headers;
+
+        if (cache_entry && cache_entry->is_fresh()) {
+            auto fds_or_error = Core::System::pipe2(O_NONBLOCK);
+            if (fds_or_error.is_error()) {
+                dbgln("StartRequest: Failed to create pipe: {}", fds_or_error.error());
+                return;
+            }
+
+            auto fds = fds_or_error.release_value();
+            async_request_started(request_id, IPC::File::adopt_fd(fds[0]));
+            start_cached_request(request_id, fds[1], cache_entry.release_nonnull());
+            return;
+        }
+
+        // https://httpwg.org/specs/rfc9111.html#validation.sent
+        // The stored response is stale, so we ask the origin server whether we may still use it.
+        if (cache_entry && cache_entry->has_validators()) {
+            auto const& stored_headers = cache_entry->metadata().response_headers;
+            if (auto etag = stored_headers.get("ETag"sv); etag.has_value())
+                request_headers.set("If-None-Match"sv, *etag);
+            if (auto last_modified = stored_headers.get("Last-Modified"sv); last_modified.has_value())
+                request_headers.set("If-Modified-Since"sv, *last_modified);
+        } else {
+            cache_entry = nullptr;
+        }
+    }
+
     auto host = url.serialized_host().to_byte_string();
 
     m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA })
@@ -399,7 +478,7 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             // FIXME: Implement timing info for DNS lookup failure.
             async_request_finished(request_id, 0, {}, Requests::NetworkError::UnableToResolveHost);
         })
-        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data](auto const& dns_result) mutable {
+        .when_resolved([this, request_id, host = move(host), url = move(url), method = move(method), request_body = move(request_body), request_headers = move(request_headers), proxy_data, cache_partition_key = move(cache_partition_key), cache_request_headers = move(cache_request_headers), cache_entry = move(cache_entry)](auto const& dns_result) mutable {
             if (dns_result->records().is_empty() || dns_result->cached_addresses().is_empty()) {
                 dbgln("StartRequest: DNS lookup failed for '{}'", host);
                 // FIXME: Implement timing info for DNS lookup failure.
@@ -427,6 +506,14 @@ void ConnectionFromClient::start_request(i32 request_id, ByteString method, URL:
             auto request = make<ActiveRequest>(*this, m_curl_multi, easy, request_id, writer_fd);
             request->url = url.to_string();
 
+            if (cache_partition_key.has_value()) {
+                request->cache_partition_key = move(cache_partition_key);
+                request->cache_url = url;
+                request->cache_request_headers = move(cache_request_headers);
+                request->cache_request_time = UnixDateTime::now();
+                request->cache_entry_being_revalidated = move(cache_entry);
+            }
+
             auto set_option = [easy](auto option, auto value) {
                 auto result = curl_easy_setopt(easy, option, value);
                 if (result != CURLE_OK) {
@@ -635,6 +722,25 @@ void ConnectionFromClient::check_active_requests()
         }
 
         auto* request = static_cast<ActiveRequest*>(application_private);
+        auto request_id = request->request_id;
+
+        if (request->cache_entry_being_revalidated && msg->data.result == CURLE_OK) {
+            long http_status_code = 0;
+            auto result = curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &http_status_code);
+            VERIFY(result == CURLE_OK);
+
+            // https://httpwg.org/specs/rfc9111.html#validation.response
+            // A 304 (Not Modified) response status code indicates that the stored response can be updated and reused.
+            if (http_status_code == 304) {
+                g_disk_cache->freshen_entry(*request->cache_entry_being_revalidated, request->headers);
+
+                auto writer_fd = exchange(request->writer_fd, -1);
+                start_cached_request(request_id, writer_fd, request->cache_entry_being_revalidated.release_nonnull());
+
+                m_active_requests.remove(request_id);
+                continue;
+            }
+        }
 
         if (!request->is_connect_only) {
             auto timing_info = get_timing_info_from_curl_easy_handle(msg->easy_handle);
@@ -660,17 +766,81 @@ void ConnectionFromClient::check_active_requests()
                 }
             }
 
-            async_request_finished(request->request_id, request->downloaded_so_far, timing_info, network_error);
+            if (request->cache_writer) {
+                if (request_was_successful) {
+                    if (auto result = request->cache_writer->commit(); result.is_error())
+                        dbgln("ConnectionFromClient: Unable to store {} in the disk cache: {}", request->url, result.error());
+                }
+                request->cache_writer.clear();
+            }
+
+            async_request_finished(request_id, request->downloaded_so_far, timing_info, network_error);
         }
 
-        m_active_requests.remove(request->request_id);
+        m_active_requests.remove(request_id);
     }
 }
 
+void ConnectionFromClient::start_cached_request(i32 request_id, int writer_fd, NonnullOwnPtr<CacheEntryReader> entry)
+{
+    auto const& metadata = entry->metadata();
+    async_headers_became_available(request_id, entry->response_headers_for_reuse(), metadata.status_code, metadata.reason_phrase);
+
+    auto request = make<CachedRequest>(request_id, writer_fd, move(entry));
+
+    // The body is written out of the memory-mapped cache entry as fast as the client is able to read it.
+    request->notifier = Core::Notifier::construct(writer_fd, Core::NotificationType::Write);
+    request->notifier->on_activation = [this, request_id] {
+        write_cached_response_body(request_id);
+    };
+    request->notifier->set_enabled(true);
+
+    m_cached_requests.set(request_id, move(request));
+}
+
+void ConnectionFromClient::write_cached_response_body(i32 request_id)
+{
+    auto maybe_request = m_cached_requests.get(request_id);
+    if (!maybe_request.has_value())
+        return;
+
+    auto& request = *maybe_request.value();
+    auto body = request.entry->body();
+
+    while (request.bytes_written < body.size()) {
+        auto result = Core::System::write(request.writer_fd, body.slice(request.bytes_written));
+        if (result.is_error()) {
+            if (result.error().code() == EAGAIN)
+                return;
+
+            dbgln("write_cached_response_body: write failed: {}", result.error());
+            break;
+        }
+        request.bytes_written += result.value();
+    }
+
+    Optional<Requests::NetworkError> network_error;
+    if (request.bytes_written != body.size())
+        network_error = Requests::NetworkError::Unknown;
+
+    Requests::RequestTimingInfo timing_info;
+    timing_info.encoded_body_size = static_cast<long>(request.bytes_written);
+    async_request_finished(request_id, request.bytes_written, timing_info, network_error);
+
+    // We are being called from the request's notifier, so it must outlive this callback.
+    request.notifier->set_enabled(false);
+    Core::deferred_invoke([self = NonnullRefPtr { *this }, request_id] {
+        self->m_cached_requests.remove(request_id);
+    });
+}
+
 Messages::RequestServer::StopRequestResponse ConnectionFromClient::stop_request(i32 request_id)
 {
     auto request = m_active_requests.take(request_id);
     if (!request.has_value()) {
+        if (m_cached_requests.remove(request_id))
+            return true;
+
         dbgln("StopRequest: Request ID {} not found", request_id);
         return false;
     }
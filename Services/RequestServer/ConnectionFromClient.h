@@ -15,6 +15,9 @@
 
 namespace RequestServer {
 
+class CacheEntryReader;
+class DiskCache;
+
 struct Resolver : public RefCounted<Resolver>
     , Weakable<Resolver> {
     Resolver(Function<ErrorOr<DNS::Resolver::SocketResult>()> create_socket)
@@ -42,7 +45,7 @@ private:
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls) override;
     virtual void set_use_system_dns() override;
-    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData) override;
+    virtual void start_request(i32 request_id, ByteString, URL::URL, HTTP::HeaderMap, ByteBuffer, Core::ProxyData, Optional<ByteString> cache_partition_key) override;
     virtual Messages::RequestServer::StopRequestResponse stop_request(i32) override;
     virtual Messages::RequestServer::SetCertificateResponse set_certificate(i32, ByteString, ByteString) override;
     virtual void ensure_connection(URL::URL url, ::RequestServer::CacheLevel cache_level) override;
@@ -64,6 +67,12 @@ private:
 
     HashMap<i32, NonnullOwnPtr<ActiveRequest>> m_active_requests;
 
+    struct CachedRequest;
+    HashMap<i32, NonnullOwnPtr<CachedRequest>> m_cached_requests;
+
+    void start_cached_request(i32 request_id, int writer_fd, NonnullOwnPtr<CacheEntryReader>);
+    void write_cached_response_body(i32 request_id);
+
     void check_active_requests();
     void* m_curl_multi { nullptr };
     RefPtr<Core::Timer> m_timer;
@@ -72,6 +81,8 @@ private:
     NonnullRefPtr<Resolver> m_resolver;
 };
 
+extern OwnPtr<DiskCache> g_disk_cache;
+
 // FIXME: Find a good home for this
 ByteString build_curl_resolve_list(DNS::LookupResult const&, StringView host, u16 port);
 constexpr inline uintptr_t websocket_private_tag = 0x1;
@@ -0,0 +1,713 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Endian.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/Directory.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+static constexpr u32 cache_entry_magic = 0x4C424843; // "LBHC"
+static constexpr u32 cache_entry_version = 1;
+
+// Temporary files are written to as the response body arrives, so one that hasn't been touched for this long belongs
+// to a writer that is gone.
+static constexpr auto stale_temporary_file_age = AK::Duration::from_seconds(60 * 60);
+
+// The fixed-size header at the start of each cache entry file. It is followed by the response body and then the
+// serialized metadata, so that the body can be streamed to disk before the final metadata is known.
+struct [[gnu::packed]] CacheEntryHeader {
+    LittleEndian<u32> magic;
+    LittleEndian<u32> version;
+    LittleEndian<u64> body_size;
+    LittleEndian<u32> metadata_size;
+};
+static_assert(AssertSize<CacheEntryHeader, 20>());
+
+}
+
+template<>
+class AK::Traits<RequestServer::CacheEntryHeader> : public DefaultTraits<RequestServer::CacheEntryHeader> {
+public:
+    static constexpr bool is_trivially_serializable() { return true; }
+};
+
+namespace RequestServer {
+
+// The fragment is never sent to the server, so it must not take part in the cache key.
+static ByteString serialize_url_for_cache_key(URL::URL const& url)
+{
+    auto url_without_fragment = url;
+    url_without_fragment.set_fragment({});
+    return url_without_fragment.serialize().to_byte_string();
+}
+
+ByteString DiskCache::hash_for_cache_key(ByteString const& partition_key, URL::URL const& url)
+{
+    auto key = ByteString::formatted("{}\n{}", partition_key, serialize_url_for_cache_key(url));
+    auto digest = Crypto::Hash::SHA256::hash(key.bytes());
+    return encode_hex(digest.bytes());
+}
+
+static Optional<StringView> cache_control_directive(HTTP::HeaderMap const& headers, StringView name)
+{
+    auto cache_control = headers.get("Cache-Control"sv);
+    if (!cache_control.has_value())
+        return {};
+
+    Optional<StringView> result;
+    cache_control->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView directive) {
+        if (result.has_value())
+            return;
+
+        directive = directive.trim_whitespace();
+        auto equals = directive.find('=');
+        auto directive_name = equals.has_value() ? directive.substring_view(0, *equals).trim_whitespace() : directive;
+        if (!directive_name.equals_ignoring_ascii_case(name))
+            return;
+
+        if (!equals.has_value()) {
+            result = ""sv;
+            return;
+        }
+        result = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+    });
+    return result;
+}
+
+static Optional<UnixDateTime> parse_http_date(HTTP::HeaderMap const& headers, StringView name)
+{
+    auto value = headers.get(name);
+    if (!value.has_value())
+        return {};
+
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, *value);
+    if (!date_time.has_value())
+        return {};
+    return UnixDateTime::from_seconds_since_epoch(date_time->timestamp());
+}
+
+static Optional<AK::Duration> parse_delta_seconds(Optional<StringView> value)
+{
+    if (!value.has_value())
+        return {};
+    auto seconds = value->to_number<i64>();
+    if (!seconds.has_value() || *seconds < 0)
+        return {};
+    return AK::Duration::from_seconds(*seconds);
+}
+
+// https://httpwg.org/specs/rfc9110.html#field.vary
+template<typename Callback>
+static void for_each_vary_header_name(HTTP::HeaderMap const& response_headers, Callback callback)
+{
+    auto vary = response_headers.get("Vary"sv);
+    if (!vary.has_value())
+        return;
+
+    vary->view().for_each_split_view(',', SplitBehavior::Nothing, [&](StringView name) {
+        callback(name.trim_whitespace());
+    });
+}
+
+// https://httpwg.org/specs/rfc9111.html#storing.fields
+static bool is_exempted_for_storage(StringView header_name)
+{
+    // NOTE: We are a private cache, but we never want to replay cookies to other requests.
+    return header_name.is_one_of_ignoring_ascii_case(
+        "Connection"sv,
+        "Proxy-Connection"sv,
+        "Keep-Alive"sv,
+        "TE"sv,
+        "Transfer-Encoding"sv,
+        "Upgrade"sv,
+        "Set-Cookie"sv);
+}
+
+static ErrorOr<void> write_string(Stream& stream, StringView string)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(string.length()));
+    TRY(stream.write_until_depleted(string.bytes()));
+    return {};
+}
+
+static ErrorOr<ByteString> read_string(FixedMemoryStream& stream)
+{
+    u32 length = TRY(stream.read_value<LittleEndian<u32>>());
+    if (length > stream.remaining())
+        return Error::from_string_literal("Cache entry metadata is truncated");
+
+    return ByteString::create_and_overwrite(length, [&](Bytes buffer) -> ErrorOr<void> {
+        TRY(stream.read_until_filled(buffer));
+        return {};
+    });
+}
+
+static ErrorOr<void> write_headers(Stream& stream, HTTP::HeaderMap const& headers)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(headers.headers().size()));
+    for (auto const& header : headers.headers()) {
+        TRY(write_string(stream, header.name));
+        TRY(write_string(stream, header.value));
+    }
+    return {};
+}
+
+static ErrorOr<HTTP::HeaderMap> read_headers(FixedMemoryStream& stream)
+{
+    HTTP::HeaderMap headers;
+    auto count = TRY(stream.read_value<LittleEndian<u32>>());
+    for (u32 i = 0; i < count; ++i) {
+        auto name = TRY(read_string(stream));
+        auto value = TRY(read_string(stream));
+        headers.set(move(name), move(value));
+    }
+    return headers;
+}
+
+static ErrorOr<ByteBuffer> serialize_metadata(CachedResponseMetadata const& metadata)
+{
+    AllocatingMemoryStream stream;
+    TRY(write_string(stream, metadata.partition_key));
+    TRY(write_string(stream, metadata.url));
+    TRY(stream.write_value<LittleEndian<u32>>(metadata.status_code));
+    TRY(stream.write_value<u8>(metadata.reason_phrase.has_value()));
+    if (metadata.reason_phrase.has_value())
+        TRY(write_string(stream, *metadata.reason_phrase));
+    TRY(write_headers(stream, metadata.response_headers));
+    TRY(write_headers(stream, metadata.vary_request_headers));
+    TRY(stream.write_value<LittleEndian<i64>>(metadata.request_time.milliseconds_since_epoch()));
+    TRY(stream.write_value<LittleEndian<i64>>(metadata.response_time.milliseconds_since_epoch()));
+    return stream.read_until_eof();
+}
+
+static ErrorOr<CachedResponseMetadata> deserialize_metadata(ReadonlyBytes bytes)
+{
+    FixedMemoryStream stream { bytes };
+
+    CachedResponseMetadata metadata;
+    metadata.partition_key = TRY(read_string(stream));
+    metadata.url = TRY(read_string(stream));
+    metadata.status_code = TRY(stream.read_value<LittleEndian<u32>>());
+    if (TRY(stream.read_value<u8>()) != 0)
+        metadata.reason_phrase = TRY(String::from_byte_string(TRY(read_string(stream))));
+    metadata.response_headers = TRY(read_headers(stream));
+    metadata.vary_request_headers = TRY(read_headers(stream));
+    metadata.request_time = UnixDateTime::from_milliseconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+    metadata.response_time = UnixDateTime::from_milliseconds_since_epoch(TRY(stream.read_value<LittleEndian<i64>>()));
+    return metadata;
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+static AK::Duration freshness_lifetime(CachedResponseMetadata const& metadata)
+{
+    auto const& headers = metadata.response_headers;
+
+    // - If the cache is shared and the s-maxage response directive is present, use its value, or
+    //   NOTE: We are not a shared cache.
+
+    // - If the max-age response directive is present, use its value, or
+    if (auto max_age = parse_delta_seconds(cache_control_directive(headers, "max-age"sv)); max_age.has_value())
+        return *max_age;
+
+    // - If the Expires response header field is present, use its value minus the value of the Date response header
+    //   field (using the time the message was received if it is not present, as per Section 6.6.1 of [HTTP]), or
+    if (headers.contains("Expires"sv)) {
+        auto expires = parse_http_date(headers, "Expires"sv);
+        if (!expires.has_value())
+            return AK::Duration::zero();
+        auto date = parse_http_date(headers, "Date"sv).value_or(metadata.response_time);
+        return max(*expires - date, AK::Duration::zero());
+    }
+
+    // - Otherwise, no explicit expiration time is present in the response. A heuristic freshness lifetime might be
+    //   applicable; see Section 4.2.2.
+    // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+    if (auto last_modified = parse_http_date(headers, "Last-Modified"sv); last_modified.has_value()) {
+        // If the response has a Last-Modified header field, caches are encouraged to use a heuristic expiration value
+        // that is no more than some fraction of the interval since that time. A typical setting of this fraction might
+        // be 10%.
+        auto date = parse_http_date(headers, "Date"sv).value_or(metadata.response_time);
+        auto interval = date - *last_modified;
+        if (interval > AK::Duration::zero())
+            return AK::Duration::from_milliseconds(interval.to_milliseconds() / 10);
+    }
+
+    return AK::Duration::zero();
+}
+
+CacheEntryReader::CacheEntryReader(ByteString hash, CachedResponseMetadata metadata, NonnullOwnPtr<Core::MappedFile> file, ReadonlyBytes body)
+    : m_hash(move(hash))
+    , m_metadata(move(metadata))
+    , m_file(move(file))
+    , m_body(body)
+{
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+AK::Duration CacheEntryReader::current_age() const
+{
+    auto const& headers = m_metadata.response_headers;
+    auto now = UnixDateTime::now();
+
+    Optional<StringView> age_header;
+    if (auto age = headers.get("Age"sv); age.has_value())
+        age_header = age->view();
+
+    auto age_value = parse_delta_seconds(age_header).value_or(AK::Duration::zero());
+    auto date_value = parse_http_date(headers, "Date"sv).value_or(m_metadata.response_time);
+
+    auto apparent_age = max(AK::Duration::zero(), m_metadata.response_time - date_value);
+    auto response_delay = m_metadata.response_time - m_metadata.request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = now - m_metadata.response_time;
+    return corrected_initial_age + resident_time;
+}
+
+// https://httpwg.org/specs/rfc9111.html#expiration.model
+bool CacheEntryReader::is_fresh() const
+{
+    // https://httpwg.org/specs/rfc9111.html#cache-response-directive.no-cache
+    if (cache_control_directive(m_metadata.response_headers, "no-cache"sv).has_value())
+        return false;
+
+    return freshness_lifetime(m_metadata) > current_age();
+}
+
+// https://httpwg.org/specs/rfc9111.html#validation.sent
+bool CacheEntryReader::has_validators() const
+{
+    return m_metadata.response_headers.contains("ETag"sv) || m_metadata.response_headers.contains("Last-Modified"sv);
+}
+
+HTTP::HeaderMap CacheEntryReader::response_headers_for_reuse() const
+{
+    HTTP::HeaderMap headers;
+    for (auto const& header : m_metadata.response_headers.headers()) {
+        if (header.name.equals_ignoring_ascii_case("Age"sv))
+            continue;
+        headers.set(header.name, header.value);
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+    // When a stored response is used to satisfy a request without validation, a cache MUST generate an Age header
+    // field, replacing any present in the response with a value equal to the stored response's current_age.
+    headers.set("Age"sv, ByteString::number(max<i64>(current_age().to_seconds(), 0)));
+    return headers;
+}
+
+CacheEntryWriter::CacheEntryWriter(DiskCache& cache, ByteString hash, CachedResponseMetadata metadata, ByteString temporary_path, NonnullOwnPtr<Core::File> file)
+    : m_cache(cache)
+    , m_hash(move(hash))
+    , m_metadata(move(metadata))
+    , m_temporary_path(move(temporary_path))
+    , m_file(move(file))
+{
+}
+
+CacheEntryWriter::~CacheEntryWriter()
+{
+    if (!m_file)
+        return;
+
+    m_file.clear();
+    (void)Core::System::unlink(m_temporary_path);
+}
+
+ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
+{
+    VERIFY(m_file);
+
+    TRY(m_file->write_until_depleted(data));
+    m_body_size += data.size();
+
+    if (m_body_size > m_cache.m_maximum_size / 8)
+        return Error::from_string_literal("Response body is too large to cache");
+    return {};
+}
+
+ErrorOr<void> CacheEntryWriter::commit()
+{
+    VERIFY(m_file);
+
+    m_metadata.response_time = UnixDateTime::now();
+
+    auto metadata = TRY(serialize_metadata(m_metadata));
+    TRY(m_file->write_until_depleted(metadata));
+
+    CacheEntryHeader header;
+    header.magic = cache_entry_magic;
+    header.version = cache_entry_version;
+    header.body_size = m_body_size;
+    header.metadata_size = metadata.size();
+
+    TRY(m_file->seek(0, SeekMode::SetPosition));
+    TRY(m_file->write_value(header));
+    m_file->close();
+    m_file.clear();
+
+    auto path = m_cache.path_for_entry(m_hash);
+
+    if (auto result = Core::System::rename(m_temporary_path, path); result.is_error()) {
+        (void)Core::System::unlink(m_temporary_path);
+        return result.release_error();
+    }
+
+    m_cache.did_commit_entry(m_hash, sizeof(CacheEntryHeader) + m_body_size + metadata.size());
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<DiskCache>> DiskCache::create(ByteString directory, u64 maximum_size)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    auto cache = adopt_own(*new DiskCache(move(directory), maximum_size));
+    TRY(cache->load_index());
+    return cache;
+}
+
+DiskCache::DiskCache(ByteString directory, u64 maximum_size)
+    : m_directory(move(directory))
+    , m_maximum_size(maximum_size)
+{
+}
+
+ErrorOr<void> DiskCache::load_index()
+{
+    TRY(Core::Directory::for_each_entry(m_directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        if (entry.type != Core::DirectoryEntry::Type::File)
+            return IterationDecision::Continue;
+
+        auto path = path_for_entry(entry.name);
+
+        auto stat = Core::System::stat(path);
+        if (stat.is_error())
+            return IterationDecision::Continue;
+
+        // Anything left over from an interrupted write is useless. Other RequestServer processes share the directory
+        // though, so recent temporary files may still be in the middle of being written.
+        if (entry.name.contains(".tmp."sv)) {
+            auto modification_time = UnixDateTime::from_seconds_since_epoch(stat.value().st_mtime);
+            if (UnixDateTime::now() - modification_time >= stale_temporary_file_age)
+                (void)Core::System::unlink(path);
+            return IterationDecision::Continue;
+        }
+
+        auto size = static_cast<u64>(stat.value().st_size);
+        m_index.set(entry.name, { size, UnixDateTime::from_seconds_since_epoch(stat.value().st_mtime) });
+        m_total_size += size;
+
+        return IterationDecision::Continue;
+    }));
+
+    evict_entries_if_needed();
+    return {};
+}
+
+ByteString DiskCache::path_for_entry(StringView hash) const
+{
+    return ByteString::formatted("{}/{}", m_directory, hash);
+}
+
+ErrorOr<DiskCache::TemporaryFile> DiskCache::create_temporary_file(StringView hash) const
+{
+    auto pattern = ByteString::formatted("{}/{}.tmp.XXXXXX", m_directory, hash);
+
+    Vector<char> path;
+    path.append(pattern.characters(), pattern.length() + 1);
+    auto fd = TRY(Core::System::mkstemp(path.span()));
+
+    auto file = TRY(Core::File::adopt_fd(fd, Core::File::OpenMode::Write));
+    return TemporaryFile { ByteString { path.data(), pattern.length() }, move(file) };
+}
+
+// https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+bool DiskCache::is_cacheable_request(StringView method, HTTP::HeaderMap const& request_headers)
+{
+    // - the request method associated with the stored response allows it to be used for the presented request, and
+    //   NOTE: We only ever store responses to GET requests.
+    if (method != "GET"sv)
+        return false;
+
+    // NOTE: Conditional and range requests are issued by our clients to revalidate or resume their own copies of a
+    //       response. We pass those through to the network untouched.
+    for (auto header : { "If-None-Match"sv, "If-Modified-Since"sv, "If-Match"sv, "If-Unmodified-Since"sv, "If-Range"sv, "Range"sv, "Authorization"sv }) {
+        if (request_headers.contains(header))
+            return false;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.no-store
+    if (cache_control_directive(request_headers, "no-store"sv).has_value())
+        return false;
+
+    return true;
+}
+
+OwnPtr<CacheEntryReader> DiskCache::open_entry(ByteString const& partition_key, URL::URL const& url, HTTP::HeaderMap const& request_headers)
+{
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.no-cache
+    if (cache_control_directive(request_headers, "no-cache"sv).has_value())
+        return {};
+    if (auto pragma = request_headers.get("Pragma"sv); pragma.has_value() && pragma->equals_ignoring_ascii_case("no-cache"sv))
+        return {};
+
+    auto hash = hash_for_cache_key(partition_key, url);
+
+    auto index_entry = m_index.get(hash);
+    if (!index_entry.has_value())
+        return {};
+
+    auto path = path_for_entry(hash);
+
+    auto entry_or_error = [&]() -> ErrorOr<NonnullOwnPtr<CacheEntryReader>> {
+        auto file = TRY(Core::MappedFile::map(path));
+        auto bytes = file->bytes();
+
+        if (bytes.size() < sizeof(CacheEntryHeader))
+            return Error::from_string_literal("Cache entry is truncated");
+
+        CacheEntryHeader header;
+        __builtin_memcpy(&header, bytes.data(), sizeof(header));
+
+        if (header.magic != cache_entry_magic || header.version != cache_entry_version)
+            return Error::from_string_literal("Cache entry has an unknown format");
+        if (sizeof(CacheEntryHeader) + header.body_size + header.metadata_size != bytes.size())
+            return Error::from_string_literal("Cache entry is truncated");
+
+        auto body = bytes.slice(sizeof(CacheEntryHeader), header.body_size);
+        auto metadata = TRY(deserialize_metadata(bytes.slice(sizeof(CacheEntryHeader) + header.body_size, header.metadata_size)));
+
+        return adopt_own(*new CacheEntryReader(hash, move(metadata), move(file), body));
+    }();
+
+    if (entry_or_error.is_error()) {
+        dbgln("DiskCache: Unable to read cache entry {}: {}", path, entry_or_error.error());
+        remove_entry(hash);
+        return {};
+    }
+
+    auto entry = entry_or_error.release_value();
+
+    // Guard against hash collisions.
+    if (entry->metadata().partition_key != partition_key || entry->metadata().url != serialize_url_for_cache_key(url))
+        return {};
+
+    // https://httpwg.org/specs/rfc9111.html#caching.negotiated.responses
+    // - request header fields nominated by the stored response (if any) match those presented (see Section 4.1), and
+    bool vary_headers_match = true;
+    for_each_vary_header_name(entry->metadata().response_headers, [&](StringView name) {
+        if (request_headers.get(name) != entry->metadata().vary_request_headers.get(name))
+            vary_headers_match = false;
+    });
+    if (!vary_headers_match)
+        return {};
+
+    index_entry->last_access_time = UnixDateTime::now();
+    m_index.set(hash, *index_entry);
+
+    // Persist the access time so that LRU eviction order survives restarts.
+    (void)Core::System::utimensat(AT_FDCWD, path, nullptr, 0);
+
+    return entry;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+OwnPtr<CacheEntryWriter> DiskCache::create_entry(ByteString const& partition_key, URL::URL const& url, HTTP::HeaderMap const& request_headers, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const& response_headers, UnixDateTime request_time)
+{
+    // A cache MUST NOT store a response to a request unless:
+
+    // - the response status code is final (see Section 15 of [HTTP]);
+    // - if the response status code is 206 or 304, or the must-understand cache directive (see Section 5.2.2.3) is
+    //   present: the cache understands the response status code;
+    //   NOTE: We don't combine partial content, and 304 responses are handled by the revalidation logic.
+    if (status_code < 200 || status_code == 206 || status_code == 304)
+        return {};
+
+    // - the no-store cache directive is not present in the response (see Section 5.2.2.5);
+    if (cache_control_directive(response_headers, "no-store"sv).has_value())
+        return {};
+
+    // https://httpwg.org/specs/rfc9110.html#field.vary
+    // A Vary field value containing a member "*" signals that ... a cache cannot determine whether a later request is
+    // the same request.
+    bool varies_on_everything = false;
+    HTTP::HeaderMap vary_request_headers;
+    for_each_vary_header_name(response_headers, [&](StringView name) {
+        if (name == "*"sv)
+            varies_on_everything = true;
+        else if (auto value = request_headers.get(name); value.has_value())
+            vary_request_headers.set(name, *value);
+    });
+    if (varies_on_everything)
+        return {};
+
+    // - the response contains at least one of the following:
+    //   + a public response directive (see Section 5.2.2.9);
+    //   + a private response directive, if the cache is not shared (see Section 5.2.2.7);
+    //   + an Expires header field (see Section 5.3);
+    //   + a max-age response directive (see Section 5.2.2.1);
+    //   + a status code that is defined as heuristically cacheable (see Section 4.2.2).
+    //   NOTE: We also require validators or a non-zero freshness lifetime, as the entry would be useless otherwise.
+    static constexpr Array heuristically_cacheable_status_codes { 200u, 203u, 204u, 300u, 301u, 308u, 404u, 405u, 410u, 414u, 501u };
+    bool has_explicit_freshness = response_headers.contains("Expires"sv) || cache_control_directive(response_headers, "max-age"sv).has_value();
+    bool may_be_stored = has_explicit_freshness
+        || cache_control_directive(response_headers, "public"sv).has_value()
+        || cache_control_directive(response_headers, "private"sv).has_value()
+        || heuristically_cacheable_status_codes.contains_slow(status_code);
+    if (!may_be_stored)
+        return {};
+
+    CachedResponseMetadata metadata;
+    metadata.partition_key = partition_key;
+    metadata.url = serialize_url_for_cache_key(url);
+    metadata.status_code = status_code;
+    metadata.reason_phrase = move(reason_phrase);
+    metadata.vary_request_headers = move(vary_request_headers);
+    metadata.request_time = request_time;
+
+    for (auto const& header : response_headers.headers()) {
+        if (!is_exempted_for_storage(header.name))
+            metadata.response_headers.set(header.name, header.value);
+    }
+
+    auto has_validators = response_headers.contains("ETag"sv) || response_headers.contains("Last-Modified"sv);
+    if (!has_validators && freshness_lifetime(metadata) == AK::Duration::zero())
+        return {};
+
+    auto hash = hash_for_cache_key(partition_key, url);
+
+    auto file_or_error = [&]() -> ErrorOr<TemporaryFile> {
+        auto temporary_file = TRY(create_temporary_file(hash));
+
+        // Reserve room for the header, which is written once the size of the body is known.
+        CacheEntryHeader header {};
+        if (auto result = temporary_file.file->write_value(header); result.is_error()) {
+            (void)Core::System::unlink(temporary_file.path);
+            return result.release_error();
+        }
+        return temporary_file;
+    }();
+
+    if (file_or_error.is_error()) {
+        dbgln("DiskCache: Unable to create cache entry for {}: {}", url, file_or_error.error());
+        return {};
+    }
+
+    auto temporary_file = file_or_error.release_value();
+    return adopt_own(*new CacheEntryWriter(*this, move(hash), move(metadata), move(temporary_file.path), move(temporary_file.file)));
+}
+
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+void DiskCache::freshen_entry(CacheEntryReader& entry, HTTP::HeaderMap const& not_modified_response_headers)
+{
+    // For each stored response identified, the cache MUST update its header fields with the header fields provided in
+    // the 304 (Not Modified) response, as per Section 3.2.
+    // https://httpwg.org/specs/rfc9111.html#update
+    auto is_exempted_for_updating = [](StringView name) {
+        return is_exempted_for_storage(name) || name.equals_ignoring_ascii_case("Content-Length"sv);
+    };
+
+    HTTP::HeaderMap updated_headers;
+    for (auto const& header : entry.m_metadata.response_headers.headers()) {
+        if (is_exempted_for_updating(header.name) || !not_modified_response_headers.contains(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+    for (auto const& header : not_modified_response_headers.headers()) {
+        if (!is_exempted_for_updating(header.name))
+            updated_headers.set(header.name, header.value);
+    }
+
+    entry.m_metadata.response_headers = move(updated_headers);
+    entry.m_metadata.response_time = UnixDateTime::now();
+    entry.m_metadata.request_time = entry.m_metadata.response_time;
+
+    // The reader keeps its mapping of the old file alive, so we can write the updated entry out next to it and
+    // atomically replace it.
+    Optional<ByteString> temporary_path;
+    auto result = [&]() -> ErrorOr<void> {
+        auto metadata = TRY(serialize_metadata(entry.m_metadata));
+        auto [path, file] = TRY(create_temporary_file(entry.m_hash));
+        temporary_path = path;
+
+        CacheEntryHeader header;
+        header.magic = cache_entry_magic;
+        header.version = cache_entry_version;
+        header.body_size = entry.body().size();
+        header.metadata_size = metadata.size();
+
+        TRY(file->write_value(header));
+        TRY(file->write_until_depleted(entry.body()));
+        TRY(file->write_until_depleted(metadata));
+        file->close();
+
+        TRY(Core::System::rename(path, path_for_entry(entry.m_hash)));
+        did_commit_entry(entry.m_hash, sizeof(CacheEntryHeader) + entry.body().size() + metadata.size());
+        return {};
+    }();
+
+    if (result.is_error()) {
+        dbgln("DiskCache: Unable to freshen cache entry for {}: {}", entry.m_metadata.url, result.error());
+        if (temporary_path.has_value())
+            (void)Core::System::unlink(*temporary_path);
+        remove_entry(entry.m_hash);
+    }
+}
+
+void DiskCache::remove_entry(ByteString const& hash)
+{
+    auto index_entry = m_index.take(hash);
+    if (!index_entry.has_value())
+        return;
+
+    m_total_size -= index_entry->size;
+    (void)Core::System::unlink(path_for_entry(hash));
+}
+
+void DiskCache::did_commit_entry(ByteString const& hash, u64 size)
+{
+    if (auto previous = m_index.get(hash); previous.has_value())
+        m_total_size -= previous->size;
+
+    m_index.set(hash, { size, UnixDateTime::now() });
+    m_total_size += size;
+
+    evict_entries_if_needed();
+}
+
+void DiskCache::evict_entries_if_needed()
+{
+    if (m_total_size <= m_maximum_size)
+        return;
+
+    // Evict the least recently used entries until we are comfortably below the budget again, so that we don't have to
+    // repeat this for every subsequently stored response.
+    auto target_size = m_maximum_size - (m_maximum_size / 10);
+
+    Vector<ByteString> hashes;
+    hashes.ensure_capacity(m_index.size());
+    for (auto const& it : m_index)
+        hashes.unchecked_append(it.key);
+
+    quick_sort(hashes, [&](auto const& a, auto const& b) {
+        return m_index.get(a)->last_access_time < m_index.get(b)->last_access_time;
+    });
+
+    for (auto const& hash : hashes) {
+        if (m_total_size <= target_size)
+            break;
+        remove_entry(hash);
+    }
+}
+
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+class DiskCache;
+
+// The metadata we persist alongside each cached response body.
+// https://httpwg.org/specs/rfc9111.html#caching.overview
+struct CachedResponseMetadata {
+    ByteString partition_key;
+    ByteString url;
+    u32 status_code { 0 };
+    Optional<String> reason_phrase;
+    HTTP::HeaderMap response_headers;
+
+    // The values of the request headers nominated by the response's Vary header, captured when the response was stored.
+    HTTP::HeaderMap vary_request_headers;
+
+    UnixDateTime request_time;
+    UnixDateTime response_time;
+};
+
+class CacheEntryReader {
+public:
+    CachedResponseMetadata const& metadata() const { return m_metadata; }
+    ReadonlyBytes body() const { return m_body; }
+
+    bool is_fresh() const;
+    bool has_validators() const;
+    AK::Duration current_age() const;
+
+    // The stored response headers, with an Age header reflecting the time the response has spent in the cache.
+    HTTP::HeaderMap response_headers_for_reuse() const;
+
+private:
+    friend class DiskCache;
+
+    CacheEntryReader(ByteString hash, CachedResponseMetadata, NonnullOwnPtr<Core::MappedFile>, ReadonlyBytes body);
+
+    ByteString m_hash;
+    CachedResponseMetadata m_metadata;
+    NonnullOwnPtr<Core::MappedFile> m_file;
+    ReadonlyBytes m_body;
+};
+
+class CacheEntryWriter {
+public:
+    ~CacheEntryWriter();
+
+    ErrorOr<void> write_data(ReadonlyBytes);
+    ErrorOr<void> commit();
+
+private:
+    friend class DiskCache;
+
+    CacheEntryWriter(DiskCache&, ByteString hash, CachedResponseMetadata, ByteString temporary_path, NonnullOwnPtr<Core::File>);
+
+    DiskCache& m_cache;
+    ByteString m_hash;
+    CachedResponseMetadata m_metadata;
+    ByteString m_temporary_path;
+    OwnPtr<Core::File> m_file;
+    u64 m_body_size { 0 };
+};
+
+// A persistent, size-bounded HTTP cache shared by all clients of this RequestServer. Each response is stored in its
+// own file, named after a hash of its cache key. Response bodies are memory-mapped when reused.
+class DiskCache {
+public:
+    static constexpr u64 default_maximum_size = 256 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> create(ByteString directory, u64 maximum_size = default_maximum_size);
+
+    static bool is_cacheable_request(StringView method, HTTP::HeaderMap const& request_headers);
+
+    // The name of the file the response for a partition key and URL is stored in.
+    static ByteString hash_for_cache_key(ByteString const& partition_key, URL::URL const&);
+
+    OwnPtr<CacheEntryReader> open_entry(ByteString const& partition_key, URL::URL const&, HTTP::HeaderMap const& request_headers);
+    OwnPtr<CacheEntryWriter> create_entry(ByteString const& partition_key, URL::URL const&, HTTP::HeaderMap const& request_headers, u32 status_code, Optional<String> reason_phrase, HTTP::HeaderMap const& response_headers, UnixDateTime request_time);
+
+    // https://httpwg.org/specs/rfc9111.html#freshening.responses
+    void freshen_entry(CacheEntryReader&, HTTP::HeaderMap const& not_modified_response_headers);
+
+    void remove_entry(ByteString const& hash);
+
+private:
+    friend class CacheEntryWriter;
+
+    struct IndexEntry {
+        u64 size { 0 };
+        UnixDateTime last_access_time;
+    };
+
+    DiskCache(ByteString directory, u64 maximum_size);
+
+    ErrorOr<void> load_index();
+    void did_commit_entry(ByteString const& hash, u64 size);
+    void evict_entries_if_needed();
+
+    ByteString path_for_entry(StringView hash) const;
+
+    // Every write goes to a temporary file of its own, as several responses for the same URL may be in flight at once.
+    // Whichever is committed last replaces the entry.
+    struct TemporaryFile {
+        ByteString path;
+        NonnullOwnPtr<Core::File> file;
+    };
+    ErrorOr<TemporaryFile> create_temporary_file(StringView hash) const;
+
+    ByteString m_directory;
+    u64 m_maximum_size { 0 };
+    u64 m_total_size { 0 };
+    HashMap<ByteString, IndexEntry> m_index;
+};
+
+}
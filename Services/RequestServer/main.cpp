@@ -11,12 +11,14 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/Process.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/TLSv12.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 
 #if defined(AK_OS_MACOS)
 #    include <LibCore/Platform/ProcessStatisticsMach.h>
@@ -43,12 +45,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView serenity_resource_root;
     Vector<ByteString> certificates;
     StringView mach_server_name;
+    bool enable_http_disk_cache = false;
     bool wait_for_debugger = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
+    args_parser.add_option(enable_http_disk_cache, "Enable the persistent HTTP disk cache", "enable-http-disk-cache");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.parse(arguments);
 
@@ -61,6 +65,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     else
         RequestServer::g_default_certificate_path = certificates.first();
 
+    if (enable_http_disk_cache) {
+        auto cache_directory = ByteString::formatted("{}/Ladybird/HTTP", Core::StandardPaths::cache_directory());
+
+        if (auto disk_cache = RequestServer::DiskCache::create(move(cache_directory)); disk_cache.is_error())
+            warnln("Unable to create HTTP disk cache: {}", disk_cache.error());
+        else
+            RequestServer::g_disk_cache = disk_cache.release_value();
+    }
+
     Core::EventLoop event_loop;
 
 #if defined(AK_OS_MACOS)
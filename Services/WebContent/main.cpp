@@ -25,6 +25,7 @@
 #include <LibWeb/Loader/GeneratedPagesLoader.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
 #include <LibWeb/Platform/AudioCodecPluginAgnostic.h>
 #include <LibWeb/Platform/EventLoopPluginSerenity.h>
 #include <LibWebView/Plugins/FontPlugin.h>
@@ -109,8 +110,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool enable_idl_tracing = false;
     bool enable_http_cache = false;
     bool force_cpu_painting = false;
+    bool enable_tiled_rasterization = false;
     bool force_fontconfig = false;
     bool collect_garbage_on_every_allocation = false;
+    bool enable_incremental_garbage_collection = false;
+    bool enable_generational_garbage_collection = false;
+    bool enable_js_program_cache = false;
     bool is_headless = false;
     bool disable_scrollbar_painting = false;
     StringView echo_server_port_string_view {};
@@ -131,8 +136,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(enable_http_cache, "Enable HTTP cache", "enable-http-cache");
     args_parser.add_option(force_cpu_painting, "Force CPU painting", "force-cpu-painting");
+    args_parser.add_option(enable_tiled_rasterization, "Rasterize CPU painted pages in tiles on multiple threads", "enable-tiled-rasterization");
     args_parser.add_option(force_fontconfig, "Force using fontconfig for font loading", "force-fontconfig");
     args_parser.add_option(collect_garbage_on_every_allocation, "Collect garbage after every JS heap allocation", "collect-garbage-on-every-allocation");
+    args_parser.add_option(enable_incremental_garbage_collection, "Mark the JS heap incrementally during idle periods", "enable-incremental-gc");
+    args_parser.add_option(enable_generational_garbage_collection, "Collect short-lived JS heap cells separately from the rest of the heap", "enable-generational-gc");
+    args_parser.add_option(enable_js_program_cache, "Reuse the parsed programs of scripts and modules that are loaded again", "enable-js-program-cache");
     args_parser.add_option(disable_scrollbar_painting, "Don't paint horizontal or vertical viewport scrollbars", "disable-scrollbar-painting");
     args_parser.add_option(echo_server_port_string_view, "Echo server port used in test internals", "echo-server-port", 0, "echo_server_port");
     args_parser.add_option(is_headless, "Report that the browser is running in headless mode", "headless");
@@ -171,6 +180,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     Web::Painting::g_paint_viewport_scrollbars = !disable_scrollbar_painting;
+    Web::Painting::g_enable_tiled_rasterization = enable_tiled_rasterization;
 
     if (!echo_server_port_string_view.is_empty()) {
         if (auto maybe_echo_server_port = echo_server_port_string_view.to_number<u16>(); maybe_echo_server_port.has_value())
@@ -201,6 +211,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     if (collect_garbage_on_every_allocation)
         Web::Bindings::main_thread_vm().heap().set_should_collect_on_every_allocation(true);
+    if (enable_incremental_garbage_collection)
+        Web::Bindings::main_thread_vm().heap().set_incremental_marking_enabled(true);
+    if (enable_generational_garbage_collection)
+        Web::Bindings::main_thread_vm().heap().set_generational_collection_enabled(true);
+    if (enable_js_program_cache)
+        Web::Bindings::main_thread_vm().enable_program_cache(32 * MiB);
 
     TRY(initialize_resource_loader(Web::Bindings::main_thread_vm().heap(), request_server_socket));
 
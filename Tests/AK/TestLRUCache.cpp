@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/LRUCache.h>
+#include <AK/String.h>
+
+TEST_CASE(construct)
+{
+    LRUCache<int, int> cache(3);
+    EXPECT(cache.is_empty());
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.cost(), 0u);
+    EXPECT_EQ(cache.capacity(), 3u);
+}
+
+TEST_CASE(get_and_set)
+{
+    LRUCache<int, int> cache(3);
+    EXPECT_EQ(cache.get(1), nullptr);
+    EXPECT_EQ(cache.miss_count(), 1u);
+
+    cache.set(1, 10);
+    EXPECT_EQ(*cache.get(1), 10);
+    EXPECT_EQ(cache.hit_count(), 1u);
+
+    cache.set(1, 20);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(*cache.get(1), 20);
+}
+
+TEST_CASE(least_recently_used_entries_are_evicted)
+{
+    LRUCache<int, int> cache(3);
+    cache.set(1, 10);
+    cache.set(2, 20);
+    cache.set(3, 30);
+
+    // Using the oldest entry makes the second one the least recently used.
+    EXPECT_EQ(*cache.get(1), 10);
+    cache.set(4, 40);
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.get(2), nullptr);
+    EXPECT_EQ(*cache.get(1), 10);
+    EXPECT_EQ(*cache.get(3), 30);
+    EXPECT_EQ(*cache.get(4), 40);
+}
+
+TEST_CASE(entries_are_evicted_by_cost)
+{
+    LRUCache<int, int> cache(10);
+    cache.set(1, 10, 4);
+    cache.set(2, 20, 4);
+    EXPECT_EQ(cache.cost(), 8u);
+
+    cache.set(3, 30, 4);
+    EXPECT_EQ(cache.cost(), 8u);
+    EXPECT_EQ(cache.get(1), nullptr);
+
+    // Replacing an entry only counts its new cost.
+    cache.set(2, 21, 6);
+    EXPECT_EQ(cache.cost(), 10u);
+    EXPECT_EQ(*cache.get(2), 21);
+    EXPECT_EQ(*cache.get(3), 30);
+
+    // An entry that wouldn't fit even into an empty cache isn't added, and leaves the others alone.
+    cache.set(4, 40, 11);
+    EXPECT_EQ(cache.get(4), nullptr);
+    EXPECT_EQ(cache.size(), 2u);
+
+    cache.clear();
+    EXPECT(cache.is_empty());
+    EXPECT_EQ(cache.cost(), 0u);
+}
+
+TEST_CASE(lookup_by_compatible_key)
+{
+    LRUCache<String, int> cache(3);
+    cache.set("foo"_string, 1);
+    EXPECT_EQ(*cache.get("foo"sv), 1);
+    EXPECT_EQ(cache.get("bar"sv), nullptr);
+}
+
+TEST_CASE(lookup_by_hash_and_predicate)
+{
+    LRUCache<String, int> cache(3);
+    cache.set("foo"_string, 1);
+
+    auto hash = "foo"sv.hash();
+    EXPECT_EQ(*cache.get(hash, [](String const& key) { return key == "foo"sv; }), 1);
+    EXPECT_EQ(cache.get(hash, [](String const&) { return false; }), nullptr);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestFontCommon.h"
+
+#include <AK/Atomic.h>
+#include <AK/StringBuilder.h>
+#include <LibGfx/ShapedTextCache.h>
+#include <LibGfx/TextLayout.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+static constexpr size_t thread_count = 8;
+static constexpr size_t passes_per_thread = 4;
+
+// Lines of made-up words, so that most of them are shaped from scratch the first time around. Some syllables kern or
+// form ligatures, so shaping has some work to do.
+static Vector<ByteString> make_corpus(size_t line_count)
+{
+    static constexpr Array syllables { "lo"sv, "rem"sv, "ip"sv, "sum"sv, "do"sv, "lor"sv, "sit"sv, "a"sv, "met"sv, "con"sv, "sec"sv, "te"sv, "tur"sv, "fi"sv, "flu"sv, "To"sv, "Va"sv };
+
+    Vector<ByteString> corpus;
+    u32 state = 2463534242;
+    auto next_random = [&] {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+
+    for (size_t line = 0; line < line_count; ++line) {
+        StringBuilder builder;
+        for (size_t word = 0; word < 12; ++word) {
+            if (word != 0)
+                builder.append(' ');
+            auto syllable_count = 1 + next_random() % 4;
+            for (size_t i = 0; i < syllable_count; ++i)
+                builder.append(syllables[next_random() % syllables.size()]);
+        }
+        corpus.append(builder.to_byte_string());
+    }
+    return corpus;
+}
+
+static float shape_corpus(Vector<ByteString> const& corpus, Gfx::Font const& font, Vector<float>* widths = nullptr)
+{
+    float total_width = 0;
+    for (auto const& line : corpus) {
+        auto glyph_run = Gfx::shape_text({ 0, 0 }, 0, Utf8View { line }, font, Gfx::GlyphRun::TextType::Ltr, {});
+        total_width += glyph_run->width();
+        if (widths)
+            widths->append(glyph_run->width());
+    }
+    return total_width;
+}
+
+static Vector<Vector<float>> shape_corpus_on_threads(Vector<ByteString> const& corpus, Gfx::Font const& font)
+{
+    IGNORE_USE_IN_ESCAPING_LAMBDA Atomic<size_t> mismatch_count { 0 };
+    IGNORE_USE_IN_ESCAPING_LAMBDA Vector<Vector<float>> widths_per_thread;
+    widths_per_thread.resize(thread_count);
+
+    // NOTE: None of the threads has shaped anything with this font yet, so they all race to set up its HarfBuzz font.
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.append(Threading::Thread::construct([&, i] {
+            auto& widths = widths_per_thread[i];
+            shape_corpus(corpus, font, &widths);
+
+            // Later passes are answered by this thread's cache, and must agree with the first one.
+            for (size_t pass = 1; pass < passes_per_thread; ++pass) {
+                Vector<float> cached_widths;
+                shape_corpus(corpus, font, &cached_widths);
+                if (cached_widths != widths)
+                    ++mismatch_count;
+            }
+            return static_cast<intptr_t>(0);
+        }));
+    }
+
+    for (auto& thread : threads)
+        thread->start();
+    for (auto& thread : threads)
+        MUST(thread->join());
+
+    EXPECT_EQ(mismatch_count.load(), 0u);
+    return widths_per_thread;
+}
+
+BENCHMARK_CASE(shape_corpus_on_one_thread)
+{
+    auto font = load_test_font(12);
+    auto corpus = make_corpus(2000);
+    for (size_t pass = 0; pass < thread_count * passes_per_thread; ++pass)
+        EXPECT(shape_corpus(corpus, *font) > 0);
+}
+
+BENCHMARK_CASE(shape_corpus_on_many_threads)
+{
+    auto font = load_test_font(12);
+    auto corpus = make_corpus(2000);
+    (void)shape_corpus_on_threads(corpus, *font);
+}
+
+TEST_CASE(threads_shape_text_like_the_main_thread)
+{
+    auto font = load_test_font(16);
+    auto corpus = make_corpus(200);
+    auto& cache = Gfx::ShapedTextCache::the();
+    auto lookup_count = cache.hit_count() + cache.miss_count();
+    auto widths_per_thread = shape_corpus_on_threads(corpus, *font);
+
+    // Every thread shapes with a cache of its own.
+    EXPECT_EQ(cache.hit_count() + cache.miss_count(), lookup_count);
+
+    Vector<float> expected_widths;
+    shape_corpus(corpus, *font, &expected_widths);
+    for (auto const& widths : widths_per_thread)
+        EXPECT(widths == expected_widths);
+}
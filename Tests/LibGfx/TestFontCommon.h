@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibCore/MappedFile.h>
+#include <LibGfx/Font/Font.h>
+#include <LibGfx/Font/Typeface.h>
+#include <LibTest/TestCase.h>
+
+// Lato kerns pairs like "AV" and "To" in GPOS, and forms "fi" and "fl" ligatures.
+static inline NonnullRefPtr<Gfx::Font> load_test_font(float point_size)
+{
+    auto file = MUST(Core::MappedFile::map("test-inputs/ttf/Lato-Regular.ttf"sv));
+    auto typeface = MUST(Gfx::Typeface::try_load_from_temporary_memory(file->bytes()));
+    return typeface->font(point_size);
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TestFontCommon.h"
+
+#include <AK/ScopeGuard.h>
+#include <LibGfx/ShapedTextCache.h>
+#include <LibGfx/TextLayout.h>
+#include <LibTest/TestCase.h>
+#include <harfbuzz/hb.h>
+
+static Gfx::ShapedTextCache::ShapedText make_shaped_text(size_t glyph_count)
+{
+    Gfx::ShapedTextCache::ShapedText shaped_text;
+    for (size_t i = 0; i < glyph_count; ++i)
+        shaped_text.glyphs.append({ { static_cast<float>(i), 0 }, static_cast<u32>(i) });
+    shaped_text.advance = { static_cast<float>(glyph_count), 0 };
+    return shaped_text;
+}
+
+// Shapes the whole text at once with HarfBuzz, without going anywhere near the cache.
+static Gfx::ShapedTextCache::ShapedText shape_all_at_once(StringView text, Gfx::Font const& font)
+{
+    auto* buffer = hb_buffer_create();
+    ScopeGuard destroy_buffer = [&] { hb_buffer_destroy(buffer); };
+    hb_buffer_add_utf8(buffer, text.characters_without_null_termination(), text.length(), 0, -1);
+    hb_buffer_guess_segment_properties(buffer);
+    hb_shape(font.harfbuzz_font(), buffer, nullptr, 0);
+
+    u32 glyph_count;
+    auto* glyph_info = hb_buffer_get_glyph_infos(buffer, &glyph_count);
+    auto* positions = hb_buffer_get_glyph_positions(buffer, &glyph_count);
+
+    Gfx::ShapedTextCache::ShapedText shaped_text;
+    for (size_t i = 0; i < glyph_count; ++i) {
+        auto position = shaped_text.advance
+            - Gfx::FloatPoint { 0, font.pixel_metrics().ascent }
+            + Gfx::FloatPoint { positions[i].x_offset, positions[i].y_offset } / Gfx::text_shaping_resolution;
+        shaped_text.glyphs.append({ position, glyph_info[i].codepoint });
+        shaped_text.advance += Gfx::FloatPoint { positions[i].x_advance, positions[i].y_advance } / Gfx::text_shaping_resolution;
+    }
+    return shaped_text;
+}
+
+TEST_CASE(shaped_text_is_keyed_by_font_spacing_features_and_text)
+{
+    auto font = load_test_font(12);
+    auto other_font = load_test_font(14);
+    Gfx::ShapedTextCache cache(1 * MiB);
+
+    EXPECT(!cache.get(*font, 0, "word"sv, {}));
+    cache.set(*font, 0, "word"sv, {}, make_shaped_text(4));
+
+    auto const* shaped_text = cache.get(*font, 0, "word"sv, {});
+    EXPECT(shaped_text);
+    EXPECT_EQ(shaped_text->glyphs.size(), 4u);
+    EXPECT_EQ(shaped_text->advance.x(), 4.0f);
+
+    Gfx::ShapeFeatures features;
+    features.append({ { 'l', 'i', 'g', 'a' }, 0 });
+    EXPECT(!cache.get(*other_font, 0, "word"sv, {}));
+    EXPECT(!cache.get(*font, 1, "word"sv, {}));
+    EXPECT(!cache.get(*font, 0, "word"sv, features));
+    EXPECT(!cache.get(*font, 0, "words"sv, {}));
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 5u);
+}
+
+TEST_CASE(shaped_text_size_is_that_of_its_text_and_glyphs)
+{
+    auto font = load_test_font(12);
+    Gfx::ShapedTextCache cache(1 * KiB);
+
+    cache.set(*font, 0, "word"sv, {}, make_shaped_text(3));
+    EXPECT_EQ(cache.size_in_bytes(), "word"sv.length() + 3 * sizeof(Gfx::DrawGlyph));
+
+    // Text that would take up the whole cache on its own isn't kept at all.
+    cache.set(*font, 0, "long"sv, {}, make_shaped_text(1 * KiB));
+    EXPECT(!cache.get(*font, 0, "long"sv, {}));
+    EXPECT(cache.get(*font, 0, "word"sv, {}));
+}
+
+TEST_CASE(shaping_word_by_word_gives_the_same_glyphs_as_shaping_everything_at_once)
+{
+    auto font = load_test_font(16);
+
+    // The font has a legacy kerning table, but HarfBuzz only uses the kerning in GPOS, which leaves spaces alone.
+    EXPECT(!font->typeface().has_space_in_ligatures_or_kerning());
+
+    auto& cache = Gfx::ShapedTextCache::the();
+    cache.clear();
+
+    auto check = [&](StringView text) {
+        auto expected = shape_all_at_once(text, *font);
+
+        // Shape it twice, so that the second time around every word comes from the cache.
+        for (size_t pass = 0; pass < 2; ++pass) {
+            auto glyph_run = Gfx::shape_text({ 0, 0 }, 0, Utf8View { text }, *font, Gfx::GlyphRun::TextType::Ltr, {});
+            EXPECT_APPROXIMATE(glyph_run->width(), expected.advance.x());
+            EXPECT_EQ(glyph_run->glyphs().size(), expected.glyphs.size());
+            if (glyph_run->glyphs().size() != expected.glyphs.size())
+                return;
+            for (size_t i = 0; i < expected.glyphs.size(); ++i) {
+                EXPECT_EQ(glyph_run->glyphs()[i].glyph_id, expected.glyphs[i].glyph_id);
+                EXPECT_APPROXIMATE(glyph_run->glyphs()[i].position.x(), expected.glyphs[i].position.x());
+                EXPECT_APPROXIMATE(glyph_run->glyphs()[i].position.y(), expected.glyphs[i].position.y());
+            }
+            EXPECT_APPROXIMATE(Gfx::measure_text_width(Utf8View { text }, *font, {}), expected.advance.x());
+        }
+    };
+
+    // Make sure the font really does kern and form ligatures here.
+    EXPECT(shape_all_at_once("AV"sv, *font).advance.x() < shape_all_at_once("A"sv, *font).advance.x() + shape_all_at_once("V"sv, *font).advance.x());
+    EXPECT_EQ(shape_all_at_once("fi"sv, *font).glyphs.size(), 1u);
+
+    check("AVA"sv);
+    check("AV AV"sv);
+    check("To find the official flow,  Wave to Yo."sv);
+    check("  leading and trailing spaces  "sv);
+    check("fi fl fi"sv);
+    EXPECT(cache.hit_count() > 0);
+}
+
+TEST_CASE(shaping_the_same_text_again_uses_the_cache)
+{
+    auto font = load_test_font(12);
+    auto& cache = Gfx::ShapedTextCache::the();
+    cache.clear();
+
+    auto text = Utf8View { "To fit  fit"sv };
+    auto first_run = Gfx::shape_text({ 0, 0 }, 1, text, *font, Gfx::GlyphRun::TextType::Ltr, {});
+    auto miss_count = cache.miss_count();
+    auto hit_count = cache.hit_count();
+    EXPECT(miss_count > 0);
+
+    // Glyphs from the cache are moved to where the text starts.
+    auto second_run = Gfx::shape_text({ 10, 20 }, 1, text, *font, Gfx::GlyphRun::TextType::Ltr, {});
+    EXPECT_EQ(cache.miss_count(), miss_count);
+    EXPECT(cache.hit_count() > hit_count);
+
+    EXPECT_APPROXIMATE(first_run->width(), second_run->width());
+    EXPECT_EQ(first_run->glyphs().size(), second_run->glyphs().size());
+    for (size_t i = 0; i < first_run->glyphs().size(); ++i) {
+        EXPECT_EQ(first_run->glyphs()[i].glyph_id, second_run->glyphs()[i].glyph_id);
+        EXPECT_APPROXIMATE(second_run->glyphs()[i].position.x(), first_run->glyphs()[i].position.x() + 10);
+        EXPECT_APPROXIMATE(second_run->glyphs()[i].position.y(), first_run->glyphs()[i].position.y() + 20);
+    }
+
+    // Measuring text shares the cache too, but without letter spacing the text has to be shaped once more.
+    auto width = Gfx::measure_text_width(text, *font, {});
+    auto misses_after_measuring = cache.miss_count();
+    EXPECT(misses_after_measuring > miss_count);
+    EXPECT_EQ(Gfx::measure_text_width(text, *font, {}), width);
+    EXPECT_EQ(cache.miss_count(), misses_after_measuring);
+}
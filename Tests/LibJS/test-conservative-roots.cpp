@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "test-gc-common.h"
+#include <AK/Array.h>
+#include <AK/StdLibExtras.h>
+#include <LibGC/ConservativeVector.h>
+#include <LibGC/Heap.h>
+#include <LibGC/HeapBlock.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+
+// Enough cells to take up a good number of blocks, so that possible pointers have more than one block to be looked up
+// in.
+static constexpr size_t cell_count = 10'000;
+
+// Possible pointers point into the middle of cells rather than at their start, as interior pointers have to keep cells
+// alive too.
+template<typename Container>
+static NEVER_INLINE void allocate_cells_referred_to_by(GC::Heap& heap, Container& possible_pointers)
+{
+    for (size_t i = 0; i < cell_count; ++i) {
+        auto cell = heap.allocate<TestCell>();
+        possible_pointers[i] = bit_cast<FlatPtr>(cell.ptr()) + sizeof(TestCell) / 2;
+    }
+}
+
+TEST_CASE(possible_pointers_keep_the_cells_they_point_into_alive)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+
+    GC::ConservativeVector<FlatPtr> possible_pointers(heap);
+    possible_pointers.resize(cell_count);
+    allocate_cells_referred_to_by(heap, possible_pointers);
+
+    // Values that are into the heap, but not into any cell, must be told apart from the others.
+    for (size_t i = 0; i < cell_count; i += 100) {
+        auto* block = GC::HeapBlock::from_cell(bit_cast<GC::Cell*>(possible_pointers[i]));
+        possible_pointers.append(bit_cast<FlatPtr>(block));
+        possible_pointers.append(bit_cast<FlatPtr>(block) + GC::HeapBlock::block_size - 1);
+    }
+    possible_pointers.append(0);
+    possible_pointers.append(NumericLimits<FlatPtr>::max());
+
+    s_destroyed_test_cells = 0;
+    heap.collect_garbage();
+    sweep_everything(heap);
+    EXPECT_EQ(s_destroyed_test_cells, 0u);
+
+    possible_pointers.clear();
+    heap.collect_garbage();
+    sweep_everything(heap);
+
+    // NOTE: A few of the cells may still be referred to from the stack.
+    EXPECT(s_destroyed_test_cells > cell_count / 2);
+}
+
+TEST_CASE(precisely_rooted_stack_ranges_are_not_scanned)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+
+    Array<FlatPtr, cell_count> possible_pointers {};
+    allocate_cells_referred_to_by(heap, possible_pointers);
+
+    s_destroyed_test_cells = 0;
+    heap.collect_garbage();
+    sweep_everything(heap);
+    EXPECT_EQ(s_destroyed_test_cells, 0u);
+
+    // Nothing actually roots the cells in the range precisely, so once it's no longer scanned, they die.
+    heap.set_gather_precisely_rooted_stack_ranges([&](Vector<GC::Heap::StackRange>& ranges) {
+        ranges.append({ bit_cast<FlatPtr>(possible_pointers.data()), bit_cast<FlatPtr>(possible_pointers.data() + possible_pointers.size()) });
+    });
+    heap.collect_garbage();
+    sweep_everything(heap);
+    EXPECT(s_destroyed_test_cells > cell_count / 2);
+
+    AK::taint_for_optimizer(possible_pointers);
+}
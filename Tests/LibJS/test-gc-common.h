@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
+#include <LibJS/Runtime/Value.h>
+
+inline size_t s_destroyed_test_cells = 0;
+
+class TestCell final : public GC::Cell {
+    GC_CELL(TestCell, GC::Cell);
+
+public:
+    virtual ~TestCell() override { ++s_destroyed_test_cells; }
+
+    GC::Ptr<TestCell> next;
+    JS::Value value;
+
+private:
+    TestCell() = default;
+
+    virtual void visit_edges(Visitor& visitor) override
+    {
+        Base::visit_edges(visitor);
+        visitor.visit(next);
+        visitor.visit(value);
+    }
+};
+
+inline void sweep_everything(GC::Heap& heap)
+{
+    while (heap.perform_lazy_sweeping_step(AK::Duration::from_milliseconds(1))) { }
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "test-gc-common.h"
+#include <LibGC/Heap.h>
+#include <LibGC/HeapBlock.h>
+#include <LibGC/Nursery.h>
+#include <LibGC/Root.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibTest/TestCase.h>
+
+static NEVER_INLINE void allocate_garbage(GC::Heap& heap, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+        heap.allocate<TestCell>();
+}
+
+static void prepend_cells(GC::Heap& heap, TestCell& list, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        auto cell = heap.allocate<TestCell>();
+        cell->next = list.next;
+        list.next = cell;
+    }
+}
+
+TEST_CASE(young_generation_collection_collects_garbage)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+    heap.collect_garbage();
+    sweep_everything(heap);
+
+    s_destroyed_test_cells = 0;
+    allocate_garbage(heap, 1000);
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    sweep_everything(heap);
+    EXPECT(s_destroyed_test_cells > 0);
+}
+
+TEST_CASE(young_generation_collection_keeps_cells_referred_to_by_old_cells)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+
+    auto old_cell = GC::make_root(heap.allocate<TestCell>());
+    heap.collect_garbage();
+
+    // One of the young cells is stored into the old one through a GC::Ptr, and the other through a JS value.
+    old_cell->next = heap.allocate<TestCell>();
+    old_cell->value = JS::PrimitiveString::create(*vm, "a string that isn't cached by the VM"_string);
+    allocate_garbage(heap, 1000);
+
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    sweep_everything(heap);
+
+    EXPECT(old_cell->next->state() == GC::Cell::State::Live);
+    EXPECT(old_cell->value.as_string().state() == GC::Cell::State::Live);
+    EXPECT_EQ(old_cell->value.as_string().utf8_string(), "a string that isn't cached by the VM"sv);
+}
+
+TEST_CASE(young_generation_collection_keeps_working_with_a_large_old_generation)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+
+    // Promoted cells stay in the nursery, and these take up more blocks than the young generation is allowed to.
+    auto list = GC::make_root(heap.allocate<TestCell>());
+    prepend_cells(heap, *list, 2 * GC::Nursery::young_block_limit * GC::HeapBlock::block_size / sizeof(TestCell));
+    heap.collect_garbage();
+    sweep_everything(heap);
+
+    s_destroyed_test_cells = 0;
+    allocate_garbage(heap, 1000);
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    sweep_everything(heap);
+    EXPECT(s_destroyed_test_cells > 0);
+}
+
+TEST_CASE(promoted_cells_are_collected_by_full_collections)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+
+    auto root = GC::make_root(heap.allocate<TestCell>());
+    root->next = heap.allocate<TestCell>();
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+
+    s_destroyed_test_cells = 0;
+    root->next = nullptr;
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    sweep_everything(heap);
+    EXPECT_EQ(s_destroyed_test_cells, 0u);
+
+    heap.collect_garbage();
+    sweep_everything(heap);
+    EXPECT(s_destroyed_test_cells > 0);
+}
+
+TEST_CASE(nursery_is_released_once_generational_collection_is_disabled)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+    allocate_garbage(heap, 1000);
+
+    // The cells in the nursery are old now, but they still need somewhere to live until they are collected.
+    heap.set_generational_collection_enabled(false);
+    EXPECT(heap.nursery() != nullptr);
+
+    heap.collect_garbage();
+    sweep_everything(heap);
+    EXPECT(heap.nursery() == nullptr);
+
+    heap.set_generational_collection_enabled(true);
+    s_destroyed_test_cells = 0;
+    allocate_garbage(heap, 1000);
+    heap.collect_garbage(GC::Heap::CollectionType::CollectYoungGeneration);
+    sweep_everything(heap);
+    EXPECT(s_destroyed_test_cells > 0);
+}
+
+// Both benchmarks allocate short-lived cells next to a long-lived linked list, and collect after every batch. The only
+// difference is whether the collections are of the young generation, or of the whole heap.
+static constexpr size_t old_cell_count = 100'000;
+static constexpr size_t young_cells_per_collection = 10'000;
+static constexpr size_t collection_count = 100;
+
+static void run_collection_benchmark(GC::Heap::CollectionType collection_type)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_generational_collection_enabled(true);
+
+    auto list = GC::make_root(heap.allocate<TestCell>());
+    prepend_cells(heap, *list, old_cell_count);
+    heap.collect_garbage();
+
+    for (size_t i = 0; i < collection_count; ++i) {
+        allocate_garbage(heap, young_cells_per_collection);
+        heap.collect_garbage(collection_type);
+        sweep_everything(heap);
+    }
+}
+
+BENCHMARK_CASE(young_generation_collection_throughput)
+{
+    run_collection_benchmark(GC::Heap::CollectionType::CollectYoungGeneration);
+}
+
+BENCHMARK_CASE(full_collection_throughput)
+{
+    run_collection_benchmark(GC::Heap::CollectionType::CollectGarbage);
+}
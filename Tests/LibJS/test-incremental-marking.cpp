@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "test-gc-common.h"
+#include <LibGC/Heap.h>
+#include <LibGC/Root.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+
+static void allocate_until_incremental_marking_starts(GC::Heap& heap)
+{
+    for (size_t i = 0; i < 1'000'000 && !heap.is_incremental_marking_in_progress(); ++i)
+        heap.allocate<TestCell>();
+    VERIFY(heap.is_incremental_marking_in_progress());
+}
+
+static void finish_incremental_marking(GC::Heap& heap)
+{
+    while (heap.perform_incremental_marking_step(AK::Duration::from_milliseconds(1))) { }
+}
+
+TEST_CASE(incremental_marking_collects_garbage)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_incremental_marking_enabled(true);
+    heap.collect_garbage();
+
+    s_destroyed_test_cells = 0;
+    allocate_until_incremental_marking_starts(heap);
+    finish_incremental_marking(heap);
+    EXPECT(!heap.is_incremental_marking_in_progress());
+
+    // Dead cells are only destroyed once their blocks are swept.
+    sweep_everything(heap);
+    EXPECT(s_destroyed_test_cells > 0);
+}
+
+// Long enough that a single marking slice never gets from one end to the other.
+static constexpr size_t chain_length = 10'000;
+
+// NOTE: The helpers below never hand out the cells of the chain, so that none of them are left on the stack, where they
+//       would be found as roots. The cells must only be reachable through the heap edges the tests move around.
+static NEVER_INLINE void append_chain(JS::VM& vm, TestCell& head)
+{
+    auto* cell = &head;
+    for (size_t i = 0; i < chain_length; ++i) {
+        cell->next = vm.heap().allocate<TestCell>();
+        cell = cell->next.ptr();
+    }
+    cell->value = JS::PrimitiveString::create(vm, "a string that isn't cached by the VM"_string);
+}
+
+enum class MoveThrough {
+    Ptr,
+    Value,
+};
+
+// Detaches the last cell of the chain, or the string it holds, and stores it in the head instead. Returns whether the
+// marker had reached it yet.
+static NEVER_INLINE bool move_end_of_chain_to_head(TestCell& head, MoveThrough move_through)
+{
+    auto* cell = head.next.ptr();
+    while (cell->next->next)
+        cell = cell->next.ptr();
+
+    auto* end = cell->next.ptr();
+    if (move_through == MoveThrough::Ptr) {
+        bool was_marked = end->is_marked();
+        cell->next = nullptr;
+        head.next = end;
+        return was_marked;
+    }
+
+    bool was_marked = end->value.as_cell().is_marked();
+    head.value = end->value;
+    end->value = JS::js_undefined();
+    return was_marked;
+}
+
+static void test_cell_moved_between_slices_is_kept_alive(MoveThrough move_through)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+
+    auto root = GC::make_root(heap.allocate<TestCell>());
+    append_chain(*vm, *root);
+
+    heap.set_incremental_marking_enabled(true);
+    allocate_until_incremental_marking_starts(heap);
+
+    // Once the first cell of the chain has been marked, the root has been visited, and won't be visited again.
+    while (heap.is_incremental_marking_in_progress() && !root->next->is_marked())
+        heap.perform_incremental_marking_step(AK::Duration::zero());
+    EXPECT(heap.is_incremental_marking_in_progress());
+
+    // What we move is now only reachable through the root, which the marker is done with.
+    EXPECT(!move_end_of_chain_to_head(*root, move_through));
+
+    finish_incremental_marking(heap);
+    EXPECT(!heap.is_incremental_marking_in_progress());
+
+    if (move_through == MoveThrough::Ptr) {
+        EXPECT(root->next->state() == GC::Cell::State::Live);
+    } else {
+        EXPECT(root->value.as_string().state() == GC::Cell::State::Live);
+        EXPECT_EQ(root->value.as_string().utf8_string(), "a string that isn't cached by the VM"sv);
+    }
+}
+
+TEST_CASE(incremental_marking_keeps_cells_stored_through_ptr_between_slices_alive)
+{
+    test_cell_moved_between_slices_is_kept_alive(MoveThrough::Ptr);
+}
+
+TEST_CASE(incremental_marking_keeps_cells_stored_through_value_between_slices_alive)
+{
+    test_cell_moved_between_slices_is_kept_alive(MoveThrough::Value);
+}
+
+// Both benchmarks keep a long-lived linked list around, which the finishing pause visits once more. One of them also
+// copies values back and forth while marking, which should cost no more than it does with marking turned off.
+static constexpr size_t live_cell_count = 100'000;
+static constexpr size_t collection_count = 20;
+
+static void run_incremental_collection_benchmark(Function<void()> mutate)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+    heap.set_incremental_marking_enabled(true);
+
+    auto list = GC::make_root(heap.allocate<TestCell>());
+    for (size_t i = 0; i < live_cell_count; ++i) {
+        auto cell = heap.allocate<TestCell>();
+        cell->next = list->next;
+        list->next = cell;
+    }
+
+    for (size_t i = 0; i < collection_count; ++i) {
+        allocate_until_incremental_marking_starts(heap);
+        while (heap.perform_incremental_marking_step(AK::Duration::from_milliseconds(1)))
+            mutate();
+        sweep_everything(heap);
+    }
+}
+
+BENCHMARK_CASE(incremental_collection_throughput)
+{
+    run_incremental_collection_benchmark([] { });
+}
+
+BENCHMARK_CASE(copying_values_while_marking)
+{
+    Vector<JS::Value> values;
+    values.resize(100'000);
+    Vector<JS::Value> copy;
+    run_incremental_collection_benchmark([&] {
+        for (size_t i = 0; i < 10; ++i)
+            copy = values;
+    });
+}
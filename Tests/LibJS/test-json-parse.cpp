@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonValue.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Runtime/AbstractOperations.h>
+#include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+
+// A few megabytes of the kind of payload an API would send: an array of records with the same keys.
+static String const& large_json_document()
+{
+    static String document = [] {
+        StringBuilder builder;
+        builder.append('[');
+        for (size_t i = 0; i < 20'000; ++i) {
+            if (i > 0)
+                builder.append(',');
+            builder.appendff(R"({{"id":{},"name":"Item number {}","price":{}.{},"in_stock":{},"tags":["tag{}","tag{}"],)", i, i, i % 1000, i % 100, i % 2 == 0 ? "true"sv : "false"sv, i % 7, i % 13);
+            builder.appendff(R"("description":"A \"quoted\" description of item {} that goes on for a while\n","owner":{{"id":{},"email":"user{}@example.com"}}}})", i, i % 500, i % 500);
+        }
+        builder.append(']');
+        return builder.to_string_without_validation();
+    }();
+    return document;
+}
+
+TEST_CASE(parse_large_document)
+{
+    auto vm = JS::VM::create();
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    auto result = MUST(JS::JSONObject::parse_json(*vm, large_json_document()));
+    auto& array = as<JS::Array>(result.as_object());
+    EXPECT_EQ(MUST(JS::length_of_array_like(*vm, array)), 20'000u);
+
+    auto record = MUST(array.get(12'345));
+    EXPECT_EQ(record.as_object().shape().property_count(), 7u);
+}
+
+BENCHMARK_CASE(parse_large_document_directly)
+{
+    auto vm = JS::VM::create();
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    for (size_t i = 0; i < 10; ++i)
+        (void)MUST(JS::JSONObject::parse_json(*vm, large_json_document()));
+}
+
+BENCHMARK_CASE(parse_large_document_through_json_value)
+{
+    auto vm = JS::VM::create();
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto json = MUST(JsonValue::from_string(large_json_document()));
+        (void)JS::JSONObject::parse_json_value(*vm, json);
+    }
+}
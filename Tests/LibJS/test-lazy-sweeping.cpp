@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "test-gc-common.h"
+#include <AK/WeakPtr.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/Intrinsics.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibJS/Runtime/Shape.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+
+// NOTE: This doesn't do anything to revoke weak pointers to itself, the collector has to take care of that.
+class WeakableTestCell final
+    : public GC::Cell
+    , public Weakable<WeakableTestCell> {
+    GC_CELL(WeakableTestCell, GC::Cell);
+
+private:
+    WeakableTestCell() = default;
+};
+
+static NEVER_INLINE WeakPtr<WeakableTestCell> make_unreachable_weakable_cell(GC::Heap& heap)
+{
+    return heap.allocate<WeakableTestCell>()->make_weak_ptr<WeakableTestCell>();
+}
+
+static NEVER_INLINE WeakPtr<JS::Object> make_unreachable_object(JS::Realm& realm)
+{
+    return JS::Object::create(realm, realm.intrinsics().object_prototype())->make_weak_ptr<JS::Object>();
+}
+
+static NEVER_INLINE GC::Ref<JS::Object> make_object_with_property(JS::Realm& realm)
+{
+    auto object = JS::Object::create(realm, realm.intrinsics().object_prototype());
+    object->define_direct_property("a property that no other object has"_fly_string, JS::Value(1), JS::default_attributes);
+    return object;
+}
+
+static NEVER_INLINE void make_unreachable_object_with_property(JS::Realm& realm)
+{
+    (void)make_object_with_property(realm);
+}
+
+TEST_CASE(weak_pointers_to_dead_cells_are_revoked_before_sweeping)
+{
+    auto vm = JS::VM::create();
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& heap = vm->heap();
+
+    auto weak_object = make_unreachable_object(*vm->current_realm());
+    EXPECT(weak_object);
+
+    heap.collect_garbage();
+    EXPECT(!weak_object);
+    sweep_everything(heap);
+}
+
+TEST_CASE(weak_pointers_to_any_weakable_cell_are_revoked_before_sweeping)
+{
+    auto vm = JS::VM::create();
+    auto& heap = vm->heap();
+
+    auto weak_cell = make_unreachable_weakable_cell(heap);
+    EXPECT(weak_cell);
+
+    heap.collect_garbage();
+    EXPECT(!weak_cell);
+    sweep_everything(heap);
+}
+
+TEST_CASE(cached_shape_transitions_to_dead_shapes_are_pruned_before_sweeping)
+{
+    auto vm = JS::VM::create();
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *vm->current_realm();
+    auto& heap = vm->heap();
+
+    // The only object with the transitioned shape dies, but its shape stays cached on the shape it came from.
+    make_unreachable_object_with_property(realm);
+    heap.collect_garbage();
+
+    // The dead shape hasn't been swept yet, and must not be handed out by the transition cache.
+    auto object = make_object_with_property(realm);
+    EXPECT(object->shape().state() == GC::Cell::State::Live);
+    sweep_everything(heap);
+    EXPECT(object->shape().state() == GC::Cell::State::Live);
+}
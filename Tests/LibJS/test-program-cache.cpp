@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Lexer.h>
+#include <LibJS/Parser.h>
+#include <LibJS/ProgramCache.h>
+#include <LibTest/TestCase.h>
+
+static NonnullRefPtr<JS::Program> parse(StringView source_text, StringView filename)
+{
+    auto parser = JS::Parser(JS::Lexer(source_text, filename));
+    auto program = parser.parse_program();
+    VERIFY(!parser.has_errors());
+    return program;
+}
+
+TEST_CASE(program_is_reused_for_the_same_source)
+{
+    JS::ProgramCache cache(1 * MiB);
+    auto source_text = "var a = 1;"sv;
+    auto program = parse(source_text, "a.js"sv);
+    cache.set("a.js"sv, source_text, JS::Program::Type::Script, 0, program);
+
+    EXPECT_EQ(cache.get("a.js"sv, source_text, JS::Program::Type::Script, 0).ptr(), program.ptr());
+    EXPECT(!cache.get("b.js"sv, source_text, JS::Program::Type::Script, 0));
+    EXPECT(!cache.get("a.js"sv, "var a = 2;"sv, JS::Program::Type::Script, 0));
+    EXPECT(!cache.get("a.js"sv, source_text, JS::Program::Type::Module, 0));
+    EXPECT(!cache.get("a.js"sv, source_text, JS::Program::Type::Script, 1));
+}
+
+TEST_CASE(program_size_is_that_of_its_source)
+{
+    auto source_text = "var a = 1;"sv;
+    JS::ProgramCache cache(source_text.length());
+    cache.set("a.js"sv, source_text, JS::Program::Type::Script, 0, parse(source_text, "a.js"sv));
+    EXPECT_EQ(cache.size_in_bytes(), source_text.length());
+
+    // The same source from another file is another program, and there is only room for one of them.
+    cache.set("b.js"sv, source_text, JS::Program::Type::Script, 0, parse(source_text, "b.js"sv));
+    EXPECT_EQ(cache.size_in_bytes(), source_text.length());
+    EXPECT(!cache.get("a.js"sv, source_text, JS::Program::Type::Script, 0));
+    EXPECT(cache.get("b.js"sv, source_text, JS::Program::Type::Script, 0));
+}
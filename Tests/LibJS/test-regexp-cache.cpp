@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/RegExpCache.h>
+#include <LibJS/Runtime/RegExpObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibTest/TestCase.h>
+
+static constexpr auto flags = JS::RegExpObject::default_flags;
+
+TEST_CASE(regex_is_reused_for_the_same_pattern_and_flags)
+{
+    JS::RegExpCache cache(1 * MiB);
+    auto pattern = "a+b"_string;
+    EXPECT(!cache.get(pattern, flags).has_value());
+    cache.set(pattern, flags, Regex<ECMA262>(pattern.to_byte_string(), flags));
+
+    auto regex = cache.get(pattern, flags);
+    EXPECT(regex.has_value());
+    EXPECT_EQ(regex->pattern_value, "a+b"sv);
+    EXPECT(regex->has_match("xaab"sv));
+    EXPECT(!regex->has_match("xb"sv));
+
+    EXPECT(!cache.get("a+c"_string, flags).has_value());
+    EXPECT(!cache.get(pattern, flags | regex::ECMAScriptFlags::Insensitive).has_value());
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 3u);
+}
+
+TEST_CASE(regex_size_is_that_of_its_pattern_and_bytecode)
+{
+    auto pattern = "(a|b)+c"_string;
+    Regex<ECMA262> regex(pattern.to_byte_string(), flags);
+    auto size_in_bytes = pattern.bytes().size() + regex.parser_result.bytecode.size() * sizeof(regex::ByteCodeValueType);
+
+    JS::RegExpCache cache(size_in_bytes);
+    cache.set(pattern, flags, regex);
+    EXPECT_EQ(cache.size_in_bytes(), size_in_bytes);
+
+    // Caching the same pattern again replaces its entry.
+    cache.set(pattern, flags, regex);
+    EXPECT_EQ(cache.size_in_bytes(), size_in_bytes);
+    EXPECT(cache.get(pattern, flags).has_value());
+}
+
+TEST_CASE(regexp_objects_share_compiled_patterns)
+{
+    auto vm = JS::VM::create();
+    auto execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& cache = vm->regexp_cache();
+
+    auto pattern = JS::PrimitiveString::create(*vm, "(\\d+)-(\\d+)"_string);
+    auto global = JS::PrimitiveString::create(*vm, "g"_string);
+
+    MUST(JS::regexp_create(*vm, pattern, global));
+    EXPECT_EQ(cache.hit_count(), 0u);
+    EXPECT_EQ(cache.miss_count(), 1u);
+
+    auto second = MUST(JS::regexp_create(*vm, pattern, global));
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 1u);
+
+    auto result = second->regex().match("12-34"sv);
+    EXPECT(result.success);
+    EXPECT_EQ(result.n_capture_groups, 2u);
+
+    // A different set of flags is compiled separately.
+    MUST(JS::regexp_create(*vm, pattern, JS::js_undefined()));
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 2u);
+
+    // Patterns that don't compile aren't cached, and keep throwing.
+    auto invalid_pattern = JS::PrimitiveString::create(*vm, "(a"_string);
+    EXPECT(JS::regexp_create(*vm, invalid_pattern, global).is_error());
+    EXPECT(JS::regexp_create(*vm, invalid_pattern, global).is_error());
+    EXPECT_EQ(cache.miss_count(), 4u);
+}
@@ -1298,3 +1298,112 @@ TEST_CASE(optimizer_repeat_offset)
         Regex<ECMA262> re("\\/?\\??#?([\\/?#]|[\\uD800-\\uDBFF]|%[c-f][0-9a-f](%[89ab][0-9a-f]){0,2}(%[89ab]?)?|%[0-9a-f]?)$"sv);
     }
 }
+
+TEST_CASE(lazy_dfa_rules_out_matches_without_backtracking)
+{
+    auto input = MUST(String::formatted("{}!", g_lots_of_a_s.bytes_as_string_view().substring_view(0, 100)));
+    Array patterns {
+        "(a+)+b"sv,
+        "^(a|a?)+$"sv,
+        "(a|aa)*c"sv,
+        "(?:a*)*b"sv,
+        "\\b(a+)+\\b!a"sv,
+    };
+    for (auto& pattern : patterns) {
+        Regex<ECMA262> re(pattern);
+        auto result = re.search(input);
+        EXPECT_EQ(result.success, false);
+        EXPECT_EQ(result.n_operations, 0u);
+    }
+}
+
+TEST_CASE(lazy_dfa_agrees_with_backtracking)
+{
+    struct {
+        StringView pattern;
+        StringView subject;
+        bool matches;
+    } tests[] = {
+        { "\\bfoo\\b"sv, "a foo b"sv, true },
+        { "\\bfoo\\b"sv, "afoob"sv, false },
+        { "\\Bfoo"sv, "afoo"sv, true },
+        { "\\Bfoo"sv, "foo"sv, false },
+        { "^abc$"sv, "abc"sv, true },
+        { "^abc$"sv, "abcd"sv, false },
+        { "abc$"sv, "xabc"sv, true },
+        { "a{2,3}b"sv, "xaab"sv, true },
+        { "a{2,3}b"sv, "xab"sv, false },
+        { "^a{2}$"sv, "aaa"sv, false },
+        { "(?:ab)+c"sv, "ababc"sv, true },
+        { "(?:ab)+c"sv, "abac"sv, false },
+        { "x*"sv, ""sv, true },
+        { "(a*)*$"sv, "b"sv, true },
+        { "[^a]b"sv, "ab"sv, false },
+        { "[^a]b"sv, "cb"sv, true },
+        { "a.c"sv, "a\nc"sv, false },
+        { "a.c"sv, "abc"sv, true },
+        { "[a-c]+d"sv, "xxbcad"sv, true },
+        { "(foo|bar)baz"sv, "foobar"sv, false },
+        { "(foo|bar)baz"sv, "barbaz"sv, true },
+        { "(a)\\1"sv, "aa"sv, true },
+        { "a(?=b)"sv, "ab"sv, true },
+        { "(a+)+b"sv, "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa!ab"sv, true },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern);
+        auto result = re.search(test.subject);
+        EXPECT_EQ(result.success, test.matches);
+    }
+
+    Regex<ECMA262> sticky("ab", ECMAScriptFlags::Sticky);
+    EXPECT_EQ(sticky.match("ab"sv).success, true);
+    EXPECT_EQ(sticky.match("xab"sv).success, false);
+}
+
+TEST_CASE(search_skips_to_possible_match_starts)
+{
+    // The matches are placed on both sides of the boundaries of the blocks of code units that are looked at at once.
+    auto padding = g_lots_of_a_s.bytes_as_string_view().substring_view(0, 37);
+    auto subject = MUST(String::formatted("{}foo{}{}Foo{}xfOoébar", padding, padding, padding, padding));
+    auto utf16_subject = MUST(AK::utf8_to_utf16(subject));
+
+    struct {
+        StringView pattern;
+        ECMAScriptFlags options;
+        Vector<size_t> offsets;
+    } tests[] = {
+        { "foo"sv, ECMAScriptFlags::Global, { 37 } },
+        { "foo"sv, combine_flags(ECMAScriptFlags::Global, ECMAScriptFlags::Insensitive), { 37, 114, 155 } },
+        { "[fF]o"sv, ECMAScriptFlags::Global, { 37, 114 } },
+        { "f[oO]"sv, ECMAScriptFlags::Global, { 37, 155 } },
+        { "xfOo"sv, ECMAScriptFlags::Global, { 154 } },
+        { "bar"sv, ECMAScriptFlags::Global, { 160 } },
+        { "baz"sv, ECMAScriptFlags::Global, {} },
+    };
+
+    for (auto& test : tests) {
+        Regex<ECMA262> re(test.pattern, test.options);
+        auto result = re.match(subject);
+        EXPECT_EQ(result.matches.size(), test.offsets.size());
+        for (size_t i = 0; i < min(result.matches.size(), test.offsets.size()); ++i)
+            EXPECT_EQ(result.matches[i].global_offset, test.offsets[i]);
+
+        // In the UTF-16 view, the é before "bar" takes up one code unit rather than two bytes.
+        Regex<ECMA262> utf16_re(test.pattern, test.options);
+        auto utf16_result = utf16_re.match(Utf16View { utf16_subject });
+        EXPECT_EQ(utf16_result.matches.size(), test.offsets.size());
+        for (size_t i = 0; i < min(utf16_result.matches.size(), test.offsets.size()); ++i)
+            EXPECT_EQ(utf16_result.matches[i].global_offset, test.offsets[i] > 156 ? test.offsets[i] - 1 : test.offsets[i]);
+    }
+}
+
+BENCHMARK_CASE(rare_match_search_performance)
+{
+    auto subject = MUST(String::formatted("{}needle{}", g_lots_of_a_s, g_lots_of_a_s));
+    for (auto pattern : { "needle"sv, "[mn]eedle"sv }) {
+        Regex<ECMA262> re(pattern, ECMAScriptFlags::Global);
+        auto result = re.match(subject);
+        EXPECT_EQ(result.matches.size(), 1u);
+    }
+}
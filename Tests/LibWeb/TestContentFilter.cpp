@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <LibURL/Parser.h>
+#include <LibWeb/Loader/ContentFilter.h>
+
+static bool is_filtered(StringView url)
+{
+    auto parsed_url = URL::Parser::basic_parse(url);
+    VERIFY(parsed_url.has_value());
+    return Web::ContentFilter::the().is_filtered(*parsed_url);
+}
+
+static void set_patterns(Vector<String> const& patterns)
+{
+    MUST(Web::ContentFilter::the().set_patterns(patterns));
+}
+
+TEST_CASE(no_patterns)
+{
+    set_patterns({});
+    EXPECT(!is_filtered("https://example.com/ads.js"sv));
+}
+
+TEST_CASE(single_pattern)
+{
+    set_patterns({ "/ads."_string });
+    EXPECT(is_filtered("https://example.com/ads.js"sv));
+    EXPECT(is_filtered("https://example.com/static/ads.min.js"sv));
+    EXPECT(!is_filtered("https://example.com/ad.js"sv));
+    EXPECT(!is_filtered("https://example.com/ads"sv));
+}
+
+TEST_CASE(overlapping_patterns)
+{
+    // "tracker" is only found after falling back from the partial match of "trackpad".
+    set_patterns({ "trackpad"_string, "tracker"_string, "ackpx"_string, "a/b"_string });
+    EXPECT(is_filtered("https://example.com/trackpad.png"sv));
+    EXPECT(is_filtered("https://example.com/trackptracker.js"sv));
+    EXPECT(is_filtered("https://example.com/trackpx.gif"sv));
+    EXPECT(is_filtered("https://example.com/a/b"sv));
+    EXPECT(!is_filtered("https://example.com/trackpa"sv));
+    EXPECT(!is_filtered("https://example.com/ackp"sv));
+}
+
+TEST_CASE(pattern_suffix_of_another)
+{
+    // "bc" ends inside "abcd"; it must be reported even though "abcd" itself never completes.
+    set_patterns({ "abcd"_string, "bc"_string });
+    EXPECT(is_filtered("https://example.com/abce"sv));
+    EXPECT(!is_filtered("https://example.com/acbd"sv));
+}
+
+TEST_CASE(data_urls_are_never_filtered)
+{
+    set_patterns({ "data"_string, "text"_string });
+    EXPECT(!is_filtered("data:text/html,test"sv));
+}
+
+TEST_CASE(filtering_disabled)
+{
+    set_patterns({ "example"_string });
+    Web::ContentFilter::the().set_filtering_enabled(false);
+    EXPECT(!is_filtered("https://example.com/"sv));
+    Web::ContentFilter::the().set_filtering_enabled(true);
+    EXPECT(is_filtered("https://example.com/"sv));
+}
+
+static void benchmark_filter_list(size_t pattern_count)
+{
+    Vector<String> patterns;
+    patterns.ensure_capacity(pattern_count);
+    for (size_t i = 0; i < pattern_count; ++i)
+        patterns.unchecked_append(MUST(String::formatted("/blocked-resource-{}.js", i)));
+    set_patterns(patterns);
+
+    auto url = URL::Parser::basic_parse("https://cdn.example.com/assets/scripts/application-bundle.min.js?v=1234567890"sv);
+    VERIFY(url.has_value());
+
+    for (size_t i = 0; i < 100'000; ++i)
+        EXPECT(!Web::ContentFilter::the().is_filtered(*url));
+}
+
+BENCHMARK_CASE(filter_url_against_100_patterns)
+{
+    benchmark_filter_list(100);
+}
+
+BENCHMARK_CASE(filter_url_against_10000_patterns)
+{
+    benchmark_filter_list(10'000);
+}
+
+BENCHMARK_CASE(filter_url_against_50000_patterns)
+{
+    benchmark_filter_list(50'000);
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/CSS/Parser/Parser.h>
+#include <LibWeb/CSS/SelectorListCache.h>
+
+static Web::CSS::SelectorList parse(StringView selector_text)
+{
+    auto selectors = Web::parse_selector(Web::CSS::Parser::ParsingParams {}, selector_text);
+    VERIFY(selectors.has_value());
+    return selectors.release_value();
+}
+
+TEST_CASE(selector_list_is_reused_for_the_same_text)
+{
+    Web::CSS::SelectorListCache cache(4);
+    EXPECT(!cache.get("div > p"sv).has_value());
+
+    auto selectors = parse("div > p"sv);
+    cache.set("div > p"sv, selectors);
+
+    auto cached_selectors = cache.get("div > p"sv);
+    EXPECT(cached_selectors.has_value());
+    EXPECT_EQ(cached_selectors->size(), 1u);
+    EXPECT_EQ(cached_selectors->first().ptr(), selectors.first().ptr());
+
+    EXPECT(!cache.get("div>p"sv).has_value());
+    EXPECT(!cache.get("DIV > P"sv).has_value());
+    EXPECT_EQ(cache.hit_count(), 1u);
+    EXPECT_EQ(cache.miss_count(), 3u);
+}
+
+TEST_CASE(selector_lists_are_not_kept_without_capacity)
+{
+    Web::CSS::SelectorListCache cache(0);
+    cache.set("div"sv, parse("div"sv));
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT(!cache.get("div"sv).has_value());
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/DisplayListRecorder.h>
+#include <LibWeb/Painting/ScrollState.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
+
+namespace Web::Painting {
+
+static constexpr int tile_size = TiledRasterizer::tile_size;
+
+// Not a multiple of the tile size, so the tiles along the right and bottom edges are smaller than the others.
+static constexpr Gfx::IntSize surface_size { tile_size * 2 + 100, tile_size * 2 + 37 };
+
+// Paints shapes that straddle the tile edges, so that every tile only gets to paint part of them.
+static NonnullRefPtr<DisplayList> record_display_list_across_tile_edges()
+{
+    auto display_list = DisplayList::create();
+    display_list->set_device_pixels_per_css_pixel(1);
+
+    DisplayListRecorder recorder(*display_list);
+    recorder.fill_rect({ 0, 0, surface_size.width(), surface_size.height() }, Color::White);
+
+    // Centered on the point where four tiles meet.
+    recorder.fill_ellipse({ tile_size - 70, tile_size - 50, 140, 100 }, Color::Red);
+    recorder.draw_ellipse({ tile_size - 90, tile_size - 90, 180, 180 }, Color::Blue, 3);
+    recorder.fill_rect_with_rounded_corners({ tile_size - 31, tile_size * 2 - 17, 2 * tile_size - 40, 60 }, Color::from_argb(0x8000ff00), 25);
+
+    // Antialiased lines that cross tile edges at an angle.
+    recorder.draw_line({ 3, 5 }, { surface_size.width() - 7, surface_size.height() - 2 }, Color::Black, 5);
+    recorder.draw_line({ surface_size.width() - 1, 0 }, { 0, tile_size * 2 + 11 }, Color::Magenta, 2);
+    recorder.draw_rect({ tile_size / 2, tile_size / 2, tile_size + 1, tile_size + 1 }, Color::Cyan);
+
+    // A clip and translation that both end up partway into a tile.
+    recorder.save();
+    recorder.add_clip_rect({ tile_size - 13, 40, tile_size + 26, tile_size * 2 });
+    recorder.translate({ 7, 11 });
+    recorder.fill_ellipse({ tile_size - 60, tile_size * 2 - 60, 120, 120 }, Color::from_argb(0xc0ff8000));
+    recorder.restore();
+
+    return display_list;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> rasterize(DisplayList& display_list, TiledRasterizer* tiled_rasterizer)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, surface_size));
+    auto surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+    auto scroll_state = ScrollStateSnapshot::create({});
+
+    if (tiled_rasterizer) {
+        EXPECT(tiled_rasterizer->rasterize(display_list, scroll_state, *surface));
+    } else {
+        DisplayListPlayerSkia player;
+        player.execute(display_list, scroll_state, surface);
+    }
+    surface->flush();
+    return bitmap;
+}
+
+TEST_CASE(tiled_rasterization_matches_untiled_rasterization)
+{
+    auto display_list = record_display_list_across_tile_edges();
+    EXPECT(TiledRasterizer::can_rasterize(*display_list));
+
+    auto tiled_rasterizer = MUST(TiledRasterizer::create(4));
+    auto tiled = rasterize(*display_list, tiled_rasterizer.ptr());
+    auto untiled = rasterize(*display_list, nullptr);
+
+    size_t mismatched_pixels = 0;
+    for (int y = 0; y < surface_size.height(); ++y) {
+        for (int x = 0; x < surface_size.width(); ++x) {
+            if (tiled->get_pixel(x, y) != untiled->get_pixel(x, y))
+                ++mismatched_pixels;
+        }
+    }
+    EXPECT_EQ(mismatched_pixels, 0u);
+
+    // Make sure the shapes actually reach across the tile edges, rather than the comparison passing on a blank surface.
+    EXPECT_EQ(tiled->get_pixel(tile_size - 1, tile_size - 1), Color(Color::Red));
+    EXPECT_EQ(tiled->get_pixel(tile_size, tile_size), Color(Color::Red));
+    EXPECT_EQ(tiled->get_pixel(tile_size - 1, tile_size), Color(Color::Red));
+}
+
+TEST_CASE(tiled_rasterization_paints_over_existing_pixels)
+{
+    // Tiles start out with whatever is already in the target surface, since display lists don't have to cover it.
+    auto display_list = DisplayList::create();
+    display_list->set_device_pixels_per_css_pixel(1);
+    {
+        DisplayListRecorder recorder(*display_list);
+        recorder.fill_ellipse({ tile_size - 50, tile_size - 50, 100, 100 }, Color::from_argb(0x800000ff));
+    }
+
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, surface_size));
+    for (int y = 0; y < surface_size.height(); ++y) {
+        for (int x = 0; x < surface_size.width(); ++x)
+            bitmap->scanline(y)[x] = Color(Color::Green).value();
+    }
+    auto surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+
+    auto tiled_rasterizer = MUST(TiledRasterizer::create(2));
+    EXPECT(tiled_rasterizer->rasterize(*display_list, ScrollStateSnapshot::create({}), *surface));
+    surface->flush();
+
+    EXPECT_EQ(bitmap->get_pixel(0, 0), Color(Color::Green));
+    EXPECT_EQ(bitmap->get_pixel(surface_size.width() - 1, surface_size.height() - 1), Color(Color::Green));
+    EXPECT_NE(bitmap->get_pixel(tile_size, tile_size), Color(Color::Green));
+}
+
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/Directory.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/TempFile.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/Parser.h>
+#include <RequestServer/DiskCache.h>
+
+static ByteString const partition_key = "https://example.com"sv;
+
+static URL::URL parse_url(StringView url)
+{
+    return URL::Parser::basic_parse(url).release_value();
+}
+
+static OwnPtr<RequestServer::CacheEntryWriter> create_entry(RequestServer::DiskCache& cache, URL::URL const& url)
+{
+    HTTP::HeaderMap response_headers;
+    response_headers.set("Cache-Control"sv, "max-age=3600"sv);
+
+    auto writer = cache.create_entry(partition_key, url, {}, 200, {}, response_headers, UnixDateTime::now());
+    VERIFY(writer);
+    return writer;
+}
+
+// Returns the stored body, or nothing if the entry can't be used.
+static Optional<ByteString> read_entry(RequestServer::DiskCache& cache, URL::URL const& url)
+{
+    auto reader = cache.open_entry(partition_key, url, {});
+    if (!reader)
+        return {};
+    return ByteString { reader->body() };
+}
+
+static Vector<ByteString> files_in(StringView directory)
+{
+    Vector<ByteString> names;
+    MUST(Core::Directory::for_each_entry(directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        names.append(entry.name);
+        return IterationDecision::Continue;
+    }));
+    return names;
+}
+
+TEST_CASE(concurrent_writers_for_the_same_url_do_not_clobber_each_other)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(RequestServer::DiskCache::create(directory->path().to_byte_string()));
+    auto url = parse_url("https://example.com/script.js"sv);
+
+    auto first = create_entry(*cache, url);
+    auto second = create_entry(*cache, url);
+    MUST(first->write_data("first response"sv.bytes()));
+    MUST(second->write_data("second"sv.bytes()));
+    MUST(first->write_data(", continued"sv.bytes()));
+
+    MUST(first->commit());
+    EXPECT_EQ(read_entry(*cache, url).value_or("<missing>"sv), "first response, continued"sv);
+
+    // Dropping a writer that was still in flight must not affect the committed entry.
+    second = create_entry(*cache, url);
+    MUST(second->write_data("abandoned"sv.bytes()));
+    second = create_entry(*cache, url);
+    EXPECT_EQ(read_entry(*cache, url).value_or("<missing>"sv), "first response, continued"sv);
+
+    // The writer that commits last wins.
+    auto third = create_entry(*cache, url);
+    MUST(third->write_data("third"sv.bytes()));
+    MUST(second->write_data("second again"sv.bytes()));
+    MUST(third->commit());
+    MUST(second->commit());
+    EXPECT_EQ(read_entry(*cache, url).value_or("<missing>"sv), "second again"sv);
+
+    first = nullptr;
+    second = nullptr;
+    third = nullptr;
+    EXPECT_EQ(files_in(directory->path()), Vector { RequestServer::DiskCache::hash_for_cache_key(partition_key, url) });
+}
+
+TEST_CASE(aborted_writer_leaves_nothing_behind)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto cache = MUST(RequestServer::DiskCache::create(directory->path().to_byte_string()));
+    auto url = parse_url("https://example.com/image.png"sv);
+
+    {
+        auto writer = create_entry(*cache, url);
+        MUST(writer->write_data("partial response"sv.bytes()));
+    }
+
+    EXPECT(!read_entry(*cache, url).has_value());
+    EXPECT(files_in(directory->path()).is_empty());
+}
+
+TEST_CASE(colliding_hashes_do_not_serve_another_urls_response)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto directory_path = directory->path().to_byte_string();
+    auto url = parse_url("https://example.com/a.css"sv);
+    auto other_url = parse_url("https://example.com/b.css"sv);
+
+    {
+        auto cache = MUST(RequestServer::DiskCache::create(directory_path));
+        auto writer = create_entry(*cache, url);
+        MUST(writer->write_data("a { color: red }"sv.bytes()));
+        MUST(writer->commit());
+    }
+
+    // Pretend the two URLs hash to the same value by moving the entry to where the other URL's would be.
+    auto hash = RequestServer::DiskCache::hash_for_cache_key(partition_key, url);
+    auto other_hash = RequestServer::DiskCache::hash_for_cache_key(partition_key, other_url);
+    MUST(Core::System::rename(ByteString::formatted("{}/{}", directory_path, hash), ByteString::formatted("{}/{}", directory_path, other_hash)));
+
+    auto cache = MUST(RequestServer::DiskCache::create(directory_path));
+    EXPECT(!read_entry(*cache, other_url).has_value());
+    EXPECT(!read_entry(*cache, url).has_value());
+
+    // The fragment isn't part of the key, so it doesn't count as a different URL.
+    auto writer = create_entry(*cache, url);
+    MUST(writer->write_data("a { color: green }"sv.bytes()));
+    MUST(writer->commit());
+    EXPECT_EQ(read_entry(*cache, parse_url("https://example.com/a.css#fragment"sv)).value_or("<missing>"sv), "a { color: green }"sv);
+}
+
+TEST_CASE(only_stale_temporary_files_are_removed_at_startup)
+{
+    auto directory = MUST(FileSystem::TempFile::create_temp_directory());
+    auto directory_path = directory->path().to_byte_string();
+    auto url = parse_url("https://example.com/video.mp4"sv);
+
+    auto cache = MUST(RequestServer::DiskCache::create(directory_path));
+    auto writer = create_entry(*cache, url);
+    MUST(writer->write_data("still downloading"sv.bytes()));
+
+    // Left behind by a process that crashed a while ago.
+    auto stale_path = ByteString::formatted("{}/{}.tmp.crashed", directory_path, RequestServer::DiskCache::hash_for_cache_key(partition_key, url));
+    auto fd = MUST(Core::System::open(stale_path, O_CREAT | O_WRONLY, 0600));
+    MUST(Core::System::close(fd));
+    auto two_hours_ago = UnixDateTime::now().seconds_since_epoch() - 2 * 60 * 60;
+    struct timespec times[2] = { { two_hours_ago, 0 }, { two_hours_ago, 0 } };
+    MUST(Core::System::utimensat(AT_FDCWD, stale_path, times, 0));
+
+    // Another process starting up with the same directory must not pull the in-flight write out from under us.
+    auto other_cache = MUST(RequestServer::DiskCache::create(directory_path));
+    EXPECT(Core::System::stat(stale_path).is_error());
+
+    MUST(writer->commit());
+    EXPECT_EQ(read_entry(*cache, url).value_or("<missing>"sv), "still downloading"sv);
+}
@@ -10,6 +10,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/StackInfo.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
 #include <LibCore/MappedFile.h>
 #include <LibFileSystem/FileSystem.h>
@@ -515,6 +516,64 @@ static void print_link_error(Wasm::LinkError const& error)
         warnln("Missing import '{}'", missing);
 }
 
+// Measures raw load/store throughput of the interpreter with a module equivalent to:
+//
+// (func (export "run") (param $size i32) (param $rounds i32) (result i32)
+//   (local $p i32) (local $sum i32)
+//   (loop over $rounds
+//     (loop over $p from 0 to $size step 4
+//       (i32.store (local.get $p) (i32.add (i32.load (local.get $p)) (i32.const 1)))
+//       (local.set $sum (i32.add (local.get $sum) (i32.load8_u (local.get $p))))))
+//   (local.get $sum))
+static ErrorOr<int> run_memory_benchmark(u32 rounds)
+{
+    static constexpr Array<u8, 114> module_bytes {
+        0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x60, 0x02, 0x7f, 0x7f, 0x01,
+        0x7f, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x10, 0x07, 0x07, 0x01, 0x03, 0x72, 0x75,
+        0x6e, 0x00, 0x00, 0x0a, 0x4d, 0x01, 0x4b, 0x01, 0x02, 0x7f, 0x02, 0x40, 0x03, 0x40, 0x20, 0x01,
+        0x45, 0x0d, 0x01, 0x41, 0x00, 0x21, 0x02, 0x02, 0x40, 0x03, 0x40, 0x20, 0x02, 0x20, 0x00, 0x4f,
+        0x0d, 0x01, 0x20, 0x02, 0x20, 0x02, 0x28, 0x02, 0x00, 0x41, 0x01, 0x6a, 0x36, 0x02, 0x00, 0x20,
+        0x03, 0x20, 0x02, 0x2d, 0x00, 0x00, 0x6a, 0x21, 0x03, 0x20, 0x02, 0x41, 0x04, 0x6a, 0x21, 0x02,
+        0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x41, 0x01, 0x6b, 0x21, 0x01, 0x0c, 0x00, 0x0b, 0x0b, 0x20,
+        0x03, 0x0b,
+    };
+    // The module declares a 16-page memory.
+    static constexpr u32 memory_size = 16 * Wasm::Constants::page_size;
+
+    FixedMemoryStream stream { module_bytes.span() };
+    auto parse_result = Wasm::Module::parse(stream);
+    if (parse_result.is_error()) {
+        warnln("Failed to parse the benchmark module: {}", Wasm::parse_error_to_byte_string(parse_result.error()));
+        return 1;
+    }
+    auto module = parse_result.release_value();
+
+    Wasm::AbstractMachine machine;
+    Wasm::Linker linker { module };
+    auto instantiation_result = machine.instantiate(module, linker.finish().release_value());
+    if (instantiation_result.is_error()) {
+        warnln("Failed to instantiate the benchmark module: {}", instantiation_result.error().error);
+        return 1;
+    }
+    auto instance = instantiation_result.release_value();
+    auto address = instance->exports().first_matching([](auto& entry) { return entry.name() == "run"sv; })->value().get<Wasm::FunctionAddress>();
+
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    auto result = machine.invoke(address, { Wasm::Value(memory_size), Wasm::Value(rounds) });
+    auto elapsed = timer.elapsed_time();
+
+    if (result.is_trap()) {
+        warnln("Benchmark trapped: {}", result.trap().format());
+        return 1;
+    }
+
+    // Every iteration of the inner loop does a 4-byte load, a 4-byte store and a 1-byte load.
+    auto accessed_bytes = static_cast<double>(memory_size) * rounds * 9 / 4;
+    auto seconds = static_cast<double>(elapsed.to_microseconds()) / 1'000'000;
+    outln("{} rounds over {} KiB of memory in {} ms: {:.1} MiB/s", rounds, memory_size / KiB, elapsed.to_milliseconds(), accessed_bytes / MiB / seconds);
+    return 0;
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     StringView filename;
@@ -524,6 +583,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool export_all_imports = false;
     bool shell_mode = false;
     bool wasi = false;
+    Optional<u32> memory_benchmark_rounds;
     ByteString exported_function_to_execute;
     Vector<ParsedValue> values_to_push;
     Vector<ByteString> modules_to_link_in;
@@ -531,7 +591,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     Vector<StringView> wasi_preopened_mappings;
 
     Core::ArgsParser parser;
-    parser.add_positional_argument(filename, "File name to parse", "file");
+    parser.add_positional_argument(filename, "File name to parse", "file", Core::ArgsParser::Required::No);
     parser.add_option(debug, "Open a debugger", "debug", 'd');
     parser.add_option(print, "Print the parsed module", "print", 'p');
     parser.add_option(attempt_instantiate, "Attempt to instantiate the module", "instantiate", 'i');
@@ -539,6 +599,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_option(export_all_imports, "Export noop functions corresponding to imports", "export-noop");
     parser.add_option(shell_mode, "Launch a REPL in the module's context (implies -i)", "shell", 's');
     parser.add_option(wasi, "Enable WASI", "wasi", 'w');
+    parser.add_option(memory_benchmark_rounds, "Run a memory load/store throughput benchmark for the given number of rounds, then exit", "benchmark-memory", 0, "rounds");
     parser.add_option(Core::ArgsParser::Option {
         .argument_mode = Core::ArgsParser::OptionArgumentMode::Required,
         .help_string = "Directory mappings to expose via WASI",
@@ -586,6 +647,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     parser.add_positional_argument(args_if_wasi, "Arguments to pass to the WASI module", "args", Core::ArgsParser::Required::No);
     parser.parse(arguments);
 
+    if (memory_benchmark_rounds.has_value())
+        return run_memory_benchmark(*memory_benchmark_rounds);
+
+    if (filename.is_empty()) {
+        warnln("No file given");
+        return 1;
+    }
+
     if (shell_mode) {
         debug = true;
         attempt_instantiate = true;